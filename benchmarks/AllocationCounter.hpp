@@ -0,0 +1,18 @@
+#ifndef UNCOPENER_ALLOCATIONCOUNTER_HPP
+#define UNCOPENER_ALLOCATIONCOUNTER_HPP
+
+#include <QtGlobal>
+
+namespace uncopener::bench
+{
+
+/// Check if heap allocations can be counted on this platform
+/// Counting interposes malloc, calloc and realloc, which is only done on glibc
+[[nodiscard]] bool allocationCountingSupported();
+
+/// Number of heap allocations made by the process so far (0 if unsupported)
+[[nodiscard]] quint64 allocationCount();
+
+} // namespace uncopener::bench
+
+#endif // UNCOPENER_ALLOCATIONCOUNTER_HPP
@@ -0,0 +1,90 @@
+#include "BenchCorpus.hpp"
+
+#include "UrlParser.hpp"
+
+#include <QTest>
+
+namespace uncopener::bench
+{
+
+namespace
+{
+
+/// A deep path of the kind produced by project archives
+QString deepUrl()
+{
+    QString url = "uncopener://fileserver01.corp.example/projects";
+    for (int i = 0; i < 24; ++i)
+    {
+        url += QString("/level%1 folder").arg(i);
+    }
+    return url + "/final report.docx";
+}
+
+} // namespace
+
+QList<NamedUrl> benchUrls()
+{
+    return {
+        {"short", "uncopener://server/share/file.txt"},
+        {"deep", deepUrl()},
+        {"percent-utf8", "uncopener://fs01/Vertrieb%20Nord/B%C3%BCcher/%C3%84rger%202024/"
+                         "Angebot%20%23123.pdf"},
+        {"query-fragment", "uncopener://server/share/docs/./index.html?view=list#top"},
+        {"rejected-traversal", "uncopener://server/share/a/b/../../../etc/passwd"},
+        {"rejected-scheme", "https://server/share/file.txt"},
+        {"rejected-filetype", "uncopener://server/share/tools/setup.exe"},
+        {"rejected-allowlist", "uncopener://unknown-host/share/file.txt"},
+    };
+}
+
+QList<NamedUrl> acceptedBenchUrls()
+{
+    UrlParser parser(BENCH_SCHEME);
+    QList<NamedUrl> accepted;
+    for (const NamedUrl& url : benchUrls())
+    {
+        if (isSuccess(parser.parse(url.second)))
+        {
+            accepted.append(url);
+        }
+    }
+    return accepted;
+}
+
+void addUrlRows(const QList<NamedUrl>& urls)
+{
+    QTest::addColumn<QString>("url");
+    for (const auto& [name, url] : urls)
+    {
+        QTest::newRow(name) << url;
+    }
+}
+
+QStringList benchAllowList(int count)
+{
+    QStringList entries = {R"(\\server\share)", R"(\\fileserver01.corp.example\projects)",
+                           R"(\\fs01\Vertrieb Nord)"};
+    entries.reserve(count);
+    for (int i = 0; entries.size() < count; ++i)
+    {
+        entries.append(QString(R"(\\fs%1.corp.example\dept%2\project%3)")
+                           .arg(i / 100)
+                           .arg((i / 10) % 10)
+                           .arg(i % 10));
+    }
+    return entries.mid(0, count);
+}
+
+Config benchConfig(int allowListSize)
+{
+    Config config;
+    config.setSchemeName(BENCH_SCHEME);
+    config.setUncAllowList(benchAllowList(allowListSize));
+    config.setFiletypeMode(FiletypeMode::Blacklist);
+    config.setFiletypeBlacklist({".exe", ".bat", ".cmd", ".com", ".msi", ".ps1", ".vbs", ".js",
+                                 ".scr", ".pdf.exe", ".lnk"});
+    return config;
+}
+
+} // namespace uncopener::bench
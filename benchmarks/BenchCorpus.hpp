@@ -0,0 +1,38 @@
+#ifndef UNCOPENER_BENCHCORPUS_HPP
+#define UNCOPENER_BENCHCORPUS_HPP
+
+#include "Config.hpp"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <utility>
+
+namespace uncopener::bench
+{
+
+/// Scheme used by all benchmark URLs
+inline const QString BENCH_SCHEME = "uncopener";
+
+/// Named URL, usable as a QTest data row
+using NamedUrl = std::pair<const char*, QString>;
+
+/// Realistic URLs: plain, long and deep, percent-encoded UTF-8, and rejected inputs
+[[nodiscard]] QList<NamedUrl> benchUrls();
+
+/// The benchUrls() that parse successfully
+[[nodiscard]] QList<NamedUrl> acceptedBenchUrls();
+
+/// Add a "url" column with one row per URL
+void addUrlRows(const QList<NamedUrl>& urls);
+
+/// Allow-list entries shaped like a share inventory; the benchUrls() servers come first
+[[nodiscard]] QStringList benchAllowList(int count);
+
+/// Configuration with an allow-list of the given size and a typical extension blacklist
+[[nodiscard]] Config benchConfig(int allowListSize);
+
+} // namespace uncopener::bench
+
+#endif // UNCOPENER_BENCHCORPUS_HPP
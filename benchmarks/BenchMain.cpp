@@ -0,0 +1,84 @@
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QList>
+
+#include <cstddef>
+#include <vector>
+
+// Unified benchmark main - core only, no GUI
+// "--output-dir <dir>" additionally writes <dir>/<Suite>.csv and <dir>/<Suite>.xml per suite
+
+int runUrlParserBench(int argc, char* argv[]);
+int runUncAllowListBench(int argc, char* argv[]);
+int runFiletypePolicyBench(int argc, char* argv[]);
+int runSecurityPolicyBench(int argc, char* argv[]);
+int runPathOpenerBench(int argc, char* argv[]);
+int runDecisionFilterBench(int argc, char* argv[]);
+int runConfigBench(int argc, char* argv[]);
+
+namespace
+{
+
+const QByteArray OUTPUT_DIR_OPTION = "--output-dir";
+
+using SuiteRunner = int (*)(int argc, char* argv[]);
+
+/// Run one suite with the common arguments, adding machine-readable outputs if requested
+int runSuite(SuiteRunner run, const char* suiteName, QList<QByteArray> arguments,
+             const QString& outputDir)
+{
+    if (!outputDir.isEmpty())
+    {
+        QByteArray basePath = QFile::encodeName(QDir(outputDir).filePath(suiteName));
+        arguments << "-o" << basePath + ".csv,csv" << "-o" << basePath + ".xml,xml" << "-o"
+                  << "-,txt";
+    }
+
+    std::vector<char*> argv;
+    argv.reserve(static_cast<std::size_t>(arguments.size()) + 1);
+    for (QByteArray& argument : arguments)
+    {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+
+    return run(static_cast<int>(arguments.size()), argv.data());
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // Separate our option from the ones passed on to QTest
+    QList<QByteArray> arguments;
+    QString outputDir;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (argv[i] == OUTPUT_DIR_OPTION && i + 1 < argc)
+        {
+            outputDir = QFile::decodeName(argv[++i]);
+            continue;
+        }
+        arguments.append(argv[i]);
+    }
+
+    if (!outputDir.isEmpty() && !QDir().mkpath(outputDir))
+    {
+        qWarning("Cannot create output directory %s", qPrintable(outputDir));
+        return 1;
+    }
+
+    int status = 0;
+    status |= runSuite(runUrlParserBench, "UrlParser", arguments, outputDir);
+    status |= runSuite(runUncAllowListBench, "UncAllowList", arguments, outputDir);
+    status |= runSuite(runFiletypePolicyBench, "FiletypePolicy", arguments, outputDir);
+    status |= runSuite(runSecurityPolicyBench, "SecurityPolicy", arguments, outputDir);
+    status |= runSuite(runPathOpenerBench, "PathOpener", arguments, outputDir);
+    status |= runSuite(runDecisionFilterBench, "DecisionFilter", arguments, outputDir);
+    status |= runSuite(runConfigBench, "Config", arguments, outputDir);
+    return status;
+}
@@ -0,0 +1,81 @@
+#include "BenchCorpus.hpp"
+#include "Config.hpp"
+
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace uncopener;
+using namespace uncopener::bench;
+
+namespace
+{
+
+void addSizeRows()
+{
+    QTest::addColumn<int>("allowListSize");
+    QTest::newRow("10") << 10;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+} // namespace
+
+class ConfigBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void toJson_data() { addSizeRows(); }
+
+    void toJson()
+    {
+        QFETCH(int, allowListSize);
+        Config config = benchConfig(allowListSize);
+
+        QBENCHMARK
+        {
+            QJsonObject json = config.toJson();
+            Q_UNUSED(json);
+        }
+    }
+
+    void fromJson_data() { addSizeRows(); }
+
+    void fromJson()
+    {
+        QFETCH(int, allowListSize);
+        QJsonObject json = benchConfig(allowListSize).toJson();
+
+        QBENCHMARK
+        {
+            Config config;
+            QVERIFY(config.fromJson(json));
+        }
+    }
+
+    void loadFrom_data() { addSizeRows(); }
+
+    void loadFrom()
+    {
+        QFETCH(int, allowListSize);
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QString configPath = tempDir.path() + "/config.json";
+        QVERIFY(benchConfig(allowListSize).saveTo(configPath));
+
+        QBENCHMARK
+        {
+            Config config;
+            QVERIFY(config.loadFrom(configPath));
+        }
+    }
+};
+
+int runConfigBench(int argc, char* argv[])
+{
+    ConfigBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "ConfigBench.moc"
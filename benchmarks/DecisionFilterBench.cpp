@@ -0,0 +1,115 @@
+#include "BenchCorpus.hpp"
+#include "DecisionFilter.hpp"
+#include "PolicyReplay.hpp"
+
+#include <QBuffer>
+#include <QTest>
+#include <QThread>
+
+using namespace uncopener;
+using namespace uncopener::bench;
+
+namespace
+{
+
+/// Allow-list size of a large site
+constexpr int ALLOW_LIST_SIZE = 10000;
+
+/// Lines of the synthetic proxy log
+constexpr int LOG_LINES = 100000;
+
+/// Log cycling through all benchUrls(), one URL per line
+QByteArray benchLog()
+{
+    const QList<NamedUrl> urls = benchUrls();
+    QByteArray log;
+    for (int i = 0; i < LOG_LINES; ++i)
+    {
+        log += urls.at(i % urls.size()).second.toUtf8();
+        log += '\n';
+    }
+    return log;
+}
+
+} // namespace
+
+class DecisionFilterBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void evaluate_data() { addUrlRows(benchUrls()); }
+
+    void evaluate()
+    {
+        QFETCH(QString, url);
+        DecisionFilter filter(benchConfig(ALLOW_LIST_SIZE));
+
+        QBENCHMARK
+        {
+            Decision decision = filter.evaluate(url);
+            Q_UNUSED(decision);
+        }
+    }
+
+    void run_data()
+    {
+        QTest::addColumn<bool>("tsv");
+        QTest::newRow("json") << false;
+        QTest::newRow("tsv") << true;
+    }
+
+    void run()
+    {
+        QFETCH(bool, tsv);
+        auto format = tsv ? DecisionFilter::Format::Tsv : DecisionFilter::Format::Json;
+        DecisionFilter filter(benchConfig(ALLOW_LIST_SIZE));
+        QByteArray log = benchLog();
+
+        // One iteration filters the whole log
+        QBENCHMARK
+        {
+            QBuffer input(&log);
+            QBuffer output;
+            QVERIFY(input.open(QIODevice::ReadOnly));
+            QVERIFY(output.open(QIODevice::WriteOnly));
+            filter.run(input, output, format);
+        }
+    }
+
+    void replay_data()
+    {
+        QTest::addColumn<int>("threads");
+        QTest::newRow("1 thread") << 1;
+        QTest::newRow("all cores") << QThread::idealThreadCount();
+    }
+
+    void replay()
+    {
+        QFETCH(int, threads);
+        // The new allow-list drops the first entry, so some URLs change verdict
+        Config after = benchConfig(ALLOW_LIST_SIZE);
+        after.setUncAllowList(benchAllowList(ALLOW_LIST_SIZE).mid(1));
+        PolicyReplay replay(benchConfig(ALLOW_LIST_SIZE), after, threads);
+        QByteArray log = benchLog();
+
+        // One iteration replays the whole log
+        QBENCHMARK
+        {
+            QBuffer input(&log);
+            QBuffer output;
+            QVERIFY(input.open(QIODevice::ReadOnly));
+            QVERIFY(output.open(QIODevice::WriteOnly));
+            ReplayStats stats = replay.run(input, output, DecisionFilter::Format::Json);
+            Q_UNUSED(stats);
+        }
+    }
+};
+
+int runDecisionFilterBench(int argc, char* argv[])
+{
+    DecisionFilterBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "DecisionFilterBench.moc"
@@ -0,0 +1,128 @@
+#include "SecurityPolicy.hpp"
+
+#include <QTest>
+
+using namespace uncopener;
+
+namespace
+{
+
+/// Blacklist sizes to compare at; locked-down sites list several thousand extensions
+const QList<int> LIST_SIZES = {10, 100, 1000, 5000};
+
+/// Blacklist of single and double extensions
+QStringList extensionsOfSize(int count)
+{
+    QStringList extensions;
+    extensions.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        extensions.append(i % 2 == 0 ? QString(".x%1").arg(i) : QString(".pdf.x%1").arg(i));
+    }
+    return extensions;
+}
+
+/// Filenames to check: a hit near the end of the list, a double extension and a miss
+/// Sizes are even, so count - 2 is a single and count - 1 a double extension
+QStringList probeFilenames(int count)
+{
+    return {QString("Quarterly Report.X%1").arg(count - 2),
+            QString("invoice.PDF.x%1").arg(count - 1),
+            "Meeting Notes 2024-11-05.docx"};
+}
+
+/// The matcher before the trie, kept as the reference: lowercase, then an endsWith scan
+bool referenceDenied(const QStringList& blacklist, const QString& filename)
+{
+    QString lowercaseFilename = filename.toLower();
+    for (const QString& ext : blacklist)
+    {
+        if (lowercaseFilename.endsWith(ext, Qt::CaseInsensitive))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void addSizeRows()
+{
+    QTest::addColumn<int>("count");
+    for (int count : LIST_SIZES)
+    {
+        QTest::newRow(qPrintable(QString::number(count))) << count;
+    }
+}
+
+} // namespace
+
+class FiletypePolicyBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void trieCheck_data() { addSizeRows(); }
+
+    void trieCheck()
+    {
+        QFETCH(int, count);
+        FiletypePolicy policy;
+        policy.setMode(FiletypeMode::Blacklist);
+        policy.setBlacklist(extensionsOfSize(count));
+        const QStringList filenames = probeFilenames(count);
+
+        int denied = 0;
+        QBENCHMARK
+        {
+            for (const QString& filename : filenames)
+            {
+                denied += policy.check(filename).allowed ? 0 : 1;
+            }
+        }
+        QVERIFY(denied > 0);
+    }
+
+    void linearCheck_data() { addSizeRows(); }
+
+    void linearCheck()
+    {
+        QFETCH(int, count);
+        const QStringList blacklist = extensionsOfSize(count);
+        const QStringList filenames = probeFilenames(count);
+
+        int denied = 0;
+        QBENCHMARK
+        {
+            for (const QString& filename : filenames)
+            {
+                denied += referenceDenied(blacklist, filename) ? 1 : 0;
+            }
+        }
+        QVERIFY(denied > 0);
+    }
+
+    void sameResults_data() { addSizeRows(); }
+
+    void sameResults()
+    {
+        // Not a measurement: the trie must agree with the reference on every probe
+        QFETCH(int, count);
+        const QStringList blacklist = extensionsOfSize(count);
+        FiletypePolicy policy;
+        policy.setMode(FiletypeMode::Blacklist);
+        policy.setBlacklist(blacklist);
+
+        for (const QString& filename : probeFilenames(count))
+        {
+            QCOMPARE(!policy.check(filename).allowed, referenceDenied(blacklist, filename));
+        }
+    }
+};
+
+int runFiletypePolicyBench(int argc, char* argv[])
+{
+    FiletypePolicyBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "FiletypePolicyBench.moc"
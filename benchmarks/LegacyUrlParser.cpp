@@ -0,0 +1,203 @@
+#include "LegacyUrlParser.hpp"
+
+#include <QByteArray>
+#include <QStringList>
+#include <QUrl>
+
+namespace uncopener::bench
+{
+
+namespace
+{
+
+QString percentDecode(const QString& input)
+{
+    return QUrl::fromPercentEncoding(input.toUtf8());
+}
+
+std::optional<QString> normalizePath(const QString& path, bool& hasTrailingSlash)
+{
+    if (path.isEmpty())
+    {
+        // Don't modify hasTrailingSlash - caller has already determined it
+        return QString();
+    }
+
+    // Check for trailing slash before normalization
+    hasTrailingSlash = path.endsWith('/') || path.endsWith('\\');
+
+    // Split the path into segments
+    // Replace backslashes with forward slashes first for uniform processing
+    QString normalizedPath = path;
+    normalizedPath.replace('\\', '/');
+
+    QStringList segments = normalizedPath.split('/', Qt::SkipEmptyParts);
+    QStringList resultSegments;
+
+    for (const QString& segment : segments)
+    {
+        if (segment == "..")
+        {
+            // Directory traversal detected - reject
+            return std::nullopt;
+        }
+        if (segment == ".")
+        {
+            // Skip single-dot segments
+            continue;
+        }
+        resultSegments.append(segment);
+    }
+
+    // Convert back to backslash-separated path for UNC
+    return resultSegments.join('\\');
+}
+
+std::optional<ParseError> checkScheme(const QString& schemeName, const QString& input)
+{
+    QString schemePrefix = schemeName + "://";
+    QString singleSlashPrefix = schemeName + ":/";
+
+    // Check for single slash format (invalid)
+    if (input.startsWith(singleSlashPrefix) && !input.startsWith(schemePrefix))
+    {
+        return ParseError::create(ParseError::Code::InvalidSchemeFormat, input, schemeName);
+    }
+
+    // Check scheme
+    if (!input.startsWith(schemePrefix))
+    {
+        // Check if there's a different scheme
+        qsizetype colonPos = input.indexOf(':');
+        if (colonPos > 0)
+        {
+            // Ensure colon is before any path separator causing it to look like a scheme
+            qsizetype slashPos = input.indexOf('/');
+            if (slashPos < 0 || colonPos < slashPos)
+            {
+                QString foundScheme = input.left(colonPos);
+                return ParseError::create(ParseError::Code::WrongScheme, input, schemeName,
+                                          foundScheme);
+            }
+        }
+        return ParseError::create(ParseError::Code::MissingScheme, input, schemeName);
+    }
+
+    return std::nullopt;
+}
+
+QString stripQueryAndFragment(const QString& input)
+{
+    qsizetype queryPos = input.indexOf('?');
+    qsizetype fragmentPos = input.indexOf('#');
+
+    qsizetype cutPos = -1;
+    if (queryPos >= 0 && fragmentPos >= 0)
+    {
+        cutPos = qMin(queryPos, fragmentPos);
+    }
+    else if (queryPos >= 0)
+    {
+        cutPos = queryPos;
+    }
+    else if (fragmentPos >= 0)
+    {
+        cutPos = fragmentPos;
+    }
+
+    if (cutPos >= 0)
+    {
+        return input.left(cutPos);
+    }
+    return input;
+}
+
+} // namespace
+
+ParseResult legacyParse(const QString& schemeName, const QString& input)
+{
+    if (input.isEmpty())
+    {
+        return ParseError::create(ParseError::Code::EmptyInput, input);
+    }
+
+    if (auto error = checkScheme(schemeName, input))
+    {
+        return *error;
+    }
+
+    // Expected format: scheme://server/share/path
+    QString schemePrefix = schemeName + "://";
+
+    // Extract the part after scheme://
+    QString remainder = input.mid(schemePrefix.length());
+
+    // Remove query string and fragment (they are ignored per the contract)
+    remainder = stripQueryAndFragment(remainder);
+
+    // Split by forward slash to get authority and path
+    qsizetype firstSlash = remainder.indexOf('/');
+
+    QString authority;
+    QString pathPart;
+
+    if (firstSlash < 0)
+    {
+        // No path at all, just authority (and possibly no share)
+        authority = remainder;
+    }
+    else
+    {
+        authority = remainder.left(firstSlash);
+        pathPart = remainder.mid(firstSlash + 1);
+    }
+
+    // Check for empty or whitespace-only authority
+    if (authority.isEmpty())
+    {
+        return ParseError::create(ParseError::Code::MissingAuthority, input, schemeName);
+    }
+    if (authority.trimmed().isEmpty())
+    {
+        return ParseError::create(ParseError::Code::WhitespaceAuthority, input, schemeName);
+    }
+
+    // Percent-decode the authority (server name)
+    QString server = percentDecode(authority);
+
+    // Everything else is the path
+    QString rawPath = pathPart;
+    bool hasTrailingSlash = false;
+
+    // Check if there's a trailing slash
+    // Special case: if remainder ends with '/' but pathPart is empty, we still have a trailing
+    // slash (e.g., "server/" means the URL was "scheme://server/")
+    if (!rawPath.isEmpty())
+    {
+        hasTrailingSlash = rawPath.endsWith('/') || rawPath.endsWith('\\');
+    }
+    else if (firstSlash >= 0 && remainder.endsWith('/'))
+    {
+        // URL like "scheme://server/" - path is empty but there was a trailing slash
+        hasTrailingSlash = true;
+    }
+
+    // Normalize the path
+    auto normalizedPath = normalizePath(rawPath, hasTrailingSlash);
+    if (!normalizedPath.has_value())
+    {
+        return ParseError::create(ParseError::Code::DirectoryTraversal, input);
+    }
+
+    // Build the result
+    UncPath result;
+    result.server = server;
+    // Decode logical path segments (normalizePath returns backslash-separated components)
+    // We want the path part of the UNC string to be properly decoded.
+    result.path = percentDecode(normalizedPath.value());
+    result.hasTrailingSlash = hasTrailingSlash;
+
+    return result;
+}
+
+} // namespace uncopener::bench
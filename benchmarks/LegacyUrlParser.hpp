@@ -0,0 +1,15 @@
+#ifndef UNCOPENER_LEGACYURLPARSER_HPP
+#define UNCOPENER_LEGACYURLPARSER_HPP
+
+#include "UrlParser.hpp"
+
+namespace uncopener::bench
+{
+
+/// UrlParser::parse as it was before the single-pass scanner
+/// Kept as the baseline for timings and as the reference for result comparisons
+[[nodiscard]] ParseResult legacyParse(const QString& schemeName, const QString& input);
+
+} // namespace uncopener::bench
+
+#endif // UNCOPENER_LEGACYURLPARSER_HPP
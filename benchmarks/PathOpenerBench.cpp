@@ -0,0 +1,63 @@
+#include "BenchCorpus.hpp"
+#include "DecisionCache.hpp"
+#include "PathOpener.hpp"
+
+#include <QTest>
+
+using namespace uncopener;
+using namespace uncopener::bench;
+
+namespace
+{
+
+/// Allow-list size of a large site
+constexpr int ALLOW_LIST_SIZE = 10000;
+
+} // namespace
+
+class PathOpenerBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void validate_data() { addUrlRows(benchUrls()); }
+
+    void validate()
+    {
+        QFETCH(QString, url);
+        PathOpener opener(benchConfig(ALLOW_LIST_SIZE));
+
+        QBENCHMARK
+        {
+            OpenResult result = opener.validate(url);
+            Q_UNUSED(result);
+        }
+    }
+
+    void validateCached_data() { addUrlRows(benchUrls()); }
+
+    void validateCached()
+    {
+        QFETCH(QString, url);
+        PathOpener opener(benchConfig(ALLOW_LIST_SIZE));
+        DecisionCache cache;
+        opener.setDecisionCache(&cache);
+
+        // Repeated clicks on the same link after the first one
+        static_cast<void>(opener.validate(url));
+
+        QBENCHMARK
+        {
+            OpenResult result = opener.validate(url);
+            Q_UNUSED(result);
+        }
+    }
+};
+
+int runPathOpenerBench(int argc, char* argv[])
+{
+    PathOpenerBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "PathOpenerBench.moc"
@@ -0,0 +1,54 @@
+#include "BenchCorpus.hpp"
+#include "SecurityPolicy.hpp"
+#include "UrlParser.hpp"
+
+#include <QTest>
+
+using namespace uncopener;
+using namespace uncopener::bench;
+
+namespace
+{
+
+/// Allow-list size of a large site
+constexpr int ALLOW_LIST_SIZE = 10000;
+
+} // namespace
+
+class SecurityPolicyBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void check_data()
+    {
+        // Checks run on UNC paths, so only URLs that parse are used
+        QTest::addColumn<QString>("uncPath");
+        UrlParser parser(BENCH_SCHEME);
+        for (const auto& [name, url] : acceptedBenchUrls())
+        {
+            QTest::newRow(name) << getPath(parser.parse(url)).toUncString();
+        }
+    }
+
+    void check()
+    {
+        QFETCH(QString, uncPath);
+        SecurityPolicy policy;
+        benchConfig(ALLOW_LIST_SIZE).applyTo(policy);
+
+        QBENCHMARK
+        {
+            PolicyCheckResult result = policy.check(uncPath);
+            Q_UNUSED(result);
+        }
+    }
+};
+
+int runSecurityPolicyBench(int argc, char* argv[])
+{
+    SecurityPolicyBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "SecurityPolicyBench.moc"
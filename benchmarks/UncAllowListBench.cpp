@@ -0,0 +1,150 @@
+#include "SecurityPolicy.hpp"
+
+#include <QTest>
+
+#include <map>
+
+using namespace uncopener;
+
+namespace
+{
+
+/// Allow-list sizes to compare at
+const QList<int> LIST_SIZES = {10, 1000, 100000, 1000000};
+
+/// Allow-list entries shaped like a real share inventory, built once per size
+const QStringList& entriesOfSize(int count)
+{
+    static std::map<int, QStringList> cache;
+    QStringList& entries = cache[count];
+    if (entries.isEmpty())
+    {
+        entries.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            entries.append(QString(R"(\\fs%1.corp.example\dept%2\project%3)")
+                               .arg(i / 100)
+                               .arg((i / 10) % 10)
+                               .arg(i % 10));
+        }
+    }
+    return entries;
+}
+
+/// Paths to check: a hit on the last entry (worst case for a scan), a deep hit, and a miss
+QStringList probePaths(int count)
+{
+    const QStringList& entries = entriesOfSize(count);
+    return {entries.last() + R"(\Reports\2024\Q4\summary.pdf)",
+            entries.first().toUpper() + R"(\a\b\c\d\e\f\g\h\file.txt)",
+            R"(\\unknown.corp.example\dept0\project0\file.txt)"};
+}
+
+/// The matcher before the trie, kept as the reference: a case-insensitive startsWith scan
+bool referenceCheck(const QStringList& entries, const QString& uncPath)
+{
+    QString normalizedPath = uncPath;
+    normalizedPath.replace('/', '\\');
+
+    for (const QString& entry : entries)
+    {
+        if (normalizedPath.startsWith(entry, Qt::CaseInsensitive))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void addSizeRows()
+{
+    QTest::addColumn<int>("count");
+    for (int count : LIST_SIZES)
+    {
+        QTest::newRow(qPrintable(QString::number(count))) << count;
+    }
+}
+
+} // namespace
+
+class UncAllowListBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void trieCheck_data() { addSizeRows(); }
+
+    void trieCheck()
+    {
+        QFETCH(int, count);
+        UncAllowList list;
+        list.setEntries(entriesOfSize(count));
+        const QStringList paths = probePaths(count);
+
+        int allowed = 0;
+        QBENCHMARK
+        {
+            for (const QString& path : paths)
+            {
+                allowed += list.check(path).allowed ? 1 : 0;
+            }
+        }
+        QVERIFY(allowed > 0);
+    }
+
+    void linearCheck_data() { addSizeRows(); }
+
+    void linearCheck()
+    {
+        QFETCH(int, count);
+        const QStringList& entries = entriesOfSize(count);
+        const QStringList paths = probePaths(count);
+
+        int allowed = 0;
+        QBENCHMARK
+        {
+            for (const QString& path : paths)
+            {
+                allowed += referenceCheck(entries, path) ? 1 : 0;
+            }
+        }
+        QVERIFY(allowed > 0);
+    }
+
+    void setEntries_data() { addSizeRows(); }
+
+    void setEntries()
+    {
+        QFETCH(int, count);
+        const QStringList& entries = entriesOfSize(count);
+
+        QBENCHMARK
+        {
+            UncAllowList list;
+            list.setEntries(entries);
+        }
+    }
+
+    void sameResults_data() { addSizeRows(); }
+
+    void sameResults()
+    {
+        // Not a measurement: the trie must agree with the reference on every probe
+        QFETCH(int, count);
+        UncAllowList list;
+        list.setEntries(entriesOfSize(count));
+
+        for (const QString& path : probePaths(count))
+        {
+            QCOMPARE(list.check(path).allowed, referenceCheck(entriesOfSize(count), path));
+        }
+    }
+};
+
+int runUncAllowListBench(int argc, char* argv[])
+{
+    UncAllowListBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "UncAllowListBench.moc"
@@ -0,0 +1,200 @@
+#include "AllocationCounter.hpp"
+#include "BenchCorpus.hpp"
+#include "LegacyUrlParser.hpp"
+#include "UrlParser.hpp"
+
+#include <QTest>
+
+using namespace uncopener;
+using namespace uncopener::bench;
+
+namespace
+{
+
+/// Calls per allocation measurement
+constexpr int ALLOCATION_ROUNDS = 1000;
+
+/// Inputs from the URL contract tests plus decoding edge cases, for result comparison only
+QStringList contractCorpus()
+{
+    return {"uncopener://server",
+            "uncopener://server/",
+            "uncopener://server/share",
+            "uncopener://server/share/",
+            "uncopener://server/share/path/file.txt",
+            "uncopener://server/share/path%20name",
+            "uncopener://server/share/path name",
+            "uncopener://server/share/file%23name",
+            "uncopener://server/share/./file",
+            "uncopener://server/share//path",
+            "uncopener://SERVER/SHARE/path",
+            "uncopener://server/share/path?query=value",
+            "uncopener://server/share/path#fragment",
+            R"(uncopener://server/share\path\\file)",
+            "uncopener://file%2Dserver/share",
+            "uncopener://server/share/100%",
+            "uncopener://server/share/100%2",
+            "uncopener://server/share/a%zzb",
+            "uncopener://server/a%/41",
+            "//server/share",
+            "uncopener:/server/share",
+            "uncopener:///share",
+            "uncopener://server/share/../other",
+            "uncopener://server/share/path/../../other",
+            "http://server/share",
+            "",
+            "uncopener://",
+            "uncopener:// /share",
+            "uncopener",
+            "uncopener:x/y"};
+}
+
+bool sameResult(const ParseResult& actual, const ParseResult& expected)
+{
+    if (isSuccess(actual) != isSuccess(expected))
+    {
+        return false;
+    }
+    if (isSuccess(actual))
+    {
+        const UncPath& a = getPath(actual);
+        const UncPath& e = getPath(expected);
+        return a.server == e.server && a.path == e.path &&
+               a.hasTrailingSlash == e.hasTrailingSlash;
+    }
+    const ParseError& a = getError(actual);
+    const ParseError& e = getError(expected);
+    return a.code == e.code && a.reason == e.reason && a.remediation == e.remediation &&
+           a.input == e.input;
+}
+
+/// Average heap allocations of one call
+template <typename Parse>
+qreal allocationsPerCall(Parse parse)
+{
+    quint64 before = allocationCount();
+    for (int i = 0; i < ALLOCATION_ROUNDS; ++i)
+    {
+        ParseResult result = parse();
+        Q_UNUSED(result);
+    }
+    return static_cast<qreal>(allocationCount() - before) / ALLOCATION_ROUNDS;
+}
+
+} // namespace
+
+class UrlParserBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parse_data() { addUrlRows(benchUrls()); }
+
+    void parse()
+    {
+        QFETCH(QString, url);
+        UrlParser parser(BENCH_SCHEME);
+
+        QBENCHMARK
+        {
+            ParseResult result = parser.parse(url);
+            Q_UNUSED(result);
+        }
+    }
+
+    void legacyParse_data() { addUrlRows(benchUrls()); }
+
+    void legacyParse()
+    {
+        QFETCH(QString, url);
+
+        QBENCHMARK
+        {
+            ParseResult result = bench::legacyParse(BENCH_SCHEME, url);
+            Q_UNUSED(result);
+        }
+    }
+
+    void parseAllocations_data() { addUrlRows(benchUrls()); }
+
+    void parseAllocations()
+    {
+        if (!allocationCountingSupported())
+        {
+            QSKIP("Allocation counting needs glibc");
+        }
+        QFETCH(QString, url);
+        UrlParser parser(BENCH_SCHEME);
+
+        QTest::setBenchmarkResult(allocationsPerCall([&] { return parser.parse(url); }),
+                                  QTest::Events);
+    }
+
+    void legacyParseAllocations_data() { addUrlRows(benchUrls()); }
+
+    void legacyParseAllocations()
+    {
+        if (!allocationCountingSupported())
+        {
+            QSKIP("Allocation counting needs glibc");
+        }
+        QFETCH(QString, url);
+
+        QTest::setBenchmarkResult(
+            allocationsPerCall([&] { return bench::legacyParse(BENCH_SCHEME, url); }),
+            QTest::Events);
+    }
+
+    void toUncString_data() { addUrlRows(acceptedBenchUrls()); }
+
+    void toUncString()
+    {
+        QFETCH(QString, url);
+        UncPath path = getPath(UrlParser(BENCH_SCHEME).parse(url));
+
+        QBENCHMARK
+        {
+            QString unc = path.toUncString();
+            Q_UNUSED(unc);
+        }
+    }
+
+    void toSmbUrl_data() { addUrlRows(acceptedBenchUrls()); }
+
+    void toSmbUrl()
+    {
+        QFETCH(QString, url);
+        UncPath path = getPath(UrlParser(BENCH_SCHEME).parse(url));
+
+        QBENCHMARK
+        {
+            QString smbUrl = path.toSmbUrl(R"(CORP\jdoe)");
+            Q_UNUSED(smbUrl);
+        }
+    }
+
+    void sameResults()
+    {
+        // Not a measurement: the single-pass parser must agree with the legacy parser
+        UrlParser parser(BENCH_SCHEME);
+        QStringList urls = contractCorpus();
+        for (const NamedUrl& entry : benchUrls())
+        {
+            urls.append(entry.second);
+        }
+
+        for (const QString& url : urls)
+        {
+            QVERIFY2(sameResult(parser.parse(url), bench::legacyParse(BENCH_SCHEME, url)),
+                     qPrintable(url));
+        }
+    }
+};
+
+int runUrlParserBench(int argc, char* argv[])
+{
+    UrlParserBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "UrlParserBench.moc"
@@ -6,6 +6,8 @@ if(CLANG_FORMAT_EXECUTABLE)
         ${CMAKE_SOURCE_DIR}/src/*.hpp
         ${CMAKE_SOURCE_DIR}/tests/*.cpp
         ${CMAKE_SOURCE_DIR}/tests/*.hpp
+        ${CMAKE_SOURCE_DIR}/benchmarks/*.cpp
+        ${CMAKE_SOURCE_DIR}/benchmarks/*.hpp
     )
 
     add_custom_target(format
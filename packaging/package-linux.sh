@@ -115,9 +115,17 @@ echo "Building AppImage..."
 export LDAI_UPDATE_INFORMATION="gh-releases-zsync|bebuch|UncOpener|latest|${APP_NAME}-*-x86_64.AppImage.zsync"
 export OUTPUT="${OUTPUT_DIR}/${APP_NAME}-${VERSION}-x86_64.AppImage"
 
+# Bundle the minimal URL handler next to the main executable if it was built
+HANDLER_ARGS=()
+HANDLER="${BUILD_DIR}/src/app/Release/uncopener-handler"
+if [ -f "$HANDLER" ]; then
+    HANDLER_ARGS=(--executable "$HANDLER")
+fi
+
 "$LINUXDEPLOY" \
     --appdir "$APPDIR" \
     --executable "$EXECUTABLE" \
+    "${HANDLER_ARGS[@]}" \
     --desktop-file "${OUTPUT_DIR}/uncopener.desktop" \
     --icon-file "$ICON_SRC" \
     --plugin qt \
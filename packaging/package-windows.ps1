@@ -68,8 +68,12 @@ New-Item -ItemType Directory -Force -Path $StageDir | Out-Null
 Write-Host ""
 Write-Host "Staging files..." -ForegroundColor Cyan
 
-# Copy executable
+# Copy executables (the minimal handler is registered for URL clicks if present)
 Copy-Item $ExePath $StageDir
+$HandlerPath = Join-Path (Split-Path $ExePath -Parent) "uncopener-handler.exe"
+if (Test-Path $HandlerPath) {
+    Copy-Item $HandlerPath $StageDir
+}
 
 # Copy icon
 $IconPath = Join-Path $ProjectRoot "assets\windows\icon.ico"
@@ -0,0 +1,64 @@
+#include "BatchErrorDialog.hpp"
+
+#include "AppIcon.hpp"
+
+#include <QDialogButtonBox>
+#include <QHeaderView>
+#include <QLabel>
+#include <QStyle>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+BatchErrorDialog::BatchErrorDialog(const QList<uncopener::BatchFailure>& failures,
+                                   qsizetype totalCount, QWidget* parent)
+    : QDialog(parent)
+{
+    setWindowTitle("UncOpener - Error");
+    setWindowIcon(loadAppIcon());
+    setMinimumWidth(700);
+    setModal(true);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->setSpacing(15);
+
+    // Icon and title
+    auto* headerLayout = new QHBoxLayout();
+    auto* iconLabel = new QLabel(this);
+    iconLabel->setPixmap(style()->standardPixmap(QStyle::SP_MessageBoxCritical));
+    headerLayout->addWidget(iconLabel);
+    auto* titleLabel =
+        new QLabel(QString("Failed to open %1 of %2 URLs").arg(failures.size()).arg(totalCount),
+                   this);
+    titleLabel->setObjectName("titleLabel");
+    QFont titleFont = titleLabel->font();
+    titleFont.setBold(true);
+    titleFont.setPointSize(titleFont.pointSize() + 2);
+    titleLabel->setFont(titleFont);
+    headerLayout->addWidget(titleLabel);
+    headerLayout->addStretch();
+    layout->addLayout(headerLayout);
+
+    // One row per failed URL
+    auto* failureList = new QTreeWidget(this);
+    failureList->setObjectName("failureList");
+    failureList->setHeaderLabels({"Input", "Reason", "What to do"});
+    failureList->setRootIsDecorated(false);
+    failureList->setWordWrap(true);
+    failureList->setAlternatingRowColors(true);
+    for (const uncopener::BatchFailure& failure : failures)
+    {
+        auto* item = new QTreeWidgetItem(
+            failureList, {failure.displayPath, failure.reason, failure.remediation});
+        item->setToolTip(0, failure.url);
+        item->setToolTip(2, failure.remediation);
+    }
+    failureList->header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+    failureList->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    failureList->header()->setStretchLastSection(true);
+    layout->addWidget(failureList);
+
+    // OK button
+    auto* buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok, this);
+    connect(buttonBox, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    layout->addWidget(buttonBox);
+}
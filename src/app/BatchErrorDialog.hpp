@@ -0,0 +1,19 @@
+#ifndef UNCOPENER_BATCHERRORDIALOG_HPP
+#define UNCOPENER_BATCHERRORDIALOG_HPP
+
+#include "BatchOpener.hpp"
+
+#include <QDialog>
+#include <QList>
+
+/// Modal dialog summarizing all failures of a batch in handler mode
+class BatchErrorDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit BatchErrorDialog(const QList<uncopener::BatchFailure>& failures, qsizetype totalCount,
+                              QWidget* parent = nullptr);
+};
+
+#endif // UNCOPENER_BATCHERRORDIALOG_HPP
@@ -1,12 +1,16 @@
 #include "MainWindow.hpp"
 
 #include "AppIcon.hpp"
+#include "PathOpener.hpp"
 #include "SecurityPolicy.hpp"
 
 #include <QFormLayout>
 #include <QGroupBox>
 #include <QHBoxLayout>
 #include <QMessageBox>
+#include <QStatusBar>
+#include <QTimer>
+#include <QUrl>
 #include <QVBoxLayout>
 
 MainWindow::MainWindow(QWidget* parent)
@@ -16,8 +20,21 @@ MainWindow::MainWindow(QWidget* parent)
     setWindowIcon(loadAppIcon());
     setMinimumSize(600, 700);
 
+#ifndef Q_OS_WIN
+    // Link tests show the mount point a mounted share opens through
+    m_mounts = std::make_shared<uncopener::MountIndex>();
+#endif
+
     setupUi();
     loadConfig();
+
+    // Pick up edits made by other programs while the window is open
+    m_configWatcher = new uncopener::ConfigWatcher(uncopener::Config::configFilePath(), this);
+    connect(m_configWatcher, &uncopener::ConfigWatcher::configChanged, this,
+            &MainWindow::onConfigFileChanged);
+    connect(m_configWatcher, &uncopener::ConfigWatcher::reloadFailed, this,
+            &MainWindow::onConfigReloadFailed);
+    static_cast<void>(m_configWatcher->start());
 }
 
 void MainWindow::setupUi()
@@ -163,6 +180,24 @@ void MainWindow::setupUi()
     connect(m_unregisterButton, &QPushButton::clicked, this, &MainWindow::onUnregisterClicked);
 
     mainLayout->addWidget(registrationGroup);
+
+    // Link test section: what a link opens with the settings above
+    auto* testGroup = new QGroupBox("Test Link", centralWidget);
+    auto* testLayout = new QVBoxLayout(testGroup);
+    m_testUrlEdit = new QLineEdit(testGroup);
+    m_testUrlEdit->setPlaceholderText("uncopener://server/share/file.txt");
+    testLayout->addWidget(m_testUrlEdit);
+    m_testResultLabel = new QLabel(testGroup);
+    m_testResultLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    m_testResultLabel->setWordWrap(true);
+    testLayout->addWidget(m_testResultLabel);
+    connect(m_testUrlEdit, &QLineEdit::textChanged, this, &MainWindow::onTestUrlChanged);
+    m_testTimer = new QTimer(this);
+    m_testTimer->setSingleShot(true);
+    m_testTimer->setInterval(TEST_DEBOUNCE_MS);
+    connect(m_testTimer, &QTimer::timeout, this, &MainWindow::updateTestResult);
+
+    mainLayout->addWidget(testGroup);
 }
 
 void MainWindow::loadConfig()
@@ -315,6 +350,59 @@ void MainWindow::validateAndUpdateStatus()
 
     m_statusLabel->setPalette(palette);
     setWindowTitle(title);
+
+    // The settings may have changed
+    m_testPolicy.reset();
+    m_testTimer->start();
+}
+
+void MainWindow::updateTestResult()
+{
+    QString url = m_testUrlEdit->text().trimmed();
+    m_testResultLabel->setPalette(QPalette());
+    if (url.isEmpty())
+    {
+        m_testResultLabel->setText("Enter a link to see what it opens.");
+        return;
+    }
+
+    // Evaluate against the edited settings, not the saved ones
+    if (!m_testPolicy)
+    {
+        m_testPolicy = uncopener::CompiledPolicy::compile(m_config);
+    }
+    uncopener::PathOpener opener(m_testPolicy);
+    if (m_config.preferLocalMounts())
+    {
+        opener.setMountIndex(m_mounts);
+    }
+
+    uncopener::ValidationResult result = opener.evaluate(url);
+    QPalette palette = m_testResultLabel->palette();
+    if (!result.allowed())
+    {
+        m_testResultLabel->setText("Blocked: " + result.toOpenResult().errorReason);
+        palette.setColor(QPalette::WindowText, Qt::red);
+        m_testResultLabel->setPalette(palette);
+        return;
+    }
+
+    // Show local targets as paths
+    QString target = opener.resolveTarget(result);
+    QUrl targetUrl(target);
+    QString text = "Opens: " + (targetUrl.isLocalFile() ? targetUrl.toLocalFile() : target);
+    if (!result.translation.isEmpty())
+    {
+        text += QString("\nTranslated by the rule for %1").arg(result.translation);
+    }
+    m_testResultLabel->setText(text);
+    palette.setColor(QPalette::WindowText, Qt::darkGreen);
+    m_testResultLabel->setPalette(palette);
+}
+
+void MainWindow::onTestUrlChanged(const QString& /*text*/)
+{
+    m_testTimer->start();
 }
 
 void MainWindow::onSaveClicked()
@@ -334,6 +422,35 @@ void MainWindow::onSaveClicked()
     }
 }
 
+void MainWindow::onConfigFileChanged(const uncopener::Config& config)
+{
+    // Our own save, or a change that makes no difference
+    QByteArray json = config.toJsonBytes();
+    if (json == m_savedConfigJson)
+    {
+        return;
+    }
+
+    // Unsaved edits are kept; they are now compared against the new file
+    bool keepEdits = hasUnsavedChanges();
+    m_savedConfigJson = json;
+    if (keepEdits)
+    {
+        statusBar()->showMessage("Configuration file changed on disk; saving overwrites it");
+        validateAndUpdateStatus();
+        return;
+    }
+
+    m_config = config;
+    updateUiFromConfig();
+    statusBar()->showMessage("Configuration reloaded from disk", 5000);
+}
+
+void MainWindow::onConfigReloadFailed(const QString& reason)
+{
+    statusBar()->showMessage("Configuration file not reloaded: " + reason);
+}
+
 void MainWindow::onSchemeNameChanged(const QString& /*text*/)
 {
     validateAndUpdateStatus();
@@ -503,6 +620,7 @@ void MainWindow::onRegisterClicked()
         }
     }
 
+    m_registry->setDBusActivatable(m_config.dbusActivation());
     uncopener::RegistrationResult result = m_registry->registerScheme(schemeName);
     if (result.success)
     {
@@ -1,7 +1,10 @@
 #ifndef UNCOPENER_MAINWINDOW_HPP
 #define UNCOPENER_MAINWINDOW_HPP
 
+#include "CompiledPolicy.hpp"
 #include "Config.hpp"
+#include "ConfigWatcher.hpp"
+#include "MountIndex.hpp"
 #include "SchemeRegistry.hpp"
 
 #include <QComboBox>
@@ -13,6 +16,8 @@
 
 #include <memory>
 
+class QTimer;
+
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -31,6 +36,9 @@ private slots:
     void onSmbUsernameChanged(const QString& text);
     void onRegisterClicked();
     void onUnregisterClicked();
+    void onConfigFileChanged(const uncopener::Config& config);
+    void onConfigReloadFailed(const QString& reason);
+    void onTestUrlChanged(const QString& text);
 
 private:
     void setupUi();
@@ -40,11 +48,19 @@ private:
     void validateAndUpdateStatus();
     void updateRegistrationStatus();
     void updateFiletypeListFromMode();
+    void updateTestResult();
     [[nodiscard]] bool hasUnsavedChanges();
 
     uncopener::Config m_config;
     std::unique_ptr<uncopener::SchemeRegistry> m_registry;
     QByteArray m_savedConfigJson;
+    uncopener::ConfigWatcher* m_configWatcher = nullptr;
+    std::shared_ptr<uncopener::MountIndex> m_mounts;
+
+    // Link tests wait for a pause in typing and compile the edited settings once per change
+    static constexpr int TEST_DEBOUNCE_MS = 150;
+    QTimer* m_testTimer = nullptr;
+    std::shared_ptr<const uncopener::CompiledPolicy> m_testPolicy;
 
     // Widgets
     QLineEdit* m_schemeNameEdit = nullptr;
@@ -70,6 +86,10 @@ private:
     QLabel* m_registrationStatusLabel = nullptr;
     QPushButton* m_registerButton = nullptr;
     QPushButton* m_unregisterButton = nullptr;
+
+    // Link test widgets
+    QLineEdit* m_testUrlEdit = nullptr;
+    QLabel* m_testResultLabel = nullptr;
 };
 
 #endif // UNCOPENER_MAINWINDOW_HPP
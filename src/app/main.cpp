@@ -1,15 +1,56 @@
+#include "AsyncOpener.hpp"
+#include "BatchErrorDialog.hpp"
+#include "BatchOpener.hpp"
 #include "Config.hpp"
+#include "ConfigCache.hpp"
+#include "ConfigWatcher.hpp"
+#include "DecisionCache.hpp"
 #include "ErrorDialog.hpp"
 #include "MainWindow.hpp"
+#include "MountIndex.hpp"
+#include "MountPrewarmer.hpp"
+#include "NativeMessagingHost.hpp"
+#include "OpenerBackend.hpp"
 #include "PathOpener.hpp"
+#include "PolicyStore.hpp"
+#include "ReachabilityProbe.hpp"
+#include "RequestThrottle.hpp"
+#include "ResidentServer.hpp"
+#include "ShareHistory.hpp"
+#ifdef UNCOPENER_HAS_DBUS
+#include "DBusApplicationService.hpp"
+#include "SchemeRegistry.hpp"
+#endif
 
 #include <QApplication>
+#include <QFile>
 #include <QIcon>
 #include <QSystemTrayIcon>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <utility>
 
 namespace
 {
 
+const QString RESIDENT_OPTION = "--resident";
+const QString SHOW_ERROR_OPTION = "--show-error";
+const QString STDIN_OPTION = "--stdin";
+const QString NATIVE_MESSAGING_OPTION = "--native-messaging";
+const QString PREWARM_OPTION = "--prewarm";
+#ifdef UNCOPENER_HAS_DBUS
+const QString DBUS_SERVICE_OPTION = "--dbus-service";
+#endif
+
+// Request sources of long-running instances, each with its own rate limit
+const QString RESIDENT_SOURCE = "resident";
+#ifdef UNCOPENER_HAS_DBUS
+const QString DBUS_SOURCE = "dbus";
+#endif
+
 /// Show a desktop notification
 void showNotification(const QString& title, const QString& message,
                       QSystemTrayIcon::MessageIcon icon = QSystemTrayIcon::Information)
@@ -23,40 +64,494 @@ void showNotification(const QString& title, const QString& message,
     QApplication::processEvents();
 }
 
-/// Handle URL opening mode (when called with a URL argument)
-int runHandlerMode(QApplication& app, const QString& url)
+/// Index of local SMB mounts; nullptr on Windows, where UNC paths are opened directly
+std::shared_ptr<uncopener::MountIndex> createMountIndex()
 {
-    Q_UNUSED(app)
+#ifdef Q_OS_WIN
+    return nullptr;
+#else
+    return std::make_shared<uncopener::MountIndex>();
+#endif
+}
 
-    // Load configuration
-    uncopener::Config config;
-    config.load();
+/// Open mounted shares through their mount point if the config of the opener prefers it
+void useLocalMounts(uncopener::PathOpener& opener,
+                    const std::shared_ptr<uncopener::MountIndex>& mounts)
+{
+    if (opener.policy()->config().preferLocalMounts())
+    {
+        opener.setMountIndex(mounts);
+    }
+}
 
-    // Create path opener and attempt to open
-    uncopener::PathOpener opener(config);
-    uncopener::OpenResult result = opener.open(url);
+/// Probe for servers if the config asks for it; nullptr opens targets without checking
+std::shared_ptr<uncopener::ReachabilityProbe> createReachabilityProbe(
+    const uncopener::Config& config)
+{
+    if (!config.probeServers())
+    {
+        return nullptr;
+    }
+    return std::make_shared<uncopener::ReachabilityProbe>(config);
+}
+
+/// History of opened shares if the config asks for prewarming; nullptr records nothing
+std::shared_ptr<uncopener::ShareHistory> createShareHistory(const uncopener::Config& config)
+{
+    if (!config.prewarm())
+    {
+        return nullptr;
+    }
+    auto history = std::make_shared<uncopener::ShareHistory>();
+    history->load();
+    return history;
+}
+
+/// Mount the most used shares of the history in the background
+void prewarmMostUsed(const uncopener::Config& config,
+                     const std::shared_ptr<uncopener::ShareHistory>& history,
+                     uncopener::MountPrewarmer& prewarmer)
+{
+    if (history)
+    {
+        prewarmer.prewarm(history->mostUsed(config.prewarmShares()));
+    }
+}
+
+/// Mount the share of a URL ahead of opening it, if prewarming is on and the policy allows it
+void prewarmUrl(const uncopener::PathOpener& opener, uncopener::MountPrewarmer& prewarmer,
+                const QString& url)
+{
+    if (!opener.policy()->config().prewarm())
+    {
+        return;
+    }
+
+    // Translated paths are local already
+    uncopener::ValidationResult validation = opener.evaluateCached(url);
+    if (validation.allowed() && validation.translation.isEmpty())
+    {
+        prewarmer.request(validation.path());
+    }
+}
+
+/// Open one URL and report the outcome to the user
+int handleUrl(uncopener::PathOpener& opener, const QString& url)
+{
+    uncopener::ValidationResult validation = opener.evaluateCached(url);
+    uncopener::OpenResult result = opener.open(validation);
 
     if (!result.success)
     {
         // Show error dialog
-        QString displayUrl = url;
-        const uncopener::UncPath& parsedPath = opener.lastParsedPath();
-        if (!parsedPath.server.isEmpty())
+        ErrorDialog dialog(validation.displayPath(), result.errorReason, result.errorRemediation);
+        dialog.exec();
+        return 1;
+    }
+
+    // Success: show notification
+    showNotification("UncOpener", "Opening: " + validation.displayPath());
+    return 0;
+}
+
+/// Open several URLs with one loaded policy and report all failures in one dialog
+int handleBatch(uncopener::PathOpener& opener, const QStringList& urls)
+{
+    if (urls.isEmpty())
+    {
+        return 0;
+    }
+
+    if (urls.size() == 1)
+    {
+        return handleUrl(opener, urls.first());
+    }
+
+    uncopener::BatchOpener batch(opener);
+    uncopener::BatchResult result = batch.openAll(urls);
+    if (!result.success())
+    {
+        BatchErrorDialog dialog(result.failures, urls.size());
+        dialog.exec();
+        return 1;
+    }
+
+    showNotification("UncOpener", QString("Opening %1 locations").arg(result.openedCount));
+    return 0;
+}
+
+/// Open one URL on the worker pool and report the outcome once it is known
+void handleUrlAsync(uncopener::PathOpener& opener, uncopener::AsyncOpener& asyncOpener,
+                    const QString& url)
+{
+    uncopener::ValidationResult validation = opener.evaluateCached(url);
+    QString displayPath = validation.displayPath();
+
+    // Through the local mount point if the share is mounted; revealed files are selected in
+    // their folder
+    validation.targetUrl = opener.resolveTarget(validation);
+    QFuture<uncopener::OpenResult> future = asyncOpener.open(validation);
+    future.then(
+        &asyncOpener,
+        [displayPath, path = validation.path(), history = opener.shareHistory()](
+            const uncopener::OpenResult& result)
         {
-            displayUrl = parsedPath.toUncString();
+            if (!result.success)
+            {
+                ErrorDialog dialog(displayPath, result.errorReason, result.errorRemediation);
+                dialog.exec();
+                return;
+            }
+            if (history)
+            {
+                history->record(path);
+            }
+            showNotification("UncOpener", "Opening: " + displayPath);
+        });
+}
+
+/// Open several URLs on the worker pool and report all failures in one dialog
+/// A stalled server delays only the report; the instance keeps serving other requests
+void handleBatchAsync(uncopener::PathOpener& opener, uncopener::AsyncOpener& asyncOpener,
+                      const QStringList& urls)
+{
+    if (urls.isEmpty())
+    {
+        return;
+    }
+
+    if (urls.size() == 1)
+    {
+        handleUrlAsync(opener, asyncOpener, urls.first());
+        return;
+    }
+
+    uncopener::BatchResult prepared;
+    QList<uncopener::BatchTarget> targets =
+        uncopener::BatchOpener(opener).prepare(urls, prepared);
+
+    // Revealed files of one folder go to the file manager in one request
+    QList<QList<qsizetype>> groups = uncopener::BatchOpener::groupTargets(targets);
+    QList<QFuture<uncopener::OpenResult>> futures;
+    for (const QList<qsizetype>& group : std::as_const(groups))
+    {
+        const uncopener::BatchTarget& first = targets.at(group.first());
+        if (!first.reveal)
+        {
+            futures.append(asyncOpener.openTarget(first.server, first.targetUrl));
+            continue;
+        }
+        QStringList targetUrls;
+        for (qsizetype index : group)
+        {
+            targetUrls.append(targets.at(index).targetUrl);
         }
+        futures.append(asyncOpener.revealTargets(first.server, targetUrls));
+    }
 
-        ErrorDialog dialog(displayUrl, result.errorReason, result.errorRemediation);
-        dialog.exec();
+    QtFuture::whenAll(futures.begin(), futures.end())
+        .then(&asyncOpener,
+              [prepared, targets, groups, total = urls.size(), history = opener.shareHistory()](
+                  const QList<QFuture<uncopener::OpenResult>>& done)
+              {
+                  uncopener::BatchResult result = prepared;
+                  for (qsizetype i = 0; i < done.size(); ++i)
+                  {
+                      // A canceled request has no result and is not reported
+                      if (done.at(i).resultCount() == 0)
+                      {
+                          continue;
+                      }
+                      uncopener::OpenResult opened = done.at(i).result();
+                      for (qsizetype index : groups.at(i))
+                      {
+                          if (!opened.success)
+                          {
+                              const uncopener::BatchTarget& target = targets.at(index);
+                              result.failures.append({target.url, target.displayPath,
+                                                      opened.errorReason,
+                                                      opened.errorRemediation});
+                              continue;
+                          }
+                          if (history)
+                          {
+                              history->record(targets.at(index).path);
+                          }
+                          ++result.openedCount;
+                      }
+                  }
+
+                  if (!result.success())
+                  {
+                      BatchErrorDialog dialog(result.failures, total);
+                      dialog.exec();
+                      return;
+                  }
+                  showNotification("UncOpener",
+                                   QString("Opening %1 locations").arg(result.openedCount));
+              });
+}
+
+/// Drop URLs that repeat a recent request, or all of them if their source exceeds its rate limit
+/// The URLs of one request (e.g. a batch from a portal) take a single token together. The first
+/// rate-limited request of a run is reported, so floods are visible and not lost silently.
+QStringList admitUrls(const uncopener::PathOpener& opener, uncopener::RequestThrottle& throttle,
+                      const QStringList& urls, const QString& source)
+{
+    // Requests are keyed by the UNC path, so different spellings of one path coalesce
+    QStringList paths;
+    paths.reserve(urls.size());
+    for (const QString& url : urls)
+    {
+        paths.append(opener.evaluateCached(url).displayPath());
+    }
+
+    QList<qsizetype> admitted;
+    uncopener::ThrottleVerdict verdict = throttle.admitBatch(paths, source, admitted);
+    if (verdict == uncopener::ThrottleVerdict::RateLimited &&
+        throttle.rateLimitedInRow(source) == 1)
+    {
+        showNotification("UncOpener",
+                         QString("Too many requests, ignoring links for a moment "
+                                 "(%1 ignored so far)")
+                             .arg(throttle.stats().rateLimited),
+                         QSystemTrayIcon::Warning);
+    }
+
+    QStringList admittedUrls;
+    admittedUrls.reserve(admitted.size());
+    for (qsizetype index : std::as_const(admitted))
+    {
+        admittedUrls.append(urls.at(index));
+    }
+    return admittedUrls;
+}
+
+/// Apply external edits of config.json without restarting
+/// The file is parsed and the policy compiled off the main thread, on reloadPool; a file that
+/// fails keeps the current policy. reloadPool must be destroyed before store.
+void watchConfig(uncopener::ConfigWatcher& watcher, uncopener::PolicyStore& store,
+                 QThreadPool& reloadPool, uncopener::RequestThrottle& throttle,
+                 uncopener::AsyncOpener& asyncOpener)
+{
+    QObject::connect(&watcher, &uncopener::ConfigWatcher::configChanged, &watcher,
+                     [&store, &reloadPool, &throttle, &asyncOpener](const uncopener::Config& config)
+                     {
+                         static_cast<void>(store.reloadInBackground(config, &reloadPool));
+                         throttle.reconfigure(config);
+                         asyncOpener.setTimeout(config.openTimeoutMs());
+                         asyncOpener.setBackend(uncopener::OpenerBackend::create(config));
+                         asyncOpener.setRevealBackend(
+                             uncopener::OpenerBackend::createRevealer(config));
+                         asyncOpener.setReachabilityProbe(createReachabilityProbe(config));
+                     });
+    QObject::connect(&watcher, &uncopener::ConfigWatcher::reloadFailed, &watcher,
+                     [](const QString& reason)
+                     {
+                         showNotification("UncOpener", "Configuration not reloaded: " + reason,
+                                          QSystemTrayIcon::Warning);
+                     });
+    static_cast<void>(watcher.start());
+}
+
+/// Everything a long-running instance (resident mode or D-Bus service) keeps between requests
+/// Repeated clicks and flooding pages are throttled before anything opens, repeated URLs are
+/// validated from the cache, and paths open on workers so a stalled server cannot block the
+/// instance. Edits of config.json are applied without a restart, and the most used shares are
+/// mounted ahead of the first click.
+struct LongRunningInstance
+{
+    explicit LongRunningInstance(const uncopener::Config& config)
+        : store(config), throttle(config), mounts(createMountIndex()),
+          asyncOpener(config.openTimeoutMs()), history(createShareHistory(config)),
+          prewarmer(config)
+    {
+        asyncOpener.setBackend(uncopener::OpenerBackend::create(config));
+        asyncOpener.setRevealBackend(uncopener::OpenerBackend::createRevealer(config));
+        asyncOpener.setReachabilityProbe(createReachabilityProbe(config));
+        watchConfig(watcher, store, reloadPool, throttle, asyncOpener);
+        prewarmer.setMountIndex(mounts);
+        prewarmMostUsed(config, history, prewarmer);
+    }
+
+    /// Build an opener for one request, validating against the current policy snapshot
+    [[nodiscard]] uncopener::PathOpener requestOpener()
+    {
+        uncopener::PathOpener opener(store.snapshot());
+        opener.setDecisionCache(&cache);
+        opener.setShareHistory(history);
+        useLocalMounts(opener, mounts);
+        return opener;
+    }
+
+    /// Throttle the URLs of one request from a source and open the admitted ones
+    /// Several URLs are opened as a batch with one summary of all failures
+    void open(const QStringList& urls, const QString& source)
+    {
+        uncopener::PathOpener opener = requestOpener();
+        handleBatchAsync(opener, asyncOpener, admitUrls(opener, throttle, urls, source));
+    }
+
+    uncopener::PolicyStore store;
+    QThreadPool reloadPool; // Waits for a running reload before the store goes away
+    uncopener::RequestThrottle throttle;
+    uncopener::DecisionCache cache;
+    std::shared_ptr<uncopener::MountIndex> mounts;
+    uncopener::AsyncOpener asyncOpener;
+    uncopener::ConfigWatcher watcher;
+    std::shared_ptr<uncopener::ShareHistory> history;
+    uncopener::MountPrewarmer prewarmer;
+};
+
+/// Keep running and open URLs forwarded by later invocations
+/// Config, security policy and parser stay in memory between requests
+int runResidentMode(QApplication& app, const uncopener::Config& config,
+                    const QStringList& initialUrls)
+{
+    uncopener::ResidentServer server;
+    if (!server.listen())
+    {
+        // Another instance became resident in the meantime
+        if (initialUrls.isEmpty() ||
+            uncopener::ResidentServer::forward(server.serverName(), initialUrls))
+        {
+            return 0;
+        }
+
+        uncopener::PathOpener opener = uncopener::PathOpener::fromConfig(config);
+        return handleBatch(opener, initialUrls);
+    }
+
+    LongRunningInstance instance(config);
+    QObject::connect(&server, &uncopener::ResidentServer::urlReceived, &app,
+                     [&instance](const QString& url) { instance.open({url}, RESIDENT_SOURCE); });
+    QObject::connect(&server, &uncopener::ResidentServer::batchReceived, &app,
+                     [&instance](const QStringList& urls)
+                     { instance.open(urls, RESIDENT_SOURCE); });
+
+    // Shares other than the most used ones are mounted on request (e.g. when the browser
+    // extension sees a link hovered)
+    QObject::connect(&server, &uncopener::ResidentServer::prewarmRequested, &app,
+                     [&instance](const QString& url)
+                     { prewarmUrl(instance.requestOpener(), instance.prewarmer, url); });
+
+    // Dialogs come and go, the instance stays
+    app.setQuitOnLastWindowClosed(false);
+
+    uncopener::PathOpener opener = instance.requestOpener();
+    handleBatchAsync(opener, instance.asyncOpener, initialUrls);
+
+    return app.exec();
+}
+
+/// Handle URL opening mode (when called with one or more URL arguments)
+/// A resident instance was tried already
+int runHandlerMode(QApplication& app, const QStringList& urls)
+{
+    // Load configuration (from the binary cache when it is fresh)
+    uncopener::Config config;
+    uncopener::ConfigCache::load(config);
+
+    if (config.residentMode())
+    {
+        return runResidentMode(app, config, urls);
+    }
+
+    uncopener::PathOpener opener = uncopener::PathOpener::fromConfig(config);
+    return handleBatch(opener, urls);
+}
+
+/// Read newline-delimited URLs from standard input
+QStringList readUrlsFromStdin()
+{
+    QFile input;
+    if (!input.open(stdin, QIODevice::ReadOnly))
+    {
+        return {};
+    }
+    return uncopener::BatchOpener::readUrls(input);
+}
+
+/// Answer requests of the browser extension until the browser closes the connection
+/// Replies carry the result, so no dialogs or notifications are shown
+int runNativeMessagingHost()
+{
+    QFile input;
+    QFile output;
+    if (!uncopener::NativeMessagingHost::openStdio(input, output))
+    {
         return 1;
     }
 
-    // Success: show notification and exit
-    const uncopener::UncPath& path = opener.lastParsedPath();
-    showNotification("UncOpener", "Opening: " + path.toUncString());
+    uncopener::Config config;
+    uncopener::ConfigCache::load(config);
+
+    uncopener::NativeMessagingHost host(config);
+    host.serve(input, output);
     return 0;
 }
 
+#ifdef UNCOPENER_HAS_DBUS
+/// Serve org.freedesktop.Application for the DBusActivatable handler
+/// Started by the session bus on the first URL; later URLs arrive via Open() on this instance
+int runDBusService(QApplication& app)
+{
+    uncopener::Config config;
+    uncopener::ConfigCache::load(config);
+
+    uncopener::DBusApplicationService service;
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    if (!service.registerOn(bus, uncopener::SchemeRegistry::DBUS_SERVICE_NAME))
+    {
+        // Another instance owns the name and receives the URLs
+        return 1;
+    }
+
+    LongRunningInstance instance(config);
+    QObject::connect(&service, &uncopener::DBusApplicationService::openRequested, &app,
+                     [&instance](const QStringList& urls) { instance.open(urls, DBUS_SOURCE); });
+
+    // Activate() without URLs (e.g. from a launcher) shows the configuration window
+    std::unique_ptr<MainWindow> window;
+    QObject::connect(&service, &uncopener::DBusApplicationService::activated, &app,
+                     [&window]()
+                     {
+                         if (!window)
+                         {
+                             window = std::make_unique<MainWindow>();
+                         }
+                         window->show();
+                         window->raise();
+                     });
+
+    // Dialogs come and go, the instance stays
+    app.setQuitOnLastWindowClosed(false);
+
+    return app.exec();
+}
+#endif
+
+/// Mount the most used shares and exit once the mount commands are done (e.g. at login)
+int runPrewarmMode(QApplication& app)
+{
+    uncopener::Config config;
+    uncopener::ConfigCache::load(config);
+
+    std::shared_ptr<uncopener::ShareHistory> history = createShareHistory(config);
+    uncopener::MountPrewarmer prewarmer(config);
+    prewarmer.setMountIndex(createMountIndex());
+    prewarmMostUsed(config, history, prewarmer);
+    if (prewarmer.runningCount() == 0)
+    {
+        return 0;
+    }
+
+    // Queued, so a command that fails at once does not quit before the loop runs
+    QObject::connect(&prewarmer, &uncopener::MountPrewarmer::idle, &app, &QApplication::quit,
+                     Qt::QueuedConnection);
+    return app.exec();
+}
+
 /// Run the configuration GUI mode
 int runConfigMode(QApplication& app)
 {
@@ -69,6 +564,13 @@ int runConfigMode(QApplication& app)
 
 int main(int argc, char* argv[])
 {
+    // Later clicks hand their URLs to a resident instance and exit at once, before QtWidgets
+    // and the platform integration are set up
+    if (uncopener::ResidentServer::forwardArguments(argc, argv))
+    {
+        return 0;
+    }
+
     QApplication app(argc, argv);
     app.setStyle("Fusion");
     app.setApplicationName("UncOpener");
@@ -80,10 +582,64 @@ int main(int argc, char* argv[])
 
     QStringList args = app.arguments();
 
-    // If called with exactly one argument (besides the program name), it's a URL to handle
-    if (args.size() == 2)
+    // Error dialog requested by the minimal uncopener-handler binary
+    if (args.size() == 5 && args.at(1) == SHOW_ERROR_OPTION)
+    {
+        ErrorDialog dialog(args.at(2), args.at(3), args.at(4));
+        dialog.exec();
+        return 1;
+    }
+
+    // Start the resident instance explicitly (e.g. from session autostart)
+    if (args.size() == 2 && args.at(1) == RESIDENT_OPTION)
+    {
+        uncopener::Config config;
+        uncopener::ConfigCache::load(config);
+        return runResidentMode(app, config, {});
+    }
+
+    // Mount the most used shares, e.g. from session autostart without a resident instance
+    if (args.size() == 2 && args.at(1) == PREWARM_OPTION)
+    {
+        return runPrewarmMode(app);
+    }
+
+    // Started by the browser as native messaging host of the UncClickable extension
+    if ((args.size() == 2 && args.at(1) == NATIVE_MESSAGING_OPTION) ||
+        uncopener::NativeMessagingHost::isHostInvocation(args))
+    {
+        return runNativeMessagingHost();
+    }
+
+#ifdef UNCOPENER_HAS_DBUS
+    // Started by the session bus for the DBusActivatable handler
+    if (args.size() == 2 && args.at(1) == DBUS_SERVICE_OPTION)
+    {
+        return runDBusService(app);
+    }
+#endif
+
+    // Newline-delimited URLs on stdin, e.g. from a document portal opening many locations
+    if (args.size() == 2 && args.at(1) == STDIN_OPTION)
+    {
+        QStringList urls = readUrlsFromStdin();
+        if (urls.isEmpty() ||
+            uncopener::ResidentServer::forward(uncopener::ResidentServer::defaultServerName(),
+                                               urls))
+        {
+            return 0;
+        }
+        return runHandlerMode(app, urls);
+    }
+
+    // A single argument (besides the program name) is a URL to handle; several arguments
+    // form a batch as long as none of them is an option
+    QStringList urls = args.mid(1);
+    bool onlyUrls = std::none_of(urls.cbegin(), urls.cend(),
+                                 [](const QString& arg) { return arg.startsWith("--"); });
+    if (args.size() == 2 || (args.size() > 2 && onlyUrls))
     {
-        return runHandlerMode(app, args.at(1));
+        return runHandlerMode(app, urls);
     }
 
     // Otherwise, run the configuration GUI
@@ -0,0 +1,211 @@
+#include "Config.hpp"
+#include "ConfigCache.hpp"
+#include "DecisionFilter.hpp"
+#include "PolicyReplay.hpp"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QHash>
+
+#include <cstdio>
+
+// Headless tools that apply the handler's URL contract and security policy to URL lists.
+// Nothing is opened and no GUI library is loaded.
+
+namespace
+{
+
+const QString FILTER_COMMAND = "filter";
+const QString REPLAY_COMMAND = "replay";
+const QString CONFIG_OPTION = "--config";
+const QString FORMAT_OPTION = "--format";
+const QString BEFORE_OPTION = "--before";
+const QString AFTER_OPTION = "--after";
+const QString THREADS_OPTION = "--threads";
+
+/// Exit code for invalid command lines and unreadable inputs
+constexpr int USAGE_ERROR = 2;
+
+int printUsage()
+{
+    std::fputs("Usage:\n"
+               "  uncopener-cli filter [--config <file>] [--format json|tsv]\n"
+               "      Read URLs line by line from stdin and write one decision per line\n"
+               "      to stdout. Uses the user configuration unless --config is given.\n"
+               "  uncopener-cli replay --before <file> --after <file> [--format json|tsv]\n"
+               "                       [--threads <count>]\n"
+               "      Read URLs line by line from stdin and write the URLs whose verdict\n"
+               "      differs between the two configurations. Exits with 1 if any does.\n",
+               stderr);
+    return USAGE_ERROR;
+}
+
+int printError(const QString& message)
+{
+    std::fputs(qPrintable("uncopener-cli: " + message + "\n"), stderr);
+    return USAGE_ERROR;
+}
+
+/// Parse "--name value" pairs; returns false for unknown or incomplete options
+bool parseOptions(const QStringList& args, const QStringList& known,
+                  QHash<QString, QString>& options)
+{
+    for (qsizetype i = 0; i < args.size(); i += 2)
+    {
+        if (!known.contains(args.at(i)) || i + 1 == args.size())
+        {
+            return false;
+        }
+        options.insert(args.at(i), args.at(i + 1));
+    }
+    return true;
+}
+
+/// Parse the value of the format option; json if not given
+bool parseFormat(const QString& value, uncopener::DecisionFilter::Format& format)
+{
+    if (value.isEmpty() || value == "json")
+    {
+        format = uncopener::DecisionFilter::Format::Json;
+        return true;
+    }
+    if (value == "tsv")
+    {
+        format = uncopener::DecisionFilter::Format::Tsv;
+        return true;
+    }
+    return false;
+}
+
+/// Load the given config file, or the user configuration if path is empty
+bool loadConfig(const QString& path, uncopener::Config& config)
+{
+    if (path.isEmpty())
+    {
+        // A missing user configuration means defaults, like in the handler
+        uncopener::ConfigCache::load(config);
+        return true;
+    }
+    return config.loadFrom(path);
+}
+
+/// Open stdin and stdout as devices
+bool openStdio(QFile& input, QFile& output)
+{
+    return input.open(stdin, QIODevice::ReadOnly) &&
+           output.open(stdout, QIODevice::WriteOnly | QIODevice::Unbuffered);
+}
+
+/// Validate URLs from stdin without opening them
+int runFilter(const QStringList& args)
+{
+    QHash<QString, QString> options;
+    if (!parseOptions(args, {CONFIG_OPTION, FORMAT_OPTION}, options))
+    {
+        return printUsage();
+    }
+
+    uncopener::DecisionFilter::Format format{};
+    if (!parseFormat(options.value(FORMAT_OPTION), format))
+    {
+        return printError(QString("Unknown format \"%1\"").arg(options.value(FORMAT_OPTION)));
+    }
+
+    uncopener::Config config;
+    QString configPath = options.value(CONFIG_OPTION);
+    if (!loadConfig(configPath, config))
+    {
+        return printError(QString("Cannot load config file \"%1\"").arg(configPath));
+    }
+
+    QFile input;
+    QFile output;
+    if (!openStdio(input, output))
+    {
+        return printError("Cannot open stdin or stdout");
+    }
+
+    uncopener::DecisionFilter filter(config);
+    filter.run(input, output, format);
+    return 0;
+}
+
+/// Compare the verdicts of two configurations over URLs from stdin
+int runReplay(const QStringList& args)
+{
+    QHash<QString, QString> options;
+    if (!parseOptions(args, {BEFORE_OPTION, AFTER_OPTION, FORMAT_OPTION, THREADS_OPTION},
+                      options) ||
+        !options.contains(BEFORE_OPTION) || !options.contains(AFTER_OPTION))
+    {
+        return printUsage();
+    }
+
+    uncopener::DecisionFilter::Format format{};
+    if (!parseFormat(options.value(FORMAT_OPTION), format))
+    {
+        return printError(QString("Unknown format \"%1\"").arg(options.value(FORMAT_OPTION)));
+    }
+
+    int threadCount = 0;
+    if (options.contains(THREADS_OPTION))
+    {
+        bool ok = false;
+        threadCount = options.value(THREADS_OPTION).toInt(&ok);
+        if (!ok || threadCount < 1)
+        {
+            return printError("The thread count must be a positive number");
+        }
+    }
+
+    uncopener::Config before;
+    if (!before.loadFrom(options.value(BEFORE_OPTION)))
+    {
+        return printError(
+            QString("Cannot load config file \"%1\"").arg(options.value(BEFORE_OPTION)));
+    }
+
+    uncopener::Config after;
+    if (!after.loadFrom(options.value(AFTER_OPTION)))
+    {
+        return printError(
+            QString("Cannot load config file \"%1\"").arg(options.value(AFTER_OPTION)));
+    }
+
+    QFile input;
+    QFile output;
+    if (!openStdio(input, output))
+    {
+        return printError("Cannot open stdin or stdout");
+    }
+
+    uncopener::PolicyReplay replay(before, after, threadCount);
+    uncopener::ReplayStats stats = replay.run(input, output, format);
+    std::fputs(qPrintable(QString("%1 of %2 URLs change verdict\n")
+                              .arg(stats.changedCount)
+                              .arg(stats.lineCount)),
+               stderr);
+    return stats.changedCount > 0 ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("UncOpener");
+    app.setApplicationVersion("1.0");
+    app.setOrganizationName("bebuch");
+
+    QStringList args = app.arguments();
+    if (args.size() >= 2 && args.at(1) == FILTER_COMMAND)
+    {
+        return runFilter(args.mid(2));
+    }
+    if (args.size() >= 2 && args.at(1) == REPLAY_COMMAND)
+    {
+        return runReplay(args.mid(2));
+    }
+
+    return printUsage();
+}
@@ -0,0 +1,288 @@
+#include "AsyncOpener.hpp"
+
+#include "OpenerBackend.hpp"
+#include "ReachabilityProbe.hpp"
+
+#include <QFutureWatcher>
+#include <QPromise>
+#include <QTimer>
+
+#include <atomic>
+#include <utility>
+
+namespace uncopener
+{
+
+/// One open request, shared between the owner thread and a worker
+/// Whoever settles it first (worker, deadline or cancellation) decides the result
+struct AsyncOpener::Request
+{
+    QString server;
+    QString targetUrl;
+    QStringList selection; // Targets to reveal instead of opening targetUrl
+    QPromise<OpenResult> promise;
+    std::atomic<bool> settled{false};
+
+    void settle(const OpenResult& result)
+    {
+        if (settled.exchange(true))
+        {
+            return;
+        }
+        // A canceled promise drops the result, so the future stays without one
+        promise.addResult(result);
+        promise.finish();
+    }
+};
+
+namespace
+{
+
+OpenResult timeoutError()
+{
+    return OpenResult::error(
+        "Opening the path timed out",
+        "The server did not respond in time. Make sure it is reachable from this computer "
+        "and try again.");
+}
+
+OpenResult queueFullError()
+{
+    return OpenResult::error("Too many paths are being opened",
+                             "Wait for the pending paths to open and try again.");
+}
+
+/// Open targets in turn until one fails
+OpenResult openEach(const AsyncOpener::OpenFunction& open, const QStringList& targetUrls)
+{
+    for (const QString& targetUrl : targetUrls)
+    {
+        OpenResult result = open(targetUrl);
+        if (!result.success)
+        {
+            return result;
+        }
+    }
+    return OpenResult::ok();
+}
+
+/// Open one target, or reveal the selection if there is one
+OpenResult openOrReveal(const AsyncOpener::OpenFunction& open,
+                        const AsyncOpener::RevealFunction& reveal, const QString& targetUrl,
+                        const QStringList& selection)
+{
+    if (selection.isEmpty())
+    {
+        return open(targetUrl);
+    }
+    return reveal ? reveal(selection) : openEach(open, selection);
+}
+
+QFuture<OpenResult> readyFuture(const OpenResult& result)
+{
+    QPromise<OpenResult> promise;
+    QFuture<OpenResult> future = promise.future();
+    promise.start();
+    promise.addResult(result);
+    promise.finish();
+    return future;
+}
+
+} // namespace
+
+AsyncOpener::AsyncOpener(int timeoutMs, QObject* parent)
+    : AsyncOpener(&PathOpener::openTarget, DEFAULT_MAX_WORKERS, timeoutMs, parent)
+{
+    // QDesktopServices is not thread-safe
+    m_openOnWorkers = false;
+}
+
+AsyncOpener::AsyncOpener(OpenFunction open, int maxWorkers, int timeoutMs, QObject* parent)
+    : QObject(parent), m_open(std::move(open)), m_pool(std::make_unique<QThreadPool>()),
+      m_timeoutMs(timeoutMs)
+{
+    m_pool->setMaxThreadCount(maxWorkers);
+}
+
+AsyncOpener::~AsyncOpener()
+{
+    cancelPending();
+
+    // Workers only hold shared state, so a pool with a call still stuck is left to it
+    if (!m_pool->waitForDone(SHUTDOWN_TIMEOUT_MS))
+    {
+        static_cast<void>(m_pool.release());
+    }
+}
+
+QFuture<OpenResult> AsyncOpener::open(const ValidationResult& validation)
+{
+    if (!validation.allowed())
+    {
+        return readyFuture(validation.toOpenResult());
+    }
+    if (validation.reveal)
+    {
+        return revealTargets(validation.path().server, {validation.targetUrl});
+    }
+    return openTarget(validation.path().server, validation.targetUrl);
+}
+
+QFuture<OpenResult> AsyncOpener::openTarget(const QString& server, const QString& targetUrl)
+{
+    return enqueue(server, targetUrl, {});
+}
+
+QFuture<OpenResult> AsyncOpener::revealTargets(const QString& server,
+                                               const QStringList& targetUrls)
+{
+    if (targetUrls.isEmpty())
+    {
+        return readyFuture(OpenResult::ok());
+    }
+    return enqueue(server, targetUrls.first(), targetUrls);
+}
+
+QFuture<OpenResult> AsyncOpener::enqueue(const QString& server, const QString& targetUrl,
+                                         const QStringList& selection)
+{
+    if (m_pending.size() >= MAX_PENDING)
+    {
+        return readyFuture(queueFullError());
+    }
+
+    auto request = std::make_shared<Request>();
+    request->server = server.toCaseFolded();
+    request->targetUrl = targetUrl;
+    request->selection = selection;
+    QFuture<OpenResult> future = request->promise.future();
+    request->promise.start();
+
+    if (m_timeoutMs > 0)
+    {
+        QTimer::singleShot(m_timeoutMs, this,
+                           [this, request]()
+                           {
+                               request->settle(timeoutError());
+                               m_pending.removeOne(request);
+                           });
+    }
+
+    m_pending.append(request);
+    dispatch();
+    return future;
+}
+
+void AsyncOpener::setBackend(const std::shared_ptr<OpenerBackend>& backend)
+{
+    if (!backend)
+    {
+        m_open = &PathOpener::openTarget;
+        m_openOnWorkers = false;
+        return;
+    }
+    m_open = [backend](const QString& targetUrl) { return backend->open(targetUrl); };
+    m_openOnWorkers = backend->isThreadSafe();
+}
+
+void AsyncOpener::setRevealBackend(const std::shared_ptr<OpenerBackend>& backend)
+{
+    if (!backend)
+    {
+        m_reveal = nullptr;
+        m_revealOnWorkers = true;
+        return;
+    }
+    m_reveal = [backend](const QStringList& targetUrls) { return backend->reveal(targetUrls); };
+    m_revealOnWorkers = backend->isThreadSafe();
+}
+
+void AsyncOpener::cancelPending()
+{
+    for (const std::shared_ptr<Request>& request : std::as_const(m_pending))
+    {
+        request->promise.future().cancel();
+        request->settle({});
+    }
+    m_pending.clear();
+}
+
+void AsyncOpener::dispatch()
+{
+    auto it = m_pending.begin();
+    while (it != m_pending.end() && m_running < m_pool->maxThreadCount())
+    {
+        std::shared_ptr<Request> request = *it;
+
+        // Canceled by the caller or past the deadline while waiting
+        if (request->promise.isCanceled() || request->settled)
+        {
+            request->settle({});
+            it = m_pending.erase(it);
+            continue;
+        }
+
+        if (m_busyServers.contains(request->server))
+        {
+            ++it;
+            continue;
+        }
+
+        it = m_pending.erase(it);
+        start(request);
+    }
+}
+
+void AsyncOpener::start(const std::shared_ptr<Request>& request)
+{
+    ++m_running;
+    m_busyServers.insert(request->server);
+
+    // A call that is not thread-safe is made here once the worker has probed the server; a
+    // request that missed its deadline meanwhile is not opened anymore
+    const bool revealing = !request->selection.isEmpty() && m_reveal;
+    const bool onWorker = revealing ? m_revealOnWorkers : m_openOnWorkers;
+
+    // The worker only touches the request, so it never outlives what it uses; the server is
+    // released once the call returns, even if the request timed out long before
+    auto done = std::make_shared<QPromise<OpenResult>>();
+    auto* watcher = new QFutureWatcher<OpenResult>(this);
+    connect(watcher, &QFutureWatcher<OpenResult>::finished, this,
+            [this, watcher, request, onWorker, open = m_open, reveal = m_reveal]()
+            {
+                if (!onWorker && !request->settled)
+                {
+                    OpenResult result = watcher->result();
+                    if (result.success)
+                    {
+                        result = openOrReveal(open, reveal, request->targetUrl, request->selection);
+                    }
+                    request->settle(result);
+                }
+                --m_running;
+                m_busyServers.remove(request->server);
+                watcher->deleteLater();
+                dispatch();
+            });
+    watcher->setFuture(done->future());
+    done->start();
+
+    m_pool->start(
+        [open = m_open, reveal = m_reveal, probe = m_probe, request, done, onWorker]()
+        {
+            OpenResult result = probe ? probe->preflight(request->server, request->targetUrl)
+                                      : OpenResult::ok();
+            if (onWorker)
+            {
+                if (result.success)
+                {
+                    result = openOrReveal(open, reveal, request->targetUrl, request->selection);
+                }
+                request->settle(result);
+            }
+            done->addResult(result);
+            done->finish();
+        });
+}
+
+} // namespace uncopener
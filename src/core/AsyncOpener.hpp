@@ -0,0 +1,133 @@
+#ifndef UNCOPENER_ASYNCOPENER_HPP
+#define UNCOPENER_ASYNCOPENER_HPP
+
+#include "PathOpener.hpp"
+
+#include <QFuture>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace uncopener
+{
+
+/// Opens validated targets on a bounded worker pool, so a stalled server cannot block the caller
+/// Requests for one server run one after another, requests for different servers in parallel.
+/// Every request has a deadline counted from open(); a request that misses it yields a timeout
+/// error, whether it still waits in the queue or is stuck in the system call. The call itself
+/// cannot be interrupted, so a hung server keeps its worker (and its own later requests) busy
+/// until the call returns; the other servers keep the remaining workers.
+/// QDesktopServices and backends that are not thread-safe are called on the thread the opener
+/// lives in: the worker only probes the server, and the target opens once the probe succeeded.
+/// Use from the thread the opener lives in; that thread needs a running event loop.
+class AsyncOpener : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Opens one target on a worker thread, see PathOpener::openTarget()
+    using OpenFunction = std::function<OpenResult(const QString& targetUrl)>;
+
+    /// Shows targets of one folder selected on a worker thread, see PathOpener::reveal()
+    using RevealFunction = std::function<OpenResult(const QStringList& targetUrls)>;
+
+    /// Default number of worker threads
+    static constexpr int DEFAULT_MAX_WORKERS = 4;
+
+    /// Maximum number of queued requests; further requests fail at once
+    static constexpr int MAX_PENDING = 256;
+
+    /// Longest time the destructor waits for calls still running on the workers
+    static constexpr int SHUTDOWN_TIMEOUT_MS = 2000;
+
+    explicit AsyncOpener(int timeoutMs = Config::DEFAULT_OPEN_TIMEOUT_MS,
+                         QObject* parent = nullptr);
+
+    /// Open with a custom function instead of PathOpener::openTarget()
+    /// The function is called on the workers, so it must be thread-safe.
+    AsyncOpener(OpenFunction open, int maxWorkers, int timeoutMs, QObject* parent = nullptr);
+
+    /// Waits up to SHUTDOWN_TIMEOUT_MS for calls still running on the workers
+    /// Calls stuck on a hung server after that are abandoned, so they cannot block the exit.
+    ~AsyncOpener() override;
+
+    AsyncOpener(const AsyncOpener&) = delete;
+    AsyncOpener& operator=(const AsyncOpener&) = delete;
+    AsyncOpener(AsyncOpener&&) = delete;
+    AsyncOpener& operator=(AsyncOpener&&) = delete;
+
+    /// Open the target of a validation result, or reveal it if the result says so
+    /// A URL that is not allowed yields its error at once without using a worker. Cancel the
+    /// future to drop a request that has not started yet; the future then has no result.
+    [[nodiscard]] QFuture<OpenResult> open(const ValidationResult& validation);
+
+    /// Open a target built by PathOpener::buildTargetUrl() for a path on the given server
+    [[nodiscard]] QFuture<OpenResult> openTarget(const QString& server, const QString& targetUrl);
+
+    /// Show targets of files in one folder on the given server selected in the file manager
+    /// Without a reveal backend, the targets are opened in turn like other targets.
+    [[nodiscard]] QFuture<OpenResult> revealTargets(const QString& server,
+                                                    const QStringList& targetUrls);
+
+    /// Open new requests through a backend (nullptr restores QDesktopServices)
+    /// Requests already running keep their backend.
+    void setBackend(const std::shared_ptr<OpenerBackend>& backend);
+
+    /// Show new reveal requests through a backend (nullptr opens their targets in turn)
+    void setRevealBackend(const std::shared_ptr<OpenerBackend>& backend);
+
+    /// Probe the server on the worker before a network target is opened (nullptr disables it)
+    /// A server that is down then fails within the probe timeout instead of the open timeout.
+    void setReachabilityProbe(std::shared_ptr<ReachabilityProbe> probe)
+    {
+        m_probe = std::move(probe);
+    }
+
+    /// Cancel all requests that have not started yet
+    void cancelPending();
+
+    /// Get/set the deadline of new requests in milliseconds (0 disables it)
+    [[nodiscard]] int timeout() const { return m_timeoutMs; }
+    void setTimeout(int timeoutMs) { m_timeoutMs = timeoutMs; }
+
+    /// Get the number of requests waiting for a worker
+    [[nodiscard]] qsizetype pendingCount() const { return m_pending.size(); }
+
+    /// Get the number of calls running on the workers, including timed out ones
+    [[nodiscard]] int runningCount() const { return m_running; }
+
+private:
+    struct Request;
+
+    /// Queue a request to open one target, or to reveal several if selection is not empty
+    [[nodiscard]] QFuture<OpenResult> enqueue(const QString& server, const QString& targetUrl,
+                                              const QStringList& selection);
+
+    /// Start queued requests while workers are free, skipping servers with a running call
+    void dispatch();
+
+    /// Run one request on a worker
+    void start(const std::shared_ptr<Request>& request);
+
+    OpenFunction m_open;
+    RevealFunction m_reveal;
+    bool m_openOnWorkers = true;   // m_open is thread-safe
+    bool m_revealOnWorkers = true; // m_reveal is thread-safe
+    std::shared_ptr<ReachabilityProbe> m_probe;
+    std::unique_ptr<QThreadPool> m_pool; // Abandoned by the destructor if a call hangs
+    int m_timeoutMs;
+    int m_running = 0;
+    QList<std::shared_ptr<Request>> m_pending;
+    QSet<QString> m_busyServers; // Case-folded servers with a running call
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_ASYNCOPENER_HPP
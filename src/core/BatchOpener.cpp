@@ -0,0 +1,165 @@
+#include "BatchOpener.hpp"
+
+#include <QHash>
+#include <QIODevice>
+#include <QSet>
+
+#include <algorithm>
+#include <utility>
+
+namespace uncopener
+{
+
+BatchOpener::BatchOpener(const Config& config) : m_opener(config) {}
+
+BatchOpener::BatchOpener(std::shared_ptr<const CompiledPolicy> policy)
+    : m_opener(std::move(policy))
+{
+}
+
+BatchOpener::BatchOpener(const PathOpener& opener) : m_opener(opener.policy())
+{
+    m_opener.setBackend(opener.backend());
+    m_opener.setRevealBackend(opener.revealBackend());
+    m_opener.setMountIndex(opener.mountIndex());
+    m_opener.setReachabilityProbe(opener.reachabilityProbe());
+    m_opener.setShareHistory(opener.shareHistory());
+}
+
+BatchResult BatchOpener::openAll(const QStringList& urls)
+{
+    // Validate everything before opening anything
+    BatchResult result;
+    const QList<BatchTarget> targets = prepare(urls, result);
+
+    const QList<QList<qsizetype>> groups = groupTargets(targets);
+    for (const QList<qsizetype>& group : groups)
+    {
+        // The files of one group share their folder and thus their server
+        const BatchTarget& first = targets.at(group.first());
+        OpenResult opened = m_opener.preflight(first.server, first.targetUrl);
+        if (opened.success && first.reveal)
+        {
+            QStringList targetUrls;
+            for (qsizetype index : group)
+            {
+                targetUrls.append(targets.at(index).targetUrl);
+            }
+            opened = m_opener.reveal(targetUrls);
+        }
+        else if (opened.success)
+        {
+            opened = m_opener.launch(first.targetUrl);
+        }
+
+        for (qsizetype index : group)
+        {
+            const BatchTarget& target = targets.at(index);
+            if (!opened.success)
+            {
+                result.failures.append(
+                    {target.url, target.displayPath, opened.errorReason, opened.errorRemediation});
+                continue;
+            }
+            m_opener.recordOpen(target.path);
+            ++result.openedCount;
+        }
+    }
+
+    return result;
+}
+
+QList<BatchTarget> BatchOpener::prepare(const QStringList& urls, BatchResult& result) const
+{
+    QList<BatchTarget> targets;
+    QSet<QString> seenTargets;
+    for (const QString& url : urls.first(std::min<qsizetype>(urls.size(), MAX_URLS)))
+    {
+        ValidationResult validation = m_opener.evaluate(url);
+        if (!validation.allowed())
+        {
+            OpenResult error = validation.toOpenResult();
+            result.failures.append(
+                {url, validation.displayPath(), error.errorReason, error.errorRemediation});
+            continue;
+        }
+
+        // UNC and SMB paths are case-insensitive, so compare targets case-folded
+        QString targetUrl = m_opener.resolveTarget(validation);
+        QString key = targetUrl.toCaseFolded();
+        if (seenTargets.contains(key))
+        {
+            ++result.duplicateCount;
+            continue;
+        }
+        seenTargets.insert(key);
+        targets.append({url, validation.displayPath(), targetUrl, validation.path().server,
+                        validation.reveal, validation.path()});
+    }
+
+    // The rest of an oversized batch is reported once, not dropped silently
+    if (urls.size() > MAX_URLS)
+    {
+        const QString& firstSkipped = urls.at(MAX_URLS);
+        result.failures.append(
+            {firstSkipped, firstSkipped, "Too many URLs in one batch",
+             QString("Only the first %1 URLs were opened. Open the others separately.")
+                 .arg(MAX_URLS)});
+    }
+    return targets;
+}
+
+QList<QList<qsizetype>> BatchOpener::groupTargets(const QList<BatchTarget>& targets)
+{
+    QList<QList<qsizetype>> groups;
+    QHash<QString, qsizetype> revealGroups; // Case-folded folder -> index in groups
+    for (qsizetype i = 0; i < targets.size(); ++i)
+    {
+        const BatchTarget& target = targets.at(i);
+        if (!target.reveal)
+        {
+            groups.append(QList<qsizetype>{i});
+            continue;
+        }
+
+        QString folder = folderOf(target.targetUrl).toCaseFolded();
+        auto it = revealGroups.constFind(folder);
+        if (it != revealGroups.constEnd())
+        {
+            groups[it.value()].append(i);
+            continue;
+        }
+        revealGroups.insert(folder, groups.size());
+        groups.append(QList<qsizetype>{i});
+    }
+    return groups;
+}
+
+QString BatchOpener::folderOf(const QString& targetUrl)
+{
+    // UNC targets on Windows, URLs elsewhere
+    qsizetype separator = std::max(targetUrl.lastIndexOf('/'), targetUrl.lastIndexOf('\\'));
+    return targetUrl.left(separator + 1);
+}
+
+QStringList BatchOpener::readUrls(QIODevice& device)
+{
+    QStringList urls;
+    while (urls.size() <= MAX_URLS)
+    {
+        QByteArray line = device.readLine();
+        if (line.isEmpty())
+        {
+            break;
+        }
+
+        QString url = QString::fromUtf8(line).trimmed();
+        if (!url.isEmpty())
+        {
+            urls.append(url);
+        }
+    }
+    return urls;
+}
+
+} // namespace uncopener
@@ -0,0 +1,98 @@
+#ifndef UNCOPENER_BATCHOPENER_HPP
+#define UNCOPENER_BATCHOPENER_HPP
+
+#include "PathOpener.hpp"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <utility>
+
+class QIODevice;
+
+namespace uncopener
+{
+
+/// A URL of a batch that could not be opened
+struct BatchFailure
+{
+    QString url;         // The input URL
+    QString displayPath; // UNC path if the URL parsed, else the URL
+    QString reason;
+    QString remediation;
+};
+
+/// A validated URL of a batch, ready to be opened
+struct BatchTarget
+{
+    QString url;
+    QString displayPath;
+    QString targetUrl;   // Platform-specific target, see PathOpener::buildTargetUrl()
+    QString server;      // Server of the path, e.g. to open one server's paths in order
+    bool reveal = false; // Shown selected in its folder, see ValidationResult::reveal
+    UncPath path;        // Counted in the share history once the target opened
+};
+
+/// Outcome of opening a batch of URLs
+struct BatchResult
+{
+    int openedCount = 0;
+    int duplicateCount = 0; // URLs skipped because an earlier URL has the same target
+    QList<BatchFailure> failures;
+
+    [[nodiscard]] bool success() const { return failures.isEmpty(); }
+};
+
+/// Opens many URLs with one loaded policy
+/// All URLs are validated first; URLs resolving to the same target are opened once. Revealed
+/// files of one folder are shown together, so the folder opens once with all of them selected.
+class BatchOpener
+{
+public:
+    /// Maximum number of URLs of a batch, to bound a runaway producer
+    /// Further URLs are not opened but reported as one failure.
+    static constexpr int MAX_URLS = 1000;
+
+    explicit BatchOpener(const Config& config);
+
+    /// Validate against a shared snapshot instead of compiling the config again
+    explicit BatchOpener(std::shared_ptr<const CompiledPolicy> policy);
+
+    /// Open with the policy snapshot and the collaborators (backends, mount index, probe, share
+    /// history) of an opener
+    explicit BatchOpener(const PathOpener& opener);
+
+    /// Open targets through a backend instead of QDesktopServices, see PathOpener::setBackend()
+    void setBackend(std::shared_ptr<OpenerBackend> backend)
+    {
+        m_opener.setBackend(std::move(backend));
+    }
+
+    /// Validate all URLs, drop duplicate targets, then open the remaining ones in order
+    [[nodiscard]] BatchResult openAll(const QStringList& urls);
+
+    /// Validate all URLs and drop duplicate targets without opening anything
+    /// Validation failures, duplicates and URLs beyond MAX_URLS are recorded in result
+    [[nodiscard]] QList<BatchTarget> prepare(const QStringList& urls, BatchResult& result) const;
+
+    /// Group targets into calls: each revealed folder with all its revealed files, every other
+    /// target on its own; groups are ordered by their first target
+    /// Returns indexes into targets
+    [[nodiscard]] static QList<QList<qsizetype>> groupTargets(const QList<BatchTarget>& targets);
+
+    /// Get the folder of a target, i.e. everything up to and including the last separator
+    [[nodiscard]] static QString folderOf(const QString& targetUrl);
+
+    /// Read newline-delimited URLs; surrounding whitespace and blank lines are ignored
+    /// Reading stops after MAX_URLS + 1 URLs, so prepare() still sees that the batch was cut.
+    [[nodiscard]] static QStringList readUrls(QIODevice& device);
+
+private:
+    PathOpener m_opener;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_BATCHOPENER_HPP
@@ -0,0 +1,165 @@
+#include "CaseFoldedTrie.hpp"
+
+#include <QChar>
+
+namespace uncopener
+{
+
+namespace
+{
+
+/// Feed the case-folded UTF-16 units of text to sink, front to back or back to front
+/// Folding is done per code point, as Qt::CaseInsensitive comparisons do
+/// sink returns false to stop early
+template <typename Sink>
+void forEachFoldedUnit(QStringView text, CaseFoldedTrie::Direction direction, Sink sink)
+{
+    const bool forward = direction == CaseFoldedTrie::Direction::Forward;
+    qsizetype pos = forward ? 0 : text.size();
+
+    while (forward ? pos < text.size() : pos > 0)
+    {
+        char32_t codePoint = 0;
+        if (forward)
+        {
+            codePoint = text[pos].unicode();
+            ++pos;
+            if (QChar::isHighSurrogate(codePoint) && pos < text.size() &&
+                text[pos].isLowSurrogate())
+            {
+                codePoint = QChar::surrogateToUcs4(static_cast<char16_t>(codePoint),
+                                                   text[pos].unicode());
+                ++pos;
+            }
+        }
+        else
+        {
+            --pos;
+            codePoint = text[pos].unicode();
+            if (QChar::isLowSurrogate(codePoint) && pos > 0 && text[pos - 1].isHighSurrogate())
+            {
+                --pos;
+                codePoint = QChar::surrogateToUcs4(text[pos].unicode(),
+                                                   static_cast<char16_t>(codePoint));
+            }
+        }
+
+        char32_t folded = QChar::toCaseFolded(codePoint);
+        if (!QChar::requiresSurrogates(folded))
+        {
+            if (!sink(static_cast<char16_t>(folded)))
+            {
+                return;
+            }
+            continue;
+        }
+
+        // Surrogate pairs are fed in the walking direction as well
+        char16_t first = forward ? QChar::highSurrogate(folded) : QChar::lowSurrogate(folded);
+        char16_t second = forward ? QChar::lowSurrogate(folded) : QChar::highSurrogate(folded);
+        if (!sink(first) || !sink(second))
+        {
+            return;
+        }
+    }
+}
+
+} // namespace
+
+CaseFoldedTrie::CaseFoldedTrie(Direction direction)
+    : m_direction(direction)
+{
+    clear();
+}
+
+void CaseFoldedTrie::clear()
+{
+    m_nodes.clear();
+    m_nodes.emplace_back(); // Root
+    m_keyCount = 0;
+}
+
+void CaseFoldedTrie::insert(QStringView key, qsizetype value)
+{
+    std::uint32_t node = 0;
+    forEachFoldedUnit(key, m_direction,
+                      [this, &node](char16_t unit)
+                      {
+                          node = findOrAddChild(node, unit);
+                          return true;
+                      });
+
+    // The root stands for the empty key, which never matches
+    if (node == 0 || m_nodes[node].value != NO_MATCH)
+    {
+        return;
+    }
+
+    m_nodes[node].value = static_cast<std::int32_t>(value);
+    ++m_keyCount;
+}
+
+qsizetype CaseFoldedTrie::longestMatch(QStringView text) const
+{
+    qsizetype match = NO_MATCH;
+    std::uint32_t node = 0;
+    forEachFoldedUnit(text, m_direction,
+                      [this, &node, &match](char16_t unit)
+                      {
+                          node = findChild(node, unit);
+                          if (node == 0)
+                          {
+                              return false;
+                          }
+                          if (m_nodes[node].value != NO_MATCH)
+                          {
+                              match = m_nodes[node].value;
+                          }
+                          return true;
+                      });
+    return match;
+}
+
+std::uint32_t CaseFoldedTrie::findChild(std::uint32_t parent, char16_t unit) const
+{
+    std::uint32_t child = m_nodes[parent].firstChild;
+    while (child != 0 && m_nodes[child].unit < unit)
+    {
+        child = m_nodes[child].nextSibling;
+    }
+    return child != 0 && m_nodes[child].unit == unit ? child : 0;
+}
+
+std::uint32_t CaseFoldedTrie::findOrAddChild(std::uint32_t parent, char16_t unit)
+{
+    std::uint32_t previous = 0;
+    std::uint32_t child = m_nodes[parent].firstChild;
+    while (child != 0 && m_nodes[child].unit < unit)
+    {
+        previous = child;
+        child = m_nodes[child].nextSibling;
+    }
+    if (child != 0 && m_nodes[child].unit == unit)
+    {
+        return child;
+    }
+
+    // Link the new node in sorted position; indices stay valid when the vector grows
+    auto index = static_cast<std::uint32_t>(m_nodes.size());
+    Node node;
+    node.unit = unit;
+    node.nextSibling = child;
+    m_nodes.push_back(node);
+
+    if (previous == 0)
+    {
+        m_nodes[parent].firstChild = index;
+    }
+    else
+    {
+        m_nodes[previous].nextSibling = index;
+    }
+    return index;
+}
+
+} // namespace uncopener
@@ -0,0 +1,70 @@
+#ifndef UNCOPENER_CASEFOLDEDTRIE_HPP
+#define UNCOPENER_CASEFOLDEDTRIE_HPP
+
+#include <QStringView>
+
+#include <cstdint>
+#include <vector>
+
+namespace uncopener
+{
+
+/// Trie over case-folded UTF-16 code units
+/// Keys match case-insensitively with the same folding as Qt::CaseInsensitive. A lookup walks
+/// the text once, so it costs O(text length) independent of the number of keys.
+class CaseFoldedTrie
+{
+public:
+    /// Which end of the text keys are anchored at
+    enum class Direction : std::uint8_t
+    {
+        Forward, // Keys match as prefixes
+        Backward // Keys match as suffixes
+    };
+
+    /// Returned by lookups if no key matches
+    static constexpr qsizetype NO_MATCH = -1;
+
+    explicit CaseFoldedTrie(Direction direction = Direction::Forward);
+
+    /// Get the direction keys are matched in
+    [[nodiscard]] Direction direction() const { return m_direction; }
+
+    /// Remove all keys
+    void clear();
+
+    /// Check if no key was inserted
+    [[nodiscard]] bool isEmpty() const { return m_keyCount == 0; }
+
+    /// Get the number of distinct keys
+    [[nodiscard]] qsizetype keyCount() const { return m_keyCount; }
+
+    /// Insert a key with the value lookups return for it (e.g. an index into a list)
+    /// If the key is already present (case-insensitively), the first value is kept
+    void insert(QStringView key, qsizetype value);
+
+    /// Get the value of the longest key that is a prefix (Forward) or suffix (Backward) of text
+    /// Returns NO_MATCH if no key matches
+    [[nodiscard]] qsizetype longestMatch(QStringView text) const;
+
+private:
+    /// Children form a sibling list sorted by unit; index 0 (the root) doubles as "none"
+    struct Node
+    {
+        char16_t unit = 0;
+        std::int32_t value = static_cast<std::int32_t>(NO_MATCH);
+        std::uint32_t firstChild = 0;
+        std::uint32_t nextSibling = 0;
+    };
+
+    [[nodiscard]] std::uint32_t findChild(std::uint32_t parent, char16_t unit) const;
+    [[nodiscard]] std::uint32_t findOrAddChild(std::uint32_t parent, char16_t unit);
+
+    Direction m_direction;
+    std::vector<Node> m_nodes;
+    qsizetype m_keyCount = 0;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_CASEFOLDEDTRIE_HPP
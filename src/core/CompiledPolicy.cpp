@@ -0,0 +1,53 @@
+#include "CompiledPolicy.hpp"
+
+namespace uncopener
+{
+
+CompiledPolicy::CompiledPolicy(const Config& config, quint64 generation)
+    : m_config(config), m_parser(config.schemeName()), m_generation(generation)
+{
+    config.applyTo(m_policy);
+    static_cast<void>(m_reveal.setWhitelist(config.revealFiletypes()));
+    static_cast<void>(m_aliases.setAliases(config.serverAliases()));
+    static_cast<void>(m_translator.setRules(config.pathTranslations()));
+}
+
+ParseResult CompiledPolicy::parse(const QString& url) const
+{
+    ParseResult result = m_parser.parse(url);
+    m_aliases.canonicalize(result);
+    return result;
+}
+
+UrlVerdict CompiledPolicy::decide(QStringView url) const
+{
+    UrlVerdict verdict;
+    verdict.parseError = m_parser.parse(url, verdict.path);
+    if (verdict.parseError)
+    {
+        return verdict;
+    }
+
+    // Aliases are resolved first, so the policy only sees canonical names
+    m_aliases.canonicalize(verdict.path);
+    verdict.policy = m_policy.decide(verdict.path.toUncString());
+    return verdict;
+}
+
+bool CompiledPolicy::reveals(const UncPath& path) const
+{
+    if (path.hasTrailingSlash)
+    {
+        return false;
+    }
+    QStringView filename = QStringView(path.path).mid(path.path.lastIndexOf('\\') + 1);
+    return !filename.isEmpty() && m_reveal.matchIndex(filename) != CaseFoldedTrie::NO_MATCH;
+}
+
+std::shared_ptr<const CompiledPolicy> CompiledPolicy::compile(const Config& config,
+                                                              quint64 generation)
+{
+    return std::make_shared<const CompiledPolicy>(config, generation);
+}
+
+} // namespace uncopener
@@ -0,0 +1,83 @@
+#ifndef UNCOPENER_COMPILEDPOLICY_HPP
+#define UNCOPENER_COMPILEDPOLICY_HPP
+
+#include "Config.hpp"
+#include "PathTranslator.hpp"
+#include "SecurityPolicy.hpp"
+#include "ServerAliases.hpp"
+#include "UrlParser.hpp"
+
+#include <QStringView>
+#include <QtGlobal>
+
+#include <memory>
+#include <optional>
+
+namespace uncopener
+{
+
+/// Verdict on a URL as stable codes; no human-readable messages are built
+struct UrlVerdict
+{
+    std::optional<ParseError::Code> parseError; // Set if the URL contract rejects the URL
+    UncPath path;                               // Canonical path; only valid if the URL parsed
+    PolicyVerdict policy;                       // Only meaningful if the URL parsed
+
+    [[nodiscard]] bool allowed() const { return !parseError && policy.allowed(); }
+};
+
+/// Immutable snapshot of a Config with its parser and matchers built
+/// Nothing changes after construction, so any number of threads can validate against one
+/// snapshot without locking; a config change builds a new snapshot instead (see PolicyStore)
+class CompiledPolicy
+{
+public:
+    /// Compile a config; the generation tells snapshots of one PolicyStore apart
+    explicit CompiledPolicy(const Config& config, quint64 generation = 0);
+
+    /// Compile a config into a shared snapshot
+    [[nodiscard]] static std::shared_ptr<const CompiledPolicy> compile(const Config& config,
+                                                                       quint64 generation = 0);
+
+    /// Get the config the snapshot was compiled from
+    [[nodiscard]] const Config& config() const { return m_config; }
+
+    /// Get the parser for the configured scheme
+    [[nodiscard]] const UrlParser& parser() const { return m_parser; }
+
+    /// Get the server aliases applied after parsing
+    [[nodiscard]] const ServerAliases& aliases() const { return m_aliases; }
+
+    /// Parse a URL and rewrite the server to its canonical name
+    [[nodiscard]] ParseResult parse(const QString& url) const;
+
+    /// Parse a URL, rewrite the server to its canonical name and check the path with the policy
+    /// PathOpener::evaluate() and DecisionFilter::evaluate() both decide through this
+    [[nodiscard]] UrlVerdict decide(QStringView url) const;
+
+    /// Get the compiled allow-list and filetype policy
+    [[nodiscard]] const SecurityPolicy& policy() const { return m_policy; }
+
+    /// Check if a file is shown selected in its folder instead of opened, by its extension
+    /// Folders (paths with a trailing slash) are never revealed
+    [[nodiscard]] bool reveals(const UncPath& path) const;
+
+    /// Get the compiled path translations
+    [[nodiscard]] const PathTranslator& translator() const { return m_translator; }
+
+    /// Get the generation the snapshot was published with (higher is newer)
+    [[nodiscard]] quint64 generation() const { return m_generation; }
+
+private:
+    Config m_config;
+    UrlParser m_parser;
+    ServerAliases m_aliases;
+    SecurityPolicy m_policy;
+    FiletypePolicy m_reveal; // Whitelist of the reveal filetypes, only used for matching
+    PathTranslator m_translator;
+    quint64 m_generation;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_COMPILEDPOLICY_HPP
@@ -19,10 +19,30 @@ const QString KEY_SMB_USERNAME = "smbUsername";
 const QString KEY_FILETYPE_MODE = "filetypeMode";
 const QString KEY_FILETYPE_WHITELIST = "filetypeWhitelist";
 const QString KEY_FILETYPE_BLACKLIST = "filetypeBlacklist";
+const QString KEY_RESIDENT_MODE = "residentMode";
+const QString KEY_DBUS_ACTIVATION = "dbusActivation";
+const QString KEY_COALESCE_WINDOW_MS = "coalesceWindowMs";
+const QString KEY_RATE_LIMIT_BURST = "rateLimitBurst";
+const QString KEY_RATE_LIMIT_PER_MINUTE = "rateLimitPerMinute";
+const QString KEY_OPEN_TIMEOUT_MS = "openTimeoutMs";
+const QString KEY_OPENER = "opener";
+const QString KEY_OPENER_COMMAND = "openerCommand";
+const QString KEY_REVEAL_FILETYPES = "revealFiletypes";
+const QString KEY_PREFER_LOCAL_MOUNTS = "preferLocalMounts";
+const QString KEY_PROBE_SERVERS = "probeServers";
+const QString KEY_PROBE_TIMEOUT_MS = "probeTimeoutMs";
+const QString KEY_PREWARM = "prewarm";
+const QString KEY_PREWARM_SHARES = "prewarmShares";
+const QString KEY_PREWARM_COMMAND = "prewarmCommand";
+const QString KEY_PATH_TRANSLATIONS = "pathTranslations";
+const QString KEY_SERVER_ALIASES = "serverAliases";
 
 const QString FILETYPE_MODE_WHITELIST = "whitelist";
 const QString FILETYPE_MODE_BLACKLIST = "blacklist";
 
+/// JSON names of the OpenerKind values, in enum order
+const QStringList OPENER_NAMES = {"desktop", "gio", "xdg-open", "filemanager", "command"};
+
 QStringList jsonArrayToStringList(const QJsonArray& array)
 {
     QStringList result;
@@ -36,6 +56,62 @@ QStringList jsonArrayToStringList(const QJsonArray& array)
     return result;
 }
 
+/// Read a non-negative integer; missing, mistyped and negative values yield the default
+int readNonNegativeInt(const QJsonObject& json, const QString& key, int defaultValue)
+{
+    int value = json.value(key).toInt(-1);
+    return value >= 0 ? value : defaultValue;
+}
+
+/// Read translations from an object of UNC prefixes to local paths
+/// Entries with non-string values are skipped; the order is that of the (sorted) keys
+QList<PathTranslation> jsonObjectToTranslations(const QJsonObject& object)
+{
+    QList<PathTranslation> result;
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it)
+    {
+        if (it.value().isString())
+        {
+            result.append({it.key(), it.value().toString()});
+        }
+    }
+    return result;
+}
+
+QJsonObject translationsToJsonObject(const QList<PathTranslation>& translations)
+{
+    QJsonObject object;
+    for (const PathTranslation& translation : translations)
+    {
+        object[translation.uncPrefix] = translation.localPath;
+    }
+    return object;
+}
+
+/// Read an object of string values; entries with other values are skipped
+QMap<QString, QString> jsonObjectToStringMap(const QJsonObject& object)
+{
+    QMap<QString, QString> result;
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it)
+    {
+        if (it.value().isString())
+        {
+            result.insert(it.key(), it.value().toString());
+        }
+    }
+    return result;
+}
+
+QJsonObject stringMapToJsonObject(const QMap<QString, QString>& map)
+{
+    QJsonObject object;
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it)
+    {
+        object[it.key()] = it.value();
+    }
+    return object;
+}
+
 QJsonArray stringListToJsonArray(const QStringList& list)
 {
     QJsonArray array;
@@ -70,6 +146,23 @@ QJsonObject Config::toJson() const
                                                                           : FILETYPE_MODE_WHITELIST;
     json[KEY_FILETYPE_WHITELIST] = stringListToJsonArray(m_filetypeWhitelist);
     json[KEY_FILETYPE_BLACKLIST] = stringListToJsonArray(m_filetypeBlacklist);
+    json[KEY_RESIDENT_MODE] = m_residentMode;
+    json[KEY_DBUS_ACTIVATION] = m_dbusActivation;
+    json[KEY_COALESCE_WINDOW_MS] = m_coalesceWindowMs;
+    json[KEY_RATE_LIMIT_BURST] = m_rateLimitBurst;
+    json[KEY_RATE_LIMIT_PER_MINUTE] = m_rateLimitPerMinute;
+    json[KEY_OPEN_TIMEOUT_MS] = m_openTimeoutMs;
+    json[KEY_OPENER] = OPENER_NAMES.at(static_cast<qsizetype>(m_opener));
+    json[KEY_OPENER_COMMAND] = m_openerCommand;
+    json[KEY_REVEAL_FILETYPES] = stringListToJsonArray(m_revealFiletypes);
+    json[KEY_PREFER_LOCAL_MOUNTS] = m_preferLocalMounts;
+    json[KEY_PROBE_SERVERS] = m_probeServers;
+    json[KEY_PROBE_TIMEOUT_MS] = m_probeTimeoutMs;
+    json[KEY_PREWARM] = m_prewarm;
+    json[KEY_PREWARM_SHARES] = m_prewarmShares;
+    json[KEY_PREWARM_COMMAND] = m_prewarmCommand;
+    json[KEY_PATH_TRANSLATIONS] = translationsToJsonObject(m_pathTranslations);
+    json[KEY_SERVER_ALIASES] = stringMapToJsonObject(m_serverAliases);
 
     return json;
 }
@@ -143,6 +236,120 @@ bool Config::fromJson(const QJsonObject& json)
         m_filetypeBlacklist.clear();
     }
 
+    // Resident mode (optional, with default)
+    if (json.contains(KEY_RESIDENT_MODE) && json[KEY_RESIDENT_MODE].isBool())
+    {
+        m_residentMode = json[KEY_RESIDENT_MODE].toBool();
+    }
+    else
+    {
+        m_residentMode = DEFAULT_RESIDENT_MODE;
+    }
+
+    // D-Bus activation (optional, with default)
+    if (json.contains(KEY_DBUS_ACTIVATION) && json[KEY_DBUS_ACTIVATION].isBool())
+    {
+        m_dbusActivation = json[KEY_DBUS_ACTIVATION].toBool();
+    }
+    else
+    {
+        m_dbusActivation = DEFAULT_DBUS_ACTIVATION;
+    }
+
+    // Request throttling (optional, with defaults)
+    m_coalesceWindowMs =
+        readNonNegativeInt(json, KEY_COALESCE_WINDOW_MS, DEFAULT_COALESCE_WINDOW_MS);
+    m_rateLimitBurst = readNonNegativeInt(json, KEY_RATE_LIMIT_BURST, DEFAULT_RATE_LIMIT_BURST);
+    m_rateLimitPerMinute =
+        readNonNegativeInt(json, KEY_RATE_LIMIT_PER_MINUTE, DEFAULT_RATE_LIMIT_PER_MINUTE);
+
+    // Open timeout (optional, with default)
+    m_openTimeoutMs = readNonNegativeInt(json, KEY_OPEN_TIMEOUT_MS, DEFAULT_OPEN_TIMEOUT_MS);
+
+    // Opener (optional, with default; unknown names use the default)
+    qsizetype openerIndex = OPENER_NAMES.indexOf(json.value(KEY_OPENER).toString().toLower());
+    m_opener = openerIndex >= 0 ? static_cast<OpenerKind>(openerIndex) : DEFAULT_OPENER;
+
+    // Opener command (optional)
+    if (json.contains(KEY_OPENER_COMMAND) && json[KEY_OPENER_COMMAND].isString())
+    {
+        m_openerCommand = json[KEY_OPENER_COMMAND].toString();
+    }
+    else
+    {
+        m_openerCommand.clear();
+    }
+
+    // Filetypes shown selected in their folder (optional)
+    if (json.contains(KEY_REVEAL_FILETYPES) && json[KEY_REVEAL_FILETYPES].isArray())
+    {
+        m_revealFiletypes = jsonArrayToStringList(json[KEY_REVEAL_FILETYPES].toArray());
+    }
+    else
+    {
+        m_revealFiletypes.clear();
+    }
+
+    // Local mounts (optional, with default)
+    if (json.contains(KEY_PREFER_LOCAL_MOUNTS) && json[KEY_PREFER_LOCAL_MOUNTS].isBool())
+    {
+        m_preferLocalMounts = json[KEY_PREFER_LOCAL_MOUNTS].toBool();
+    }
+    else
+    {
+        m_preferLocalMounts = DEFAULT_PREFER_LOCAL_MOUNTS;
+    }
+
+    // Server probing (optional, with defaults)
+    if (json.contains(KEY_PROBE_SERVERS) && json[KEY_PROBE_SERVERS].isBool())
+    {
+        m_probeServers = json[KEY_PROBE_SERVERS].toBool();
+    }
+    else
+    {
+        m_probeServers = DEFAULT_PROBE_SERVERS;
+    }
+    m_probeTimeoutMs = readNonNegativeInt(json, KEY_PROBE_TIMEOUT_MS, DEFAULT_PROBE_TIMEOUT_MS);
+
+    // Prewarming (optional, with defaults)
+    if (json.contains(KEY_PREWARM) && json[KEY_PREWARM].isBool())
+    {
+        m_prewarm = json[KEY_PREWARM].toBool();
+    }
+    else
+    {
+        m_prewarm = DEFAULT_PREWARM;
+    }
+    m_prewarmShares = readNonNegativeInt(json, KEY_PREWARM_SHARES, DEFAULT_PREWARM_SHARES);
+    if (json.contains(KEY_PREWARM_COMMAND) && json[KEY_PREWARM_COMMAND].isString())
+    {
+        m_prewarmCommand = json[KEY_PREWARM_COMMAND].toString();
+    }
+    else
+    {
+        m_prewarmCommand.clear();
+    }
+
+    // Path translations (optional)
+    if (json.contains(KEY_PATH_TRANSLATIONS) && json[KEY_PATH_TRANSLATIONS].isObject())
+    {
+        m_pathTranslations = jsonObjectToTranslations(json[KEY_PATH_TRANSLATIONS].toObject());
+    }
+    else
+    {
+        m_pathTranslations.clear();
+    }
+
+    // Server aliases (optional)
+    if (json.contains(KEY_SERVER_ALIASES) && json[KEY_SERVER_ALIASES].isObject())
+    {
+        m_serverAliases = jsonObjectToStringMap(json[KEY_SERVER_ALIASES].toObject());
+    }
+    else
+    {
+        m_serverAliases.clear();
+    }
+
     return true;
 }
 
@@ -154,6 +361,23 @@ void Config::reset()
     m_filetypeMode = DEFAULT_FILETYPE_MODE;
     m_filetypeWhitelist.clear();
     m_filetypeBlacklist.clear();
+    m_residentMode = DEFAULT_RESIDENT_MODE;
+    m_dbusActivation = DEFAULT_DBUS_ACTIVATION;
+    m_coalesceWindowMs = DEFAULT_COALESCE_WINDOW_MS;
+    m_rateLimitBurst = DEFAULT_RATE_LIMIT_BURST;
+    m_rateLimitPerMinute = DEFAULT_RATE_LIMIT_PER_MINUTE;
+    m_openTimeoutMs = DEFAULT_OPEN_TIMEOUT_MS;
+    m_opener = DEFAULT_OPENER;
+    m_openerCommand.clear();
+    m_revealFiletypes.clear();
+    m_preferLocalMounts = DEFAULT_PREFER_LOCAL_MOUNTS;
+    m_probeServers = DEFAULT_PROBE_SERVERS;
+    m_probeTimeoutMs = DEFAULT_PROBE_TIMEOUT_MS;
+    m_prewarm = DEFAULT_PREWARM;
+    m_prewarmShares = DEFAULT_PREWARM_SHARES;
+    m_prewarmCommand.clear();
+    m_pathTranslations.clear();
+    m_serverAliases.clear();
 }
 
 QString Config::configDirPath()
@@ -1,15 +1,30 @@
 #ifndef UNCOPENER_CONFIG_HPP
 #define UNCOPENER_CONFIG_HPP
 
+#include "PathTranslator.hpp"
 #include "SecurityPolicy.hpp"
 
 #include <QJsonObject>
+#include <QList>
+#include <QMap>
 #include <QString>
 #include <QStringList>
 
+#include <cstdint>
+
 namespace uncopener
 {
 
+/// Program that opens validated paths, see OpenerBackend
+enum class OpenerKind : std::uint8_t
+{
+    Desktop,     // QDesktopServices, i.e. the platform default
+    Gio,         // gio open (Linux only)
+    XdgOpen,     // xdg-open (Linux only)
+    FileManager, // org.freedesktop.FileManager1 over D-Bus (Linux only)
+    Command,     // The configured opener command
+};
+
 /// Configuration schema for UncOpener
 /// Stores all user settings and handles persistence
 class Config
@@ -21,6 +36,40 @@ public:
     /// Default filetype mode
     static constexpr FiletypeMode DEFAULT_FILETYPE_MODE = FiletypeMode::Whitelist;
 
+    /// Default resident mode (off: every click starts a new process)
+    static constexpr bool DEFAULT_RESIDENT_MODE = false;
+
+    /// Default D-Bus activation (off: the desktop starts a new process per URL)
+    static constexpr bool DEFAULT_DBUS_ACTIVATION = false;
+
+    /// Default window in which repeated requests for the same path are coalesced
+    static constexpr int DEFAULT_COALESCE_WINDOW_MS = 1000;
+
+    /// Default token bucket of each request source: burst size and refill per minute
+    static constexpr int DEFAULT_RATE_LIMIT_BURST = 5;
+    static constexpr int DEFAULT_RATE_LIMIT_PER_MINUTE = 30;
+
+    /// Default time a long-running instance waits for a path to open
+    static constexpr int DEFAULT_OPEN_TIMEOUT_MS = 10000;
+
+    /// Default opener (the platform default via QDesktopServices)
+    static constexpr OpenerKind DEFAULT_OPENER = OpenerKind::Desktop;
+
+    /// Default use of local mounts (on: mounted shares open through their mount point)
+    static constexpr bool DEFAULT_PREFER_LOCAL_MOUNTS = true;
+
+    /// Default server probing (off: targets are opened without checking the server first)
+    static constexpr bool DEFAULT_PROBE_SERVERS = false;
+
+    /// Default time a server probe waits for name resolution and the connection
+    static constexpr int DEFAULT_PROBE_TIMEOUT_MS = 1500;
+
+    /// Default prewarming (off: shares are mounted when they are first opened)
+    static constexpr bool DEFAULT_PREWARM = false;
+
+    /// Default number of most used shares mounted at startup
+    static constexpr int DEFAULT_PREWARM_SHARES = 5;
+
     Config() = default;
 
     /// Get/set the custom URL scheme name
@@ -47,6 +96,79 @@ public:
     [[nodiscard]] QStringList filetypeBlacklist() const { return m_filetypeBlacklist; }
     void setFiletypeBlacklist(const QStringList& list) { m_filetypeBlacklist = list; }
 
+    /// Get/set resident mode (keep running and accept URLs from later invocations)
+    [[nodiscard]] bool residentMode() const { return m_residentMode; }
+    void setResidentMode(bool enabled) { m_residentMode = enabled; }
+
+    /// Get/set D-Bus activation (Linux only: register the handler as DBusActivatable)
+    [[nodiscard]] bool dbusActivation() const { return m_dbusActivation; }
+    void setDBusActivation(bool enabled) { m_dbusActivation = enabled; }
+
+    /// Get/set the coalescing window in milliseconds (0 disables coalescing)
+    [[nodiscard]] int coalesceWindowMs() const { return m_coalesceWindowMs; }
+    void setCoalesceWindowMs(int windowMs) { m_coalesceWindowMs = windowMs; }
+
+    /// Get/set the number of requests a source may send at once (0 disables rate limiting)
+    [[nodiscard]] int rateLimitBurst() const { return m_rateLimitBurst; }
+    void setRateLimitBurst(int burst) { m_rateLimitBurst = burst; }
+
+    /// Get/set the sustained number of requests per minute and source (0 disables rate limiting)
+    [[nodiscard]] int rateLimitPerMinute() const { return m_rateLimitPerMinute; }
+    void setRateLimitPerMinute(int perMinute) { m_rateLimitPerMinute = perMinute; }
+
+    /// Get/set the time to wait for a path to open in milliseconds (0 waits indefinitely)
+    [[nodiscard]] int openTimeoutMs() const { return m_openTimeoutMs; }
+    void setOpenTimeoutMs(int timeoutMs) { m_openTimeoutMs = timeoutMs; }
+
+    /// Get/set the program that opens validated paths
+    [[nodiscard]] OpenerKind opener() const { return m_opener; }
+    void setOpener(OpenerKind opener) { m_opener = opener; }
+
+    /// Get/set the command of OpenerKind::Command, e.g. "nautilus %u"
+    /// %u is replaced by the target; without it the target is appended
+    [[nodiscard]] QString openerCommand() const { return m_openerCommand; }
+    void setOpenerCommand(const QString& command) { m_openerCommand = command; }
+
+    /// Get/set the extensions of files that are shown selected in their folder instead of
+    /// opened, e.g. ".pdf" (org.freedesktop.FileManager1 on Linux only)
+    [[nodiscard]] QStringList revealFiletypes() const { return m_revealFiletypes; }
+    void setRevealFiletypes(const QStringList& list) { m_revealFiletypes = list; }
+
+    /// Get/set local mounts (Linux only: open mounted shares through their mount point)
+    [[nodiscard]] bool preferLocalMounts() const { return m_preferLocalMounts; }
+    void setPreferLocalMounts(bool enabled) { m_preferLocalMounts = enabled; }
+
+    /// Get/set server probing (check that a server is reachable before opening its target)
+    [[nodiscard]] bool probeServers() const { return m_probeServers; }
+    void setProbeServers(bool enabled) { m_probeServers = enabled; }
+
+    /// Get/set the time a server probe may take in milliseconds
+    [[nodiscard]] int probeTimeoutMs() const { return m_probeTimeoutMs; }
+    void setProbeTimeoutMs(int timeoutMs) { m_probeTimeoutMs = timeoutMs; }
+
+    /// Get/set prewarming (record opened shares and mount the most used ones in the background)
+    [[nodiscard]] bool prewarm() const { return m_prewarm; }
+    void setPrewarm(bool enabled) { m_prewarm = enabled; }
+
+    /// Get/set the number of most used shares mounted at startup (0 only serves requests)
+    [[nodiscard]] int prewarmShares() const { return m_prewarmShares; }
+    void setPrewarmShares(int count) { m_prewarmShares = count; }
+
+    /// Get/set the command that mounts a share, e.g. "gio mount %u" (empty: gio mount)
+    [[nodiscard]] QString prewarmCommand() const { return m_prewarmCommand; }
+    void setPrewarmCommand(const QString& command) { m_prewarmCommand = command; }
+
+    /// Get/set the fixed UNC-to-local path translations, applied before local mounts
+    [[nodiscard]] QList<PathTranslation> pathTranslations() const { return m_pathTranslations; }
+    void setPathTranslations(const QList<PathTranslation>& translations)
+    {
+        m_pathTranslations = translations;
+    }
+
+    /// Get/set the server aliases, from alias to canonical server name
+    [[nodiscard]] QMap<QString, QString> serverAliases() const { return m_serverAliases; }
+    void setServerAliases(const QMap<QString, QString>& aliases) { m_serverAliases = aliases; }
+
     /// Apply this config to a SecurityPolicy
     void applyTo(SecurityPolicy& policy) const;
 
@@ -90,6 +212,23 @@ private:
     FiletypeMode m_filetypeMode = DEFAULT_FILETYPE_MODE;
     QStringList m_filetypeWhitelist;
     QStringList m_filetypeBlacklist;
+    bool m_residentMode = DEFAULT_RESIDENT_MODE;
+    bool m_dbusActivation = DEFAULT_DBUS_ACTIVATION;
+    int m_coalesceWindowMs = DEFAULT_COALESCE_WINDOW_MS;
+    int m_rateLimitBurst = DEFAULT_RATE_LIMIT_BURST;
+    int m_rateLimitPerMinute = DEFAULT_RATE_LIMIT_PER_MINUTE;
+    int m_openTimeoutMs = DEFAULT_OPEN_TIMEOUT_MS;
+    OpenerKind m_opener = DEFAULT_OPENER;
+    QString m_openerCommand;
+    QStringList m_revealFiletypes;
+    bool m_preferLocalMounts = DEFAULT_PREFER_LOCAL_MOUNTS;
+    bool m_probeServers = DEFAULT_PROBE_SERVERS;
+    int m_probeTimeoutMs = DEFAULT_PROBE_TIMEOUT_MS;
+    bool m_prewarm = DEFAULT_PREWARM;
+    int m_prewarmShares = DEFAULT_PREWARM_SHARES;
+    QString m_prewarmCommand;
+    QList<PathTranslation> m_pathTranslations;
+    QMap<QString, QString> m_serverAliases;
 };
 
 } // namespace uncopener
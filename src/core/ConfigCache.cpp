@@ -0,0 +1,230 @@
+#include "ConfigCache.hpp"
+
+#include "SecurityPolicy.hpp"
+
+#include <QCborMap>
+#include <QCborValue>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+namespace uncopener
+{
+
+namespace
+{
+
+constexpr quint32 CACHE_MAGIC = 0x554E4343; // "UNCC"
+constexpr QDataStream::Version STREAM_VERSION = QDataStream::Qt_6_0;
+constexpr QCryptographicHash::Algorithm HASH_ALGORITHM = QCryptographicHash::Sha1;
+
+/// Modification time as stored in the cache header
+qint64 modificationTime(const QFileInfo& info)
+{
+    return info.lastModified().toMSecsSinceEpoch();
+}
+
+/// Hash of the config file's bytes as stored in the cache header
+QByteArray contentHash(const QByteArray& data)
+{
+    return QCryptographicHash::hash(data, HASH_ALGORITHM);
+}
+
+} // namespace
+
+QString ConfigCache::cachePathFor(const QString& configPath)
+{
+    QFileInfo info(configPath);
+    return info.path() + "/" + info.completeBaseName() + ".cache";
+}
+
+QByteArray ConfigCache::schemaHash()
+{
+    // Derived from the keys a default config writes, so new settings invalidate old caches
+    static const QByteArray hash = []
+    {
+        QStringList keys = Config().toJson().keys();
+        keys.sort();
+        return QCryptographicHash::hash(keys.join('\n').toUtf8(), HASH_ALGORITHM);
+    }();
+    return hash;
+}
+
+bool ConfigCache::load(Config& config)
+{
+    return loadFrom(Config::configFilePath(), config);
+}
+
+bool ConfigCache::loadFrom(const QString& configPath, Config& config)
+{
+    if (read(configPath, config))
+    {
+        return true;
+    }
+
+    // Record the file state before parsing, so an edit in between leaves a stale cache behind
+    QFileInfo configInfo(configPath);
+    qint64 configMtimeMs = modificationTime(configInfo);
+    QByteArray configData;
+    QFile configFile(configPath);
+    if (configFile.open(QIODevice::ReadOnly))
+    {
+        configData = configFile.readAll();
+    }
+
+    if (!config.loadFrom(configPath))
+    {
+        return false;
+    }
+
+    // A cache that cannot be written only costs speed on the next launch
+    static_cast<void>(write(configPath, config, configData, configMtimeMs));
+    return true;
+}
+
+bool ConfigCache::read(const QString& configPath, Config& config)
+{
+    QFileInfo configInfo(configPath);
+    if (!configInfo.exists())
+    {
+        return false;
+    }
+
+    QFile file(cachePathFor(configPath));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    qint64 fileSize = file.size();
+    uchar* mapped = file.map(0, fileSize);
+    if (mapped == nullptr)
+    {
+        return false;
+    }
+
+    // Read directly from the mapping; only the final strings are copied
+    QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), fileSize);
+    QDataStream in(data);
+    in.setVersion(STREAM_VERSION);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 configSize = 0;
+    qint64 configMtimeMs = 0;
+    QByteArray configHash;
+    QByteArray cachedSchemaHash;
+    QByteArray payloadHash;
+    in >> magic >> version >> configSize >> configMtimeMs >> configHash >> cachedSchemaHash >>
+        payloadHash;
+
+    if (in.status() != QDataStream::Ok || magic != CACHE_MAGIC || version != FORMAT_VERSION ||
+        configSize != configInfo.size() || configMtimeMs != modificationTime(configInfo) ||
+        cachedSchemaHash != schemaHash())
+    {
+        return false;
+    }
+
+    // Size and modification time are only a quick check, the content decides
+    QFile configFile(configPath);
+    if (!configFile.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    uchar* configMapped = configSize > 0 ? configFile.map(0, configSize) : nullptr;
+    QByteArray configData =
+        configMapped != nullptr
+            ? QByteArray::fromRawData(reinterpret_cast<const char*>(configMapped), configSize)
+            : configFile.readAll();
+    if (contentHash(configData) != configHash)
+    {
+        return false;
+    }
+
+    qint64 payloadOffset = in.device()->pos();
+    QByteArray payload =
+        QByteArray::fromRawData(data.constData() + payloadOffset, data.size() - payloadOffset);
+    if (QCryptographicHash::hash(payload, HASH_ALGORITHM) != payloadHash)
+    {
+        return false;
+    }
+
+    QDataStream payloadIn(payload);
+    payloadIn.setVersion(STREAM_VERSION);
+
+    QByteArray settingsCbor;
+    QStringList uncAllowList;
+    QStringList filetypeWhitelist;
+    QStringList filetypeBlacklist;
+    payloadIn >> settingsCbor >> uncAllowList >> filetypeWhitelist >> filetypeBlacklist;
+
+    QCborValue settings = QCborValue::fromCbor(settingsCbor);
+    if (payloadIn.status() != QDataStream::Ok || !settings.isMap())
+    {
+        return false;
+    }
+
+    Config loaded;
+    if (!loaded.fromJson(settings.toMap().toJsonObject()))
+    {
+        return false;
+    }
+    loaded.setUncAllowList(uncAllowList);
+    loaded.setFiletypeWhitelist(filetypeWhitelist);
+    loaded.setFiletypeBlacklist(filetypeBlacklist);
+
+    config = loaded;
+    return true;
+}
+
+bool ConfigCache::write(const QString& configPath, const Config& config,
+                        const QByteArray& configData, qint64 configMtimeMs)
+{
+    // Compile the lists once: normalized and deduplicated, as the policy uses them
+    SecurityPolicy policy;
+    config.applyTo(policy);
+
+    // Everything except the large lists goes into the CBOR settings map
+    Config settings = config;
+    settings.setUncAllowList({});
+    settings.setFiletypeWhitelist({});
+    settings.setFiletypeBlacklist({});
+
+    QByteArray payload;
+    {
+        QDataStream out(&payload, QIODevice::WriteOnly);
+        out.setVersion(STREAM_VERSION);
+        out << QCborMap::fromJsonObject(settings.toJson()).toCborValue().toCbor();
+        out << policy.uncAllowList().entries() << policy.filetypePolicy().whitelist()
+            << policy.filetypePolicy().blacklist();
+    }
+
+    QByteArray header;
+    {
+        QDataStream out(&header, QIODevice::WriteOnly);
+        out.setVersion(STREAM_VERSION);
+        out << CACHE_MAGIC << FORMAT_VERSION << qint64(configData.size()) << configMtimeMs
+            << contentHash(configData) << schemaHash()
+            << QCryptographicHash::hash(payload, HASH_ALGORITHM);
+    }
+
+    // Use QSaveFile for atomic replacement; readers see either the old or the new cache
+    QSaveFile file(cachePathFor(configPath));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    if (file.write(header) != header.size() || file.write(payload) != payload.size())
+    {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+} // namespace uncopener
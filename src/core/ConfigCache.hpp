@@ -0,0 +1,57 @@
+#ifndef UNCOPENER_CONFIGCACHE_HPP
+#define UNCOPENER_CONFIGCACHE_HPP
+
+#include "Config.hpp"
+
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+
+namespace uncopener
+{
+
+/// Binary cache of the parsed config, stored next to config.json
+///
+/// The cache holds the normalized, deduplicated allow-list and filetype lists plus the
+/// remaining settings in CBOR, so a handler launch needs no JSON parsing. The matchers are not
+/// cached: CompiledPolicy builds its tries from the lists on every launch, in linear time.
+/// The cache is memory-mapped when read and is valid only while the config file's size,
+/// modification time and content hash match the values recorded in it, and while the settings
+/// schema is the one it was written with. A hash over the payload rejects truncated or
+/// corrupted caches.
+class ConfigCache
+{
+public:
+    /// Cache file format version, bump on any layout change
+    /// Added or removed settings keys are covered by the schema hash and need no bump.
+    static constexpr std::uint32_t FORMAT_VERSION = 2;
+
+    /// Hash of the settings schema (the sorted keys Config::toJson() writes)
+    [[nodiscard]] static QByteArray schemaHash();
+
+    /// Get the cache file path for a config file (config.json -> config.cache)
+    [[nodiscard]] static QString cachePathFor(const QString& configPath);
+
+    /// Load the default config file through its cache
+    /// Same return value as Config::load()
+    static bool load(Config& config);
+
+    /// Load a config file through its cache, rebuilding the cache when it is stale
+    /// Same return value as Config::loadFrom()
+    static bool loadFrom(const QString& configPath, Config& config);
+
+    /// Read the cache if it is valid for the current state of the config file
+    /// Returns false (leaving config untouched) if it is missing, stale, corrupt or its settings
+    /// are rejected by Config::fromJson()
+    [[nodiscard]] static bool read(const QString& configPath, Config& config);
+
+    /// Atomically write the cache for a config that was loaded from configPath
+    /// configData/configMtimeMs describe the file state the config was read from
+    [[nodiscard]] static bool write(const QString& configPath, const Config& config,
+                                    const QByteArray& configData, qint64 configMtimeMs);
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_CONFIGCACHE_HPP
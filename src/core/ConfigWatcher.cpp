@@ -0,0 +1,153 @@
+#include "ConfigWatcher.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QJsonDocument>
+#include <QPromise>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <memory>
+#include <utility>
+
+namespace uncopener
+{
+
+ConfigWatcher::ConfigWatcher(QString configPath, QObject* parent)
+    : QObject(parent), m_configPath(std::move(configPath)),
+      m_watcher(new QFileSystemWatcher(this)), m_debounce(new QTimer(this)),
+      m_reader(new QFutureWatcher<ConfigReadResult>(this))
+{
+    m_debounce->setSingleShot(true);
+    m_debounce->setInterval(DEFAULT_DEBOUNCE_MS);
+
+    connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &ConfigWatcher::onPathChanged);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this,
+            &ConfigWatcher::onPathChanged);
+    connect(m_debounce, &QTimer::timeout, this, &ConfigWatcher::onDebounceTimeout);
+    connect(m_reader, &QFutureWatcher<ConfigReadResult>::finished, this,
+            &ConfigWatcher::onReadFinished);
+}
+
+void ConfigWatcher::setDebounceInterval(int milliseconds)
+{
+    m_debounce->setInterval(milliseconds);
+}
+
+bool ConfigWatcher::start()
+{
+    m_loadedStamp = currentStamp();
+    if (m_loadedStamp.exists)
+    {
+        m_watcher->addPath(m_configPath);
+    }
+    return m_watcher->addPath(QFileInfo(m_configPath).path());
+}
+
+ConfigReadResult ConfigWatcher::read(const QString& configPath)
+{
+    ConfigReadResult result;
+
+    QFile file(configPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        result.error = file.exists() ? "Cannot read " + configPath + ": " + file.errorString()
+                                     : configPath + " was removed";
+        return result;
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError)
+    {
+        result.error = QString("Invalid JSON in %1 at offset %2: %3")
+                           .arg(configPath)
+                           .arg(parseError.offset)
+                           .arg(parseError.errorString());
+        return result;
+    }
+
+    if (!doc.isObject())
+    {
+        result.error = configPath + " does not contain a JSON object";
+        return result;
+    }
+
+    if (!result.config.fromJson(doc.object()))
+    {
+        result.error = configPath + " contains an invalid configuration";
+    }
+    return result;
+}
+
+ConfigWatcher::FileStamp ConfigWatcher::currentStamp() const
+{
+    QFileInfo info(m_configPath);
+    if (!info.exists())
+    {
+        return {};
+    }
+    return {true, info.size(), info.lastModified()};
+}
+
+void ConfigWatcher::onPathChanged()
+{
+    // A rename drops the file from the watch list; watch the new file again
+    if (!m_watcher->files().contains(m_configPath) && QFileInfo::exists(m_configPath))
+    {
+        m_watcher->addPath(m_configPath);
+    }
+
+    m_debounce->start();
+}
+
+void ConfigWatcher::onDebounceTimeout()
+{
+    // Other files in the directory (e.g. the config cache) change as well
+    FileStamp stamp = currentStamp();
+    if (stamp == m_loadedStamp)
+    {
+        return;
+    }
+
+    if (m_reader->isRunning())
+    {
+        m_changedWhileReading = true;
+        return;
+    }
+
+    m_loadedStamp = stamp;
+    auto promise = std::make_shared<QPromise<ConfigReadResult>>();
+    m_reader->setFuture(promise->future());
+    promise->start();
+
+    QThreadPool::globalInstance()->start(
+        [promise, path = m_configPath]()
+        {
+            promise->addResult(read(path));
+            promise->finish();
+        });
+}
+
+void ConfigWatcher::onReadFinished()
+{
+    ConfigReadResult result = m_reader->result();
+    if (result.success())
+    {
+        emit configChanged(result.config);
+    }
+    else
+    {
+        emit reloadFailed(result.error);
+    }
+
+    // The file changed again while it was parsed; read the latest state
+    if (m_changedWhileReading)
+    {
+        m_changedWhileReading = false;
+        m_debounce->start();
+    }
+}
+
+} // namespace uncopener
@@ -0,0 +1,93 @@
+#ifndef UNCOPENER_CONFIGWATCHER_HPP
+#define UNCOPENER_CONFIGWATCHER_HPP
+
+#include "Config.hpp"
+
+#include <QDateTime>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+
+class QFileSystemWatcher;
+class QTimer;
+
+namespace uncopener
+{
+
+/// Outcome of reading a config file for a reload
+struct ConfigReadResult
+{
+    Config config;
+    QString error; // Why the file was rejected; empty on success
+
+    [[nodiscard]] bool success() const { return error.isEmpty(); }
+};
+
+/// Watches config.json of a long-running process and reloads it after external edits
+///
+/// Both the file and its directory are watched, since tools that save atomically rename a new
+/// file over the old one and the file watch does not survive that. Bursts of events are
+/// debounced, and the file is parsed on a pool thread. A file that cannot be read or parsed
+/// is reported through reloadFailed() and the previous config stays in effect.
+class ConfigWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Default quiet period after the last change before the file is read
+    static constexpr int DEFAULT_DEBOUNCE_MS = 200;
+
+    explicit ConfigWatcher(QString configPath = Config::configFilePath(),
+                           QObject* parent = nullptr);
+
+    /// Get the watched config file path
+    [[nodiscard]] QString configPath() const { return m_configPath; }
+
+    /// Set the quiet period after the last change before the file is read
+    void setDebounceInterval(int milliseconds);
+
+    /// Start watching; the current state of the file counts as already loaded
+    /// Returns false if the config directory cannot be watched
+    [[nodiscard]] bool start();
+
+    /// Read and parse a config file, reporting why it was rejected
+    /// Unlike Config::loadFrom(), a missing or invalid file is an error and not the defaults
+    [[nodiscard]] static ConfigReadResult read(const QString& configPath);
+
+signals:
+    /// Emitted with the new config after the file changed and parsed successfully
+    void configChanged(const uncopener::Config& config);
+
+    /// Emitted when the changed file could not be read; the previous config stays in effect
+    void reloadFailed(const QString& reason);
+
+private:
+    /// State of the file that tells whether it changed since the last reload
+    struct FileStamp
+    {
+        bool exists = false;
+        qint64 size = 0;
+        QDateTime modified;
+
+        [[nodiscard]] bool operator==(const FileStamp& other) const
+        {
+            return exists == other.exists && size == other.size && modified == other.modified;
+        }
+    };
+
+    [[nodiscard]] FileStamp currentStamp() const;
+    void onPathChanged();
+    void onDebounceTimeout();
+    void onReadFinished();
+
+    QString m_configPath;
+    QFileSystemWatcher* m_watcher = nullptr;
+    QTimer* m_debounce = nullptr;
+    QFutureWatcher<ConfigReadResult>* m_reader = nullptr;
+    FileStamp m_loadedStamp;
+    bool m_changedWhileReading = false;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_CONFIGWATCHER_HPP
@@ -0,0 +1,47 @@
+#include "DBusApplicationService.hpp"
+
+namespace uncopener
+{
+
+DBusApplicationService::DBusApplicationService(QObject* parent) : QObject(parent) {}
+
+bool DBusApplicationService::registerOn(QDBusConnection& connection, const QString& serviceName)
+{
+    if (!connection.isConnected())
+    {
+        return false;
+    }
+
+    if (!connection.registerObject(OBJECT_PATH, this, QDBusConnection::ExportScriptableSlots))
+    {
+        return false;
+    }
+
+    if (!connection.registerService(serviceName))
+    {
+        connection.unregisterObject(OBJECT_PATH);
+        return false;
+    }
+    return true;
+}
+
+void DBusApplicationService::Activate(const QVariantMap& /*platformData*/)
+{
+    emit activated();
+}
+
+void DBusApplicationService::Open(const QStringList& uris, const QVariantMap& /*platformData*/)
+{
+    if (!uris.isEmpty())
+    {
+        emit openRequested(uris);
+    }
+}
+
+void DBusApplicationService::ActivateAction(const QString& /*actionName*/,
+                                            const QVariantList& /*parameter*/,
+                                            const QVariantMap& /*platformData*/)
+{
+}
+
+} // namespace uncopener
@@ -0,0 +1,53 @@
+#ifndef UNCOPENER_DBUSAPPLICATIONSERVICE_HPP
+#define UNCOPENER_DBUSAPPLICATIONSERVICE_HPP
+
+#include <QDBusConnection>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+
+namespace uncopener
+{
+
+/// org.freedesktop.Application interface of the DBusActivatable handler
+/// The session bus starts one instance on the first URL and routes every later Open() to it,
+/// so the desktop reuses the loaded config instead of spawning a process per click
+class DBusApplicationService : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.Application")
+
+public:
+    /// Object path derived from the bus name, as the desktop entry specification requires
+    static constexpr const char* OBJECT_PATH = "/org/uncopener/UncOpener/Handler";
+
+    explicit DBusApplicationService(QObject* parent = nullptr);
+
+    /// Export the interface and claim the bus name on a connection
+    /// Returns false if the name is already owned (another instance serves the URLs)
+    [[nodiscard]] bool registerOn(QDBusConnection& connection, const QString& serviceName);
+
+public slots:
+    /// Application started without URLs (e.g. from a launcher)
+    Q_SCRIPTABLE void Activate(const QVariantMap& platformData);
+
+    /// URLs passed by the desktop; each one is a scheme URL
+    Q_SCRIPTABLE void Open(const QStringList& uris, const QVariantMap& platformData);
+
+    /// The handler has no desktop actions; calls are ignored
+    Q_SCRIPTABLE void ActivateAction(const QString& actionName, const QVariantList& parameter,
+                                     const QVariantMap& platformData);
+
+signals:
+    /// Emitted for every Open() call with a non-empty URL list
+    void openRequested(const QStringList& urls);
+
+    /// Emitted for every Activate() call
+    void activated();
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_DBUSAPPLICATIONSERVICE_HPP
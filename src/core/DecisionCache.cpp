@@ -0,0 +1,94 @@
+#include "DecisionCache.hpp"
+
+namespace uncopener
+{
+
+namespace
+{
+
+/// Bookkeeping of QCache per entry (hash node and list links), roughly
+constexpr qsizetype ENTRY_OVERHEAD = 64;
+
+qsizetype stringBytes(const QString& text)
+{
+    return text.size() * static_cast<qsizetype>(sizeof(QChar));
+}
+
+} // namespace
+
+DecisionCache::DecisionCache(qsizetype maxBytes) : m_cache(maxBytes) {}
+
+QString DecisionCache::keyOf(const UncPath& path)
+{
+    return path.toUncString().toCaseFolded();
+}
+
+QString DecisionCache::keyOf(const QString& url)
+{
+    // Never starts with a backslash, so it cannot collide with the key of a path
+    return "url:" + url;
+}
+
+const ValidationResult* DecisionCache::find(const QString& key, quint64 generation)
+{
+    useGeneration(generation);
+
+    const ValidationResult* decision = m_cache.object(key);
+    if (decision == nullptr)
+    {
+        ++m_stats.misses;
+        return nullptr;
+    }
+
+    ++m_stats.hits;
+    return decision;
+}
+
+void DecisionCache::insert(const QString& key, quint64 generation,
+                           const ValidationResult& decision)
+{
+    useGeneration(generation);
+
+    // Replacing an entry does not count as an eviction
+    qsizetype expectedSize = m_cache.size() + (m_cache.contains(key) ? 0 : 1);
+    if (m_cache.insert(key, new ValidationResult(decision), costOf(key, decision)))
+    {
+        m_stats.evictions += expectedSize - m_cache.size();
+    }
+}
+
+qsizetype DecisionCache::costOf(const QString& key, const ValidationResult& decision)
+{
+    qsizetype bytes = ENTRY_OVERHEAD +
+                      static_cast<qsizetype>(sizeof(QString) + sizeof(ValidationResult)) +
+                      stringBytes(key) + stringBytes(decision.policy.reason) +
+                      stringBytes(decision.policy.remediation) +
+                      stringBytes(decision.policy.matchedRule) + stringBytes(decision.targetUrl) +
+                      stringBytes(decision.translation);
+    if (isSuccess(decision.parse))
+    {
+        const UncPath& path = getPath(decision.parse);
+        return bytes + stringBytes(path.server) + stringBytes(path.path);
+    }
+
+    const ParseError& error = getError(decision.parse);
+    return bytes + stringBytes(error.reason) + stringBytes(error.remediation) +
+           stringBytes(error.input);
+}
+
+void DecisionCache::useGeneration(quint64 generation)
+{
+    if (generation == m_generation)
+    {
+        return;
+    }
+
+    if (!m_cache.isEmpty())
+    {
+        m_cache.clear();
+        ++m_stats.invalidations;
+    }
+    m_generation = generation;
+}
+
+} // namespace uncopener
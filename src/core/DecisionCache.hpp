@@ -0,0 +1,80 @@
+#ifndef UNCOPENER_DECISIONCACHE_HPP
+#define UNCOPENER_DECISIONCACHE_HPP
+
+#include "PathOpener.hpp"
+#include "UrlParser.hpp"
+
+#include <QCache>
+#include <QString>
+
+namespace uncopener
+{
+
+/// Counters of a DecisionCache since construction
+struct DecisionCacheStats
+{
+    qint64 hits = 0;
+    qint64 misses = 0;
+    qint64 evictions = 0;     // Entries dropped to stay within the memory cap
+    qint64 invalidations = 0; // Times the cache was emptied for a new policy generation
+};
+
+/// Bounded LRU cache of validation results for a long-running process
+/// Most clicks go to a few shares, so a repeated path costs a parse and one hash lookup instead
+/// of the policy check. Entries are keyed by the canonical, case-folded UNC path (see keyOf()),
+/// so case and escape variants of one path share an entry. Entries belong to one policy
+/// generation (see CompiledPolicy); a lookup with another generation empties the cache, so a
+/// config reload never serves stale verdicts.
+/// Share one cache only among openers of one PolicyStore. Not thread-safe.
+class DecisionCache
+{
+public:
+    /// Default memory cap in bytes
+    static constexpr qsizetype DEFAULT_MAX_BYTES = 1024 * 1024;
+
+    explicit DecisionCache(qsizetype maxBytes = DEFAULT_MAX_BYTES);
+
+    /// Get the key of a parsed path, after server aliases are resolved
+    [[nodiscard]] static QString keyOf(const UncPath& path);
+
+    /// Get the key of a URL that did not parse
+    [[nodiscard]] static QString keyOf(const QString& url);
+
+    /// Look up the decision for a key, marking it as most recently used
+    /// Returns nullptr on a miss; the pointer is valid until the next insert() or clear()
+    [[nodiscard]] const ValidationResult* find(const QString& key, quint64 generation);
+
+    /// Remember the decision for a key, evicting the least recently used entries
+    /// Entries larger than the memory cap are not stored
+    void insert(const QString& key, quint64 generation, const ValidationResult& decision);
+
+    /// Drop all entries
+    void clear() { m_cache.clear(); }
+
+    /// Get the number of entries
+    [[nodiscard]] qsizetype size() const { return m_cache.size(); }
+
+    /// Get the estimated memory use of all entries in bytes
+    [[nodiscard]] qsizetype bytes() const { return m_cache.totalCost(); }
+
+    /// Get the memory cap in bytes
+    [[nodiscard]] qsizetype maxBytes() const { return m_cache.maxCost(); }
+
+    /// Get the hit, miss and eviction counters
+    [[nodiscard]] const DecisionCacheStats& stats() const { return m_stats; }
+
+    /// Estimate the memory use of an entry in bytes
+    [[nodiscard]] static qsizetype costOf(const QString& key, const ValidationResult& decision);
+
+private:
+    /// Empty the cache if its entries belong to another generation
+    void useGeneration(quint64 generation);
+
+    QCache<QString, ValidationResult> m_cache;
+    quint64 m_generation = 0;
+    DecisionCacheStats m_stats;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_DECISIONCACHE_HPP
@@ -0,0 +1,232 @@
+#include "DecisionFilter.hpp"
+
+#include <QByteArrayView>
+#include <QIODevice>
+#include <QStringDecoder>
+#include <QStringEncoder>
+#include <QVarLengthArray>
+
+namespace uncopener
+{
+
+namespace
+{
+
+/// Output is written in chunks of about this size
+constexpr qsizetype OUTPUT_CHUNK_SIZE = 64 * 1024;
+
+/// Stack capacity for decoding a line; longer lines fall back to the heap
+constexpr qsizetype LINE_BUFFER_SIZE = 1024;
+
+char hexDigit(int value)
+{
+    return static_cast<char>(value < 10 ? '0' + value : 'a' + value - 10);
+}
+
+const char* parseErrorCode(ParseError::Code code)
+{
+    switch (code)
+    {
+    case ParseError::Code::EmptyInput:
+        return "empty-input";
+    case ParseError::Code::MissingScheme:
+        return "missing-scheme";
+    case ParseError::Code::WrongScheme:
+        return "wrong-scheme";
+    case ParseError::Code::InvalidSchemeFormat:
+        return "invalid-scheme-format";
+    case ParseError::Code::MissingAuthority:
+        return "missing-authority";
+    case ParseError::Code::WhitespaceAuthority:
+        return "whitespace-authority";
+    case ParseError::Code::DirectoryTraversal:
+        return "directory-traversal";
+    case ParseError::Code::InvalidCharacter:
+        return "invalid-character";
+    }
+    return "invalid-url";
+}
+
+Decision::Reason policyReason(PolicyVerdict::Reason reason)
+{
+    switch (reason)
+    {
+    case PolicyVerdict::Reason::None:
+        return Decision::Reason::None;
+    case PolicyVerdict::Reason::NotInAllowList:
+        return Decision::Reason::NotInAllowList;
+    case PolicyVerdict::Reason::FiletypeNotWhitelisted:
+        return Decision::Reason::FiletypeNotWhitelisted;
+    case PolicyVerdict::Reason::FiletypeBlacklisted:
+        return Decision::Reason::FiletypeBlacklisted;
+    }
+    return Decision::Reason::None;
+}
+
+} // namespace
+
+const char* Decision::reasonCode() const
+{
+    switch (reason)
+    {
+    case Reason::None:
+        return "";
+    case Reason::InvalidUrl:
+        return parseErrorCode(parseError);
+    case Reason::NotInAllowList:
+        return "not-in-allow-list";
+    case Reason::FiletypeNotWhitelisted:
+        return "filetype-not-whitelisted";
+    case Reason::FiletypeBlacklisted:
+        return "filetype-blacklisted";
+    case Reason::LineTooLong:
+        return "line-too-long";
+    }
+    return "";
+}
+
+DecisionFilter::DecisionFilter(const Config& config) : m_policy(config) {}
+
+Decision DecisionFilter::evaluate(QStringView url) const
+{
+    Decision decision;
+
+    UrlVerdict verdict = m_policy.decide(url);
+    if (verdict.parseError)
+    {
+        decision.reason = Decision::Reason::InvalidUrl;
+        decision.parseError = *verdict.parseError;
+        return decision;
+    }
+
+    decision.allowed = verdict.allowed();
+    decision.reason = policyReason(verdict.policy.reason);
+    decision.target = verdict.path.toUncString();
+    decision.matchedRule = verdict.policy.matchedRule;
+    return decision;
+}
+
+Decision DecisionFilter::evaluateUtf8(QByteArrayView line) const
+{
+    // UTF-16 never needs more units than UTF-8 has bytes
+    QByteArrayView bytes = line.trimmed();
+    QVarLengthArray<QChar, LINE_BUFFER_SIZE> chars(bytes.size());
+    QStringDecoder decoder(QStringDecoder::Utf8);
+    QChar* end = decoder.appendToBuffer(chars.data(), bytes);
+    return evaluate(QStringView(chars.data(), end));
+}
+
+void DecisionFilter::appendLine(const Decision& decision, Format format, QByteArray& out)
+{
+    const char* verdict = decision.allowed ? "allow" : "deny";
+
+    if (format == Format::Tsv)
+    {
+        out += verdict;
+        out += '\t';
+        out += decision.reasonCode();
+        out += '\t';
+        appendField(out, decision.target, format);
+        out += '\t';
+        appendField(out, decision.matchedRule, format);
+        out += '\n';
+        return;
+    }
+
+    out += R"({"verdict":")";
+    out += verdict;
+    out += R"(","reason":")";
+    out += decision.reasonCode();
+    out += R"(","target":")";
+    appendField(out, decision.target, format);
+    out += R"(","rule":")";
+    appendField(out, decision.matchedRule, format);
+    out += "\"}\n";
+}
+
+void DecisionFilter::appendField(QByteArray& out, QStringView text, Format format)
+{
+    QStringEncoder encoder(QStringEncoder::Utf8);
+    qsizetype runStart = 0;
+
+    // Runs end at ASCII characters only, so surrogate pairs are never split
+    auto appendRun = [&](qsizetype runEnd)
+    {
+        QStringView run = text.sliced(runStart, runEnd - runStart);
+        if (run.isEmpty())
+        {
+            return;
+        }
+        qsizetype offset = out.size();
+        out.resize(offset + encoder.requiredSpace(run.size()));
+        char* end = encoder.appendToBuffer(out.data() + offset, run);
+        out.resize(end - out.constData());
+    };
+
+    for (qsizetype i = 0; i < text.size(); ++i)
+    {
+        char16_t c = text[i].unicode();
+        bool control = c < 0x20;
+        bool escaped = format == Format::Json && (c == u'"' || c == u'\\');
+        if (!control && !escaped)
+        {
+            continue;
+        }
+
+        appendRun(i);
+        runStart = i + 1;
+
+        if (format == Format::Tsv)
+        {
+            out += ' ';
+        }
+        else if (escaped)
+        {
+            out += '\\';
+            out += static_cast<char>(c);
+        }
+        else
+        {
+            out += "\\u00";
+            out += hexDigit(c >> 4);
+            out += hexDigit(c & 0xF);
+        }
+    }
+    appendRun(text.size());
+}
+
+qint64 DecisionFilter::run(QIODevice& input, QIODevice& output, Format format) const
+{
+    // Lines and output chunks go through reused buffers, so memory stays bounded
+    LineReader reader(&input);
+    QByteArray out;
+    out.reserve(OUTPUT_CHUNK_SIZE + LINE_BUFFER_SIZE);
+    qint64 lineCount = 0;
+
+    QByteArrayView line;
+    while (reader.next(line))
+    {
+        ++lineCount;
+        if (reader.isTooLong())
+        {
+            Decision decision;
+            decision.reason = Decision::Reason::LineTooLong;
+            appendLine(decision, format, out);
+        }
+        else
+        {
+            appendLine(evaluateUtf8(line), format, out);
+        }
+
+        if (out.size() >= OUTPUT_CHUNK_SIZE)
+        {
+            output.write(out);
+            out.resize(0);
+        }
+    }
+
+    output.write(out);
+    return lineCount;
+}
+
+} // namespace uncopener
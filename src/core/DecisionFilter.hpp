@@ -0,0 +1,89 @@
+#ifndef UNCOPENER_DECISIONFILTER_HPP
+#define UNCOPENER_DECISIONFILTER_HPP
+
+#include "CompiledPolicy.hpp"
+#include "Config.hpp"
+#include "LineReader.hpp"
+#include "UrlParser.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+#include <cstdint>
+
+class QIODevice;
+
+namespace uncopener
+{
+
+/// Verdict on a URL as stable codes; no human-readable messages are built
+struct Decision
+{
+    enum class Reason : std::uint8_t
+    {
+        None,                   // Allowed
+        InvalidUrl,             // Rejected by the URL contract, see parseError
+        NotInAllowList,         // No allow-list entry is a prefix of the path
+        FiletypeNotWhitelisted, // Whitelist mode and no whitelisted extension matches
+        FiletypeBlacklisted,    // Blacklist mode and a blacklisted extension matches
+        LineTooLong,            // Input line exceeds DecisionFilter::MAX_LINE_LENGTH
+    };
+
+    bool allowed = false;
+    Reason reason = Reason::None;
+    ParseError::Code parseError{}; // Only meaningful for Reason::InvalidUrl
+    QString target;                // Canonical UNC path; empty if the URL did not parse
+    QString matchedRule;           // Policy entry that decided the verdict (empty if none did)
+
+    /// Stable identifier of the reason for machine-readable output (e.g. "not-in-allow-list")
+    /// Empty for allowed URLs; parse errors report their ParseError::Code
+    [[nodiscard]] const char* reasonCode() const;
+};
+
+/// Evaluates URLs with the same contract and policy as PathOpener::evaluate(), without opening
+/// them, and writes one decision per input line (e.g. to audit proxy logs)
+/// Both decide through CompiledPolicy::decide(), so their verdicts cannot drift apart.
+class DecisionFilter
+{
+public:
+    /// Output line format
+    enum class Format : std::uint8_t
+    {
+        Json, // {"verdict":"allow","reason":"","target":"\\\\server\\share","rule":"\\\\server"}
+        Tsv   // verdict, reason, target and rule separated by tabs
+    };
+
+    /// Longest input line that is evaluated; longer lines are rejected to bound memory
+    static constexpr qsizetype MAX_LINE_LENGTH = LineReader::MAX_LINE_LENGTH;
+
+    explicit DecisionFilter(const Config& config);
+
+    /// Evaluate one URL
+    /// Safe to call from several threads at once
+    [[nodiscard]] Decision evaluate(QStringView url) const;
+
+    /// Evaluate one line of UTF-8 input; surrounding whitespace is ignored
+    [[nodiscard]] Decision evaluateUtf8(QByteArrayView line) const;
+
+    /// Append a decision as one line in the given format
+    static void appendLine(const Decision& decision, Format format, QByteArray& out);
+
+    /// Append text as UTF-8 for a field of the given format
+    /// JSON gets string escapes (without quotes); TSV gets control characters as spaces
+    static void appendField(QByteArray& out, QStringView text, Format format);
+
+    /// Read newline-delimited URLs and write one decision line per input line, in order
+    /// Surrounding whitespace is ignored; blank lines are reported as empty input
+    /// Returns the number of lines processed
+    qint64 run(QIODevice& input, QIODevice& output, Format format) const;
+
+private:
+    CompiledPolicy m_policy;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_DECISIONFILTER_HPP
@@ -0,0 +1,109 @@
+#include "FileManagerBackend.hpp"
+
+#include <QCoreApplication>
+#include <QDBusMessage>
+#include <QDBusPendingCall>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QThread>
+
+#include <atomic>
+
+namespace uncopener
+{
+
+namespace
+{
+
+/// Session bus connection owned by one worker thread, closed when the thread ends
+class ThreadBus
+{
+public:
+    ThreadBus()
+        : m_name(QString("uncopener-filemanager-%1").arg(s_nextId.fetch_add(1))),
+          m_connection(QDBusConnection::connectToBus(QDBusConnection::SessionBus, m_name))
+    {
+    }
+
+    ~ThreadBus() { QDBusConnection::disconnectFromBus(m_name); }
+
+    ThreadBus(const ThreadBus&) = delete;
+    ThreadBus& operator=(const ThreadBus&) = delete;
+
+    [[nodiscard]] const QDBusConnection& connection() const { return m_connection; }
+
+private:
+    static inline std::atomic<int> s_nextId{0};
+
+    QString m_name;
+    QDBusConnection m_connection;
+};
+
+} // namespace
+
+FileManagerBackend::FileManagerBackend(const QDBusConnection& bus) : m_bus(bus) {}
+
+QDBusConnection FileManagerBackend::bus() const
+{
+    if (m_bus)
+    {
+        return *m_bus;
+    }
+
+    // The shared connection belongs to the GUI thread; workers get their own
+    QCoreApplication* app = QCoreApplication::instance();
+    if (app == nullptr || app->thread() == QThread::currentThread())
+    {
+        return QDBusConnection::sessionBus();
+    }
+    thread_local ThreadBus threadBus;
+    return threadBus.connection();
+}
+
+OpenResult FileManagerBackend::launch(const QString& targetUrl, OpenOutcome& outcome)
+{
+    return call(targetUrl.endsWith('/') ? "ShowFolders" : "ShowItems", {targetUrl}, outcome);
+}
+
+OpenResult FileManagerBackend::launchSelection(const QStringList& targetUrls,
+                                               OpenOutcome& outcome)
+{
+    return call("ShowItems", targetUrls, outcome);
+}
+
+OpenResult FileManagerBackend::call(const QString& method, const QStringList& uris,
+                                    OpenOutcome& outcome)
+{
+    QDBusConnection connection = bus();
+    if (!connection.isConnected())
+    {
+        outcome.exitStatus = EXIT_NOT_STARTED;
+        return OpenResult::error("No session bus available",
+                                 "Choose another opener in the configuration.");
+    }
+
+    QDBusMessage message =
+        QDBusMessage::createMethodCall(SERVICE_NAME, OBJECT_PATH, INTERFACE_NAME, method);
+    // The second argument is the startup notification id, which a handler does not have
+    message.setArguments({uris, QString()});
+
+    QElapsedTimer timer;
+    timer.start();
+    QDBusPendingCall call = connection.asyncCall(message, DEFAULT_CALL_TIMEOUT_MS);
+    outcome.spawnLatencyUs = timer.nsecsElapsed() / 1000;
+    call.waitForFinished();
+
+    if (call.isError())
+    {
+        outcome.exitStatus = 1;
+        return OpenResult::error("The file manager could not show the path",
+                                 call.error().message() +
+                                     "\nMake sure a file manager is running that implements "
+                                     "org.freedesktop.FileManager1.");
+    }
+
+    outcome.exitStatus = 0;
+    return OpenResult::ok();
+}
+
+} // namespace uncopener
@@ -0,0 +1,58 @@
+#ifndef UNCOPENER_FILEMANAGERBACKEND_HPP
+#define UNCOPENER_FILEMANAGERBACKEND_HPP
+
+#include "OpenerBackend.hpp"
+
+#include <QDBusConnection>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+namespace uncopener
+{
+
+/// Shows targets in the file manager via org.freedesktop.FileManager1 (Linux only)
+/// Folders (targets ending with a slash) are opened with ShowFolders, files are selected in
+/// their folder with ShowItems. reveal() passes all files of one folder to a single ShowItems
+/// call, so the folder opens once with all of them selected. The exit status is 0 if the call
+/// succeeded and 1 otherwise.
+/// By default every thread calls over its own session bus connection, as opens run on workers.
+class FileManagerBackend : public OpenerBackend
+{
+public:
+    /// Well-known name, object path and interface of the file manager
+    static constexpr const char* SERVICE_NAME = "org.freedesktop.FileManager1";
+    static constexpr const char* OBJECT_PATH = "/org/freedesktop/FileManager1";
+    static constexpr const char* INTERFACE_NAME = "org.freedesktop.FileManager1";
+
+    /// Default time to wait for the file manager to answer
+    static constexpr int DEFAULT_CALL_TIMEOUT_MS = 25000;
+
+    /// Call the file manager on the session bus, over a connection of the calling thread
+    FileManagerBackend() = default;
+
+    /// Call the file manager on the given bus
+    explicit FileManagerBackend(const QDBusConnection& bus);
+
+    [[nodiscard]] QString name() const override { return "file manager"; }
+
+protected:
+    OpenResult launch(const QString& targetUrl, OpenOutcome& outcome) override;
+
+    OpenResult launchSelection(const QStringList& targetUrls, OpenOutcome& outcome) override;
+
+private:
+    /// Call a method of the file manager with a list of URIs
+    OpenResult call(const QString& method, const QStringList& uris, OpenOutcome& outcome);
+
+    /// Get the bus to call on from the calling thread
+    [[nodiscard]] QDBusConnection bus() const;
+
+    /// Fixed bus; the session bus connection of the calling thread if not set
+    std::optional<QDBusConnection> m_bus;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_FILEMANAGERBACKEND_HPP
@@ -0,0 +1,46 @@
+#include "LineReader.hpp"
+
+#include <QIODevice>
+
+namespace uncopener
+{
+
+LineReader::LineReader(QIODevice* device)
+    : m_device(device), m_buffer(MAX_LINE_LENGTH + 2, Qt::Uninitialized)
+{
+}
+
+bool LineReader::next(QByteArrayView& line)
+{
+    m_tooLong = false;
+    const qint64 capacity = m_buffer.size();
+
+    qint64 length = m_device->readLine(m_buffer.data(), capacity);
+    if (length <= 0)
+    {
+        return false;
+    }
+
+    line = QByteArrayView(m_buffer.constData(), length);
+    if (line.endsWith('\n'))
+    {
+        line.chop(1);
+        return true;
+    }
+    if (length < capacity - 1)
+    {
+        // Last line without a line break
+        return true;
+    }
+
+    // Skip the rest of the line without buffering it
+    while (length == capacity - 1 && m_buffer.at(length - 1) != '\n')
+    {
+        length = m_device->readLine(m_buffer.data(), capacity);
+    }
+    m_tooLong = true;
+    line = {};
+    return true;
+}
+
+} // namespace uncopener
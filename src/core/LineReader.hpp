@@ -0,0 +1,36 @@
+#ifndef UNCOPENER_LINEREADER_HPP
+#define UNCOPENER_LINEREADER_HPP
+
+#include <QByteArray>
+#include <QByteArrayView>
+
+class QIODevice;
+
+namespace uncopener
+{
+
+/// Reads newline-delimited lines through one reused buffer, so memory stays bounded
+class LineReader
+{
+public:
+    /// Longest line that is returned; longer lines are skipped and reported by isTooLong()
+    static constexpr qsizetype MAX_LINE_LENGTH = 64 * 1024;
+
+    explicit LineReader(QIODevice* device);
+
+    /// Read the next line without its line break; returns false at the end of the input
+    /// The view stays valid until the next call. An overlong line yields an empty view.
+    [[nodiscard]] bool next(QByteArrayView& line);
+
+    /// Check if the line returned last was longer than MAX_LINE_LENGTH
+    [[nodiscard]] bool isTooLong() const { return m_tooLong; }
+
+private:
+    QIODevice* m_device;
+    QByteArray m_buffer; // Line, '\n' and '\0'
+    bool m_tooLong = false;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_LINEREADER_HPP
@@ -0,0 +1,234 @@
+#include "MountIndex.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+#include <QUrl>
+
+#include <utility>
+
+namespace uncopener
+{
+
+namespace
+{
+
+/// File system types of SMB mounts in mountinfo
+const QList<QByteArray> SMB_FS_TYPES = {"cifs", "smb3", "smbfs"};
+
+/// Prefix of gvfs mount directories of SMB shares
+const QString GVFS_SMB_PREFIX = "smb-share:";
+
+/// Undo the octal escapes of mountinfo fields (e.g. "\040" for a space)
+QString unescapeField(const QByteArray& field)
+{
+    QByteArray result;
+    result.reserve(field.size());
+    for (qsizetype i = 0; i < field.size(); ++i)
+    {
+        bool isEscape = field.at(i) == '\\' && i + 3 < field.size() &&
+                        field.at(i + 1) >= '0' && field.at(i + 1) <= '3' &&
+                        field.at(i + 2) >= '0' && field.at(i + 2) <= '7' &&
+                        field.at(i + 3) >= '0' && field.at(i + 3) <= '7';
+        if (!isEscape)
+        {
+            result.append(field.at(i));
+            continue;
+        }
+        int value = ((field.at(i + 1) - '0') * 64) + ((field.at(i + 2) - '0') * 8) +
+                    (field.at(i + 3) - '0');
+        result.append(static_cast<char>(value));
+        i += 3;
+    }
+    return QString::fromUtf8(result);
+}
+
+/// Split a path into its non-empty segments, accepting both slash types
+QStringList pathSegments(QString path)
+{
+    path.replace('\\', '/');
+    return path.split('/', Qt::SkipEmptyParts);
+}
+
+} // namespace
+
+MountIndex::MountIndex(QString mountInfoPath, QString gvfsPath)
+    : m_mountInfoPath(std::move(mountInfoPath)), m_gvfsPath(std::move(gvfsPath))
+{
+    refresh();
+}
+
+QString MountIndex::defaultGvfsPath()
+{
+#ifdef Q_OS_WIN
+    return {};
+#else
+    QString runtimeDir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+    return runtimeDir.isEmpty() ? QString() : runtimeDir + "/gvfs";
+#endif
+}
+
+bool MountIndex::refresh()
+{
+    QByteArray mountInfo;
+    QFile file(m_mountInfoPath);
+    if (!m_mountInfoPath.isEmpty() && file.open(QIODevice::ReadOnly))
+    {
+        // mountinfo reports a size of 0, so it is read until the end
+        mountInfo = file.readAll();
+    }
+
+    QStringList gvfsNames;
+    if (!m_gvfsPath.isEmpty())
+    {
+        gvfsNames = QDir(m_gvfsPath).entryList({GVFS_SMB_PREFIX + "*"},
+                                               QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    }
+
+    if (m_loaded && mountInfo == m_mountInfo && gvfsNames == m_gvfsNames)
+    {
+        return false;
+    }
+
+    m_loaded = true;
+    m_mountInfo = mountInfo;
+    m_gvfsNames = gvfsNames;
+    rebuild();
+    return true;
+}
+
+void MountIndex::rebuild()
+{
+    m_entries = parseMountInfo(m_mountInfo);
+    for (const QString& name : std::as_const(m_gvfsNames))
+    {
+        MountEntry entry;
+        if (parseGvfsName(name, entry))
+        {
+            entry.localPath = m_gvfsPath + "/" + name;
+            m_entries.append(entry);
+        }
+    }
+
+    // Kernel mounts come first and win over gvfs mounts of the same share
+    m_byKey.clear();
+    for (qsizetype i = 0; i < m_entries.size(); ++i)
+    {
+        const MountEntry& entry = m_entries.at(i);
+        QString key = (entry.server + '\\' + entry.path).toCaseFolded();
+        if (!m_byKey.contains(key))
+        {
+            m_byKey.insert(key, i);
+        }
+    }
+}
+
+QString MountIndex::localPath(const UncPath& path) const
+{
+    if (m_byKey.isEmpty() || !path.isConfined())
+    {
+        return {};
+    }
+
+    // Try the longest prefix first; a share is the shortest thing that can be mounted
+    QStringList segments = pathSegments(path.path);
+    for (qsizetype count = segments.size(); count > 0; --count)
+    {
+        QString key = (path.server + '\\' + segments.first(count).join('\\')).toCaseFolded();
+        auto it = m_byKey.constFind(key);
+        if (it == m_byKey.constEnd())
+        {
+            continue;
+        }
+
+        QString result = m_entries.at(it.value()).localPath;
+        if (count < segments.size())
+        {
+            result += "/" + segments.sliced(count).join('/');
+        }
+        if (path.hasTrailingSlash && !result.endsWith('/'))
+        {
+            result += '/';
+        }
+        return result;
+    }
+    return {};
+}
+
+QString MountIndex::localUrl(const UncPath& path) const
+{
+    QString local = localPath(path);
+    return local.isEmpty() ? QString() : QUrl::fromLocalFile(local).toString(QUrl::FullyEncoded);
+}
+
+QList<MountEntry> MountIndex::parseMountInfo(const QByteArray& mountInfo)
+{
+    // Fields: mount ID, parent ID, major:minor, root, mount point, mount options, optional
+    // fields, "-", file system type, mount source, super options
+    constexpr qsizetype rootField = 3;
+    constexpr qsizetype mountPointField = 4;
+    constexpr qsizetype firstOptionalField = 6;
+
+    QList<MountEntry> entries;
+    for (const QByteArray& line : mountInfo.split('\n'))
+    {
+        QList<QByteArray> fields = line.split(' ');
+        qsizetype separator = fields.indexOf(QByteArray("-"), firstOptionalField);
+        if (separator < 0 || fields.size() < separator + 3 ||
+            !SMB_FS_TYPES.contains(fields.at(separator + 1)))
+        {
+            continue;
+        }
+
+        // The source is //server/share[/folder]; root is the folder of it that is mounted
+        QStringList segments = pathSegments(unescapeField(fields.at(separator + 2)));
+        segments.append(pathSegments(unescapeField(fields.at(rootField))));
+        if (segments.size() < 2)
+        {
+            continue;
+        }
+
+        MountEntry entry;
+        entry.server = segments.takeFirst();
+        entry.path = segments.join('\\');
+        entry.localPath = unescapeField(fields.at(mountPointField));
+        entries.append(entry);
+    }
+    return entries;
+}
+
+bool MountIndex::parseGvfsName(const QString& name, MountEntry& entry)
+{
+    if (!name.startsWith(GVFS_SMB_PREFIX))
+    {
+        return false;
+    }
+
+    // Values are percent-encoded, e.g. share=my%20share
+    QString server;
+    QString share;
+    for (const QString& pair : name.sliced(GVFS_SMB_PREFIX.size()).split(','))
+    {
+        qsizetype equals = pair.indexOf('=');
+        QString key = pair.left(equals);
+        QString value = QUrl::fromPercentEncoding(pair.sliced(equals + 1).toUtf8());
+        if (equals > 0 && key == "server")
+        {
+            server = value;
+        }
+        else if (equals > 0 && key == "share")
+        {
+            share = value;
+        }
+    }
+
+    if (server.isEmpty() || share.isEmpty())
+    {
+        return false;
+    }
+    entry.server = server;
+    entry.path = share;
+    return true;
+}
+
+} // namespace uncopener
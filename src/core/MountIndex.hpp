@@ -0,0 +1,81 @@
+#ifndef UNCOPENER_MOUNTINDEX_HPP
+#define UNCOPENER_MOUNTINDEX_HPP
+
+#include "UrlParser.hpp"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace uncopener
+{
+
+/// A share (or a folder within one) that is mounted locally
+struct MountEntry
+{
+    QString server;
+    QString path;      // Share and optional folder below it, separated by backslashes
+    QString localPath; // Mount point
+};
+
+/// Maps UNC paths to local mount points of SMB shares (Linux)
+/// Opening smb:// makes gvfs or kio set up a new session each time; a share that is already
+/// mounted through cifs (also via autofs) or gvfs opens at once through its local path.
+/// cifs mounts come from mountinfo, gvfs mounts from the smb-share:... directories of the
+/// gvfs FUSE mount. refresh() re-reads both and rebuilds the index only when they changed.
+/// Not thread-safe.
+class MountIndex
+{
+public:
+    /// Mount table of the calling process
+    static constexpr const char* DEFAULT_MOUNTINFO_PATH = "/proc/self/mountinfo";
+
+    /// Index the mounts of a mountinfo file and a gvfs directory
+    /// Either path may be empty to skip that source.
+    explicit MountIndex(QString mountInfoPath = DEFAULT_MOUNTINFO_PATH,
+                        QString gvfsPath = defaultGvfsPath());
+
+    /// Get the gvfs FUSE directory of the user, /run/user/<uid>/gvfs
+    [[nodiscard]] static QString defaultGvfsPath();
+
+    /// Re-read the sources and rebuild the index if the mounts changed
+    /// Returns true if the index was rebuilt
+    bool refresh();
+
+    /// Get the local path of a UNC path, or an empty string if no mount covers it
+    /// The longest mounted prefix wins; comparison is case-insensitive like SMB. Paths with "."
+    /// or ".." segments (e.g. from %2E%2E in the URL) are not mapped, so they cannot leave the
+    /// mount point.
+    [[nodiscard]] QString localPath(const UncPath& path) const;
+
+    /// Get the file:// URL of localPath(), or an empty string if no mount covers the path
+    [[nodiscard]] QString localUrl(const UncPath& path) const;
+
+    /// Get all indexed mounts
+    [[nodiscard]] const QList<MountEntry>& entries() const { return m_entries; }
+
+    /// Parse the SMB mounts of a mountinfo file, see proc_pid_mountinfo(5)
+    [[nodiscard]] static QList<MountEntry> parseMountInfo(const QByteArray& mountInfo);
+
+    /// Parse a gvfs mount directory name like "smb-share:server=srv,share=data,user=me"
+    /// Returns false for other names
+    [[nodiscard]] static bool parseGvfsName(const QString& name, MountEntry& entry);
+
+private:
+    /// Build the lookup table from the current sources
+    void rebuild();
+
+    QString m_mountInfoPath;
+    QString m_gvfsPath;
+    QByteArray m_mountInfo;
+    QStringList m_gvfsNames;
+    bool m_loaded = false;
+    QList<MountEntry> m_entries;
+    QHash<QString, qsizetype> m_byKey; // Case-folded "server\path" to index in m_entries
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_MOUNTINDEX_HPP
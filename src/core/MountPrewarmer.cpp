@@ -0,0 +1,173 @@
+#include "MountPrewarmer.hpp"
+
+#include "MountIndex.hpp"
+
+#include <QProcess>
+#include <QTimer>
+
+#include <algorithm>
+
+namespace uncopener
+{
+
+namespace
+{
+
+/// Upper bound of remembered requests; expired ones are pruned when it is reached
+constexpr qsizetype MAX_TRACKED_SHARES = 1024;
+
+} // namespace
+
+MountPrewarmer::MountPrewarmer(const Config& config, QObject* parent)
+    : MountPrewarmer(commandFor(config), config.smbUsername(), DEFAULT_MAX_CONCURRENT,
+                     DEFAULT_TTL_MS, parent)
+{
+}
+
+MountPrewarmer::MountPrewarmer(std::unique_ptr<CommandBackend> command, QString smbUsername,
+                               int maxConcurrent, int ttlMs, QObject* parent)
+    : QObject(parent), m_command(std::move(command)), m_smbUsername(std::move(smbUsername)),
+      m_maxConcurrent(std::max(maxConcurrent, 1)), m_ttlMs(std::max(ttlMs, 0))
+{
+    m_clock.start();
+}
+
+MountPrewarmer::~MountPrewarmer()
+{
+    // Running commands are children; stop them before they are destroyed
+    const QList<QProcess*> processes = findChildren<QProcess*>();
+    for (QProcess* process : processes)
+    {
+        process->disconnect(this);
+        process->kill();
+        process->waitForFinished();
+    }
+}
+
+std::unique_ptr<CommandBackend> MountPrewarmer::commandFor(const Config& config)
+{
+    if (!config.prewarmCommand().trimmed().isEmpty())
+    {
+        return CommandBackend::fromCommandLine(config.prewarmCommand());
+    }
+#ifdef Q_OS_WIN
+    return nullptr;
+#else
+    return std::make_unique<CommandBackend>("gio", QStringList{"mount"});
+#endif
+}
+
+bool MountPrewarmer::request(const UncPath& path)
+{
+    return request(path, m_clock.elapsed());
+}
+
+bool MountPrewarmer::request(const UncPath& path, qint64 nowMs)
+{
+    QString share = ShareHistory::shareOf(path);
+    if (!m_command || path.server.isEmpty() || share.isEmpty() ||
+        m_pending.size() >= MAX_PENDING)
+    {
+        return false;
+    }
+
+    UncPath root{path.server, share, false};
+    QString target = targetFor(root);
+    QString key = target.toCaseFolded();
+    auto requested = m_requested.constFind(key);
+    if (requested != m_requested.constEnd() && nowMs - requested.value() < m_ttlMs)
+    {
+        return false;
+    }
+
+    if (m_mounts)
+    {
+        m_mounts->refresh();
+        if (!m_mounts->localPath(root).isEmpty())
+        {
+            return false;
+        }
+    }
+
+    if (m_requested.size() >= MAX_TRACKED_SHARES)
+    {
+        m_requested.removeIf([this, nowMs](const QHash<QString, qint64>::iterator& it)
+                             { return nowMs - it.value() >= m_ttlMs; });
+    }
+    m_requested.insert(key, nowMs);
+    m_pending.append(target);
+    dispatch();
+    return true;
+}
+
+int MountPrewarmer::prewarm(const QList<ShareUse>& shares)
+{
+    int queued = 0;
+    for (const ShareUse& use : shares)
+    {
+        if (request(use.path()))
+        {
+            ++queued;
+        }
+    }
+    return queued;
+}
+
+QString MountPrewarmer::targetFor(const UncPath& share) const
+{
+#ifdef Q_OS_WIN
+    return share.toUncString();
+#else
+    return share.toSmbUrl(m_smbUsername);
+#endif
+}
+
+void MountPrewarmer::dispatch()
+{
+    while (!m_pending.isEmpty() && m_running < m_maxConcurrent)
+    {
+        start(m_pending.takeFirst());
+    }
+}
+
+void MountPrewarmer::start(const QString& targetUrl)
+{
+    ++m_running;
+
+    // No terminal to ask for credentials: a share that needs them fails instead of waiting
+    auto* process = new QProcess(this);
+    process->setStandardInputFile(QProcess::nullDevice());
+    process->setStandardOutputFile(QProcess::nullDevice());
+    process->setStandardErrorFile(QProcess::nullDevice());
+
+    connect(process, &QProcess::finished, this,
+            [this, process, targetUrl](int exitCode, QProcess::ExitStatus exitStatus)
+            { finish(process, targetUrl, exitStatus == QProcess::NormalExit && exitCode == 0); });
+    connect(process, &QProcess::errorOccurred, this,
+            [this, process, targetUrl](QProcess::ProcessError error)
+            {
+                if (error == QProcess::FailedToStart)
+                {
+                    finish(process, targetUrl, false);
+                }
+            });
+    QTimer::singleShot(MOUNT_TIMEOUT_MS, process, &QProcess::kill);
+
+    process->start(m_command->name(), m_command->argumentsFor(targetUrl));
+}
+
+void MountPrewarmer::finish(QProcess* process, const QString& targetUrl, bool success)
+{
+    process->disconnect(this);
+    process->deleteLater();
+    --m_running;
+
+    emit mountFinished(targetUrl, success);
+    dispatch();
+    if (m_running == 0 && m_pending.isEmpty())
+    {
+        emit idle();
+    }
+}
+
+} // namespace uncopener
@@ -0,0 +1,127 @@
+#ifndef UNCOPENER_MOUNTPREWARMER_HPP
+#define UNCOPENER_MOUNTPREWARMER_HPP
+
+#include "Config.hpp"
+#include "OpenerBackend.hpp"
+#include "ShareHistory.hpp"
+#include "UrlParser.hpp"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <utility>
+
+class QProcess;
+
+namespace uncopener
+{
+
+class MountIndex;
+
+/// Mounts shares in the background before they are opened
+/// The first open of a share in a session is the slowest, because gvfs negotiates and
+/// authenticates the SMB session first. The prewarmer runs a mount command ("gio mount" by
+/// default) for the most used shares at startup and for shares a link is about to open, e.g.
+/// on hover in the browser. At most a few commands run at once, and a share is requested at
+/// most once per TTL whether its mount succeeded or not, so file servers are not hammered.
+/// Shares the mount index already knows are skipped. Use from one thread with an event loop.
+class MountPrewarmer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Default number of mount commands running at once
+    static constexpr int DEFAULT_MAX_CONCURRENT = 2;
+
+    /// Default time in which a share is not requested again
+    static constexpr int DEFAULT_TTL_MS = 10 * 60 * 1000;
+
+    /// Maximum number of queued shares; further requests are dropped
+    static constexpr qsizetype MAX_PENDING = 32;
+
+    /// Time after which a mount command is killed
+    static constexpr int MOUNT_TIMEOUT_MS = 60000;
+
+    /// Prewarm with the command and SMB username of the configuration
+    explicit MountPrewarmer(const Config& config, QObject* parent = nullptr);
+
+    /// Run a command with the share as argument; nullptr disables prewarming
+    explicit MountPrewarmer(std::unique_ptr<CommandBackend> command, QString smbUsername = {},
+                            int maxConcurrent = DEFAULT_MAX_CONCURRENT,
+                            int ttlMs = DEFAULT_TTL_MS, QObject* parent = nullptr);
+
+    /// Kills mount commands that are still running
+    ~MountPrewarmer() override;
+
+    MountPrewarmer(const MountPrewarmer&) = delete;
+    MountPrewarmer& operator=(const MountPrewarmer&) = delete;
+    MountPrewarmer(MountPrewarmer&&) = delete;
+    MountPrewarmer& operator=(MountPrewarmer&&) = delete;
+
+    /// Get the mount command of a configuration: prewarmCommand if set, else "gio mount" on
+    /// Linux; nullptr on Windows, where UNC paths need no mount
+    [[nodiscard]] static std::unique_ptr<CommandBackend> commandFor(const Config& config);
+
+    /// Check if there is a mount command
+    [[nodiscard]] bool isEnabled() const { return m_command != nullptr; }
+
+    /// Skip shares that are mounted already (nullptr disables the check)
+    void setMountIndex(std::shared_ptr<MountIndex> mounts) { m_mounts = std::move(mounts); }
+
+    /// Mount the share of a path, using the monotonic clock for the TTL
+    /// Returns false if the request was dropped: no share, requested within the TTL, mounted
+    /// already, queue full, or prewarming disabled
+    bool request(const UncPath& path);
+
+    /// Mount the share of a path at a given time in milliseconds (monotonic, for tests)
+    bool request(const UncPath& path, qint64 nowMs);
+
+    /// Mount shares from the history, most used first
+    /// Returns the number of shares that were queued
+    int prewarm(const QList<ShareUse>& shares);
+
+    /// Get the target the mount command receives for a share
+    [[nodiscard]] QString targetFor(const UncPath& share) const;
+
+    /// Get the number of shares waiting for a free slot
+    [[nodiscard]] qsizetype pendingCount() const { return m_pending.size(); }
+
+    /// Get the number of mount commands running
+    [[nodiscard]] int runningCount() const { return m_running; }
+
+signals:
+    /// Emitted when a mount command ended; success is false if it failed or timed out
+    void mountFinished(const QString& targetUrl, bool success);
+
+    /// Emitted when the last mount command ended and no share is waiting
+    void idle();
+
+private:
+    /// Start queued mounts while slots are free
+    void dispatch();
+
+    /// Run the mount command for one target
+    void start(const QString& targetUrl);
+
+    /// Account for an ended mount command
+    void finish(QProcess* process, const QString& targetUrl, bool success);
+
+    std::unique_ptr<CommandBackend> m_command;
+    QString m_smbUsername;
+    int m_maxConcurrent;
+    int m_ttlMs;
+    std::shared_ptr<MountIndex> m_mounts;
+    QElapsedTimer m_clock;
+    QStringList m_pending; // Targets in request order
+    int m_running = 0;
+    QHash<QString, qint64> m_requested; // Case-folded target -> time it was last requested
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_MOUNTPREWARMER_HPP
@@ -0,0 +1,232 @@
+#include "NativeMessagingHost.hpp"
+
+#include "ResidentServer.hpp"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QJsonDocument>
+#include <QJsonValue>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstdio>
+
+#ifdef Q_OS_WIN
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace uncopener
+{
+
+namespace
+{
+
+const QString ACTION_OPEN = "open";
+const QString ACTION_VALIDATE = "validate";
+const QString ACTION_PREWARM = "prewarm";
+const QString ACTION_PING = "ping";
+
+/// Size of the length prefix in bytes
+constexpr qint64 HEADER_SIZE = 4;
+
+/// Oversized requests are skipped in chunks of this size
+constexpr qint64 SKIP_CHUNK_SIZE = 4096;
+
+/// Read exactly size bytes, waiting for more data if needed
+/// Returns false if the input ends first
+bool readExactly(QIODevice& input, char* data, qint64 size)
+{
+    qint64 done = 0;
+    while (done < size)
+    {
+        qint64 count = input.read(data + done, size - done);
+        if (count < 0 || (count == 0 && !input.waitForReadyRead(-1)))
+        {
+            return false;
+        }
+        done += count;
+    }
+    return true;
+}
+
+QJsonObject errorReply(const QString& reason, const QString& remediation)
+{
+    return {{"success", false}, {"reason", reason}, {"remediation", remediation}};
+}
+
+} // namespace
+
+NativeMessagingHost::NativeMessagingHost(const Config& config)
+    : m_opener(PathOpener::fromConfig(config)), m_prewarm(config.prewarm()),
+      m_residentServerName(ResidentServer::defaultServerName())
+{
+}
+
+bool NativeMessagingHost::isHostInvocation(const QStringList& arguments)
+{
+    // Chromium browsers pass the extension origin (and a window handle on Windows)
+    if (arguments.size() >= 2 && arguments.at(1).startsWith("chrome-extension://"))
+    {
+        return true;
+    }
+
+    // Firefox passes the path of the host manifest and the extension ID
+    return arguments.size() == 3 && arguments.at(1).endsWith(".json") &&
+           !arguments.at(1).contains("://") && QFileInfo::exists(arguments.at(1));
+}
+
+QJsonObject NativeMessagingHost::handle(const QByteArray& request)
+{
+    QJsonDocument document = QJsonDocument::fromJson(request);
+    if (!document.isObject())
+    {
+        return errorReply("Invalid request",
+                          "Send a JSON object with an \"action\" and a \"url\" member.");
+    }
+
+    QJsonObject object = document.object();
+    QString action = object.value("action").toString(ACTION_OPEN);
+    QJsonObject reply;
+
+    if (action == ACTION_PING)
+    {
+        reply = {{"success", true}, {"version", QCoreApplication::applicationVersion()}};
+    }
+    else if (action == ACTION_OPEN || action == ACTION_VALIDATE)
+    {
+        ValidationResult validation = m_opener.evaluateCached(object.value("url").toString());
+        OpenResult result =
+            action == ACTION_OPEN ? m_opener.open(validation) : validation.toOpenResult();
+        reply = result.success ? QJsonObject{{"success", true}}
+                               : errorReply(result.errorReason, result.errorRemediation);
+        reply.insert("target", validation.displayPath());
+    }
+    else if (action == ACTION_PREWARM)
+    {
+        QString url = object.value("url").toString();
+        ValidationResult validation = m_opener.evaluateCached(url);
+        reply = prewarm(url, validation);
+        reply.insert("target", validation.displayPath());
+    }
+    else
+    {
+        reply = errorReply(QString("Unknown action \"%1\"").arg(action),
+                           "Use one of the actions \"open\", \"validate\", \"prewarm\" or "
+                           "\"ping\".");
+    }
+
+    // Let the extension match replies to requests
+    if (object.contains("id"))
+    {
+        reply.insert("id", object.value("id"));
+    }
+    return reply;
+}
+
+QJsonObject NativeMessagingHost::prewarm(const QString& url,
+                                         const ValidationResult& validation) const
+{
+    // Only shares the policy allows are ever mounted
+    OpenResult result = validation.toOpenResult();
+    if (!result.success)
+    {
+        return errorReply(result.errorReason, result.errorRemediation);
+    }
+
+    if (!m_prewarm)
+    {
+        return errorReply("Prewarming is disabled",
+                          "Set \"prewarm\" to true in the UncOpener configuration.");
+    }
+
+    // Mounts outlive single requests, so they run in the resident instance
+    if (!ResidentServer::forwardPrewarm(m_residentServerName, {url}))
+    {
+        return errorReply("No resident instance is running",
+                          "Prewarming runs in the resident instance. Enable resident mode or "
+                          "start UncOpener with --resident.");
+    }
+    return {{"success", true}};
+}
+
+int NativeMessagingHost::serve(QIODevice& input, QIODevice& output)
+{
+    int count = 0;
+    while (std::optional<QByteArray> request = readMessage(input))
+    {
+        if (!writeMessage(output, handle(*request)))
+        {
+            break;
+        }
+        ++count;
+    }
+    return count;
+}
+
+bool NativeMessagingHost::openStdio(QFile& input, QFile& output)
+{
+#ifdef Q_OS_WIN
+    // Length prefixes are binary, so disable newline translation
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    return input.open(stdin, QIODevice::ReadOnly | QIODevice::Unbuffered) &&
+           output.open(stdout, QIODevice::WriteOnly | QIODevice::Unbuffered);
+}
+
+std::optional<QByteArray> NativeMessagingHost::readMessage(QIODevice& input)
+{
+    char header[HEADER_SIZE] = {};
+    if (!readExactly(input, header, HEADER_SIZE))
+    {
+        return std::nullopt;
+    }
+
+    const quint32 length = qFromUnaligned<quint32>(header);
+    if (length > MAX_REQUEST_SIZE)
+    {
+        // Skip the message to stay in sync with the stream
+        char chunk[SKIP_CHUNK_SIZE] = {};
+        qint64 remaining = length;
+        while (remaining > 0)
+        {
+            qint64 count = std::min(remaining, SKIP_CHUNK_SIZE);
+            if (!readExactly(input, chunk, count))
+            {
+                return std::nullopt;
+            }
+            remaining -= count;
+        }
+        return QByteArray();
+    }
+
+    QByteArray message(static_cast<qsizetype>(length), Qt::Uninitialized);
+    if (!readExactly(input, message.data(), length))
+    {
+        return std::nullopt;
+    }
+    return message;
+}
+
+bool NativeMessagingHost::writeMessage(QIODevice& output, const QJsonObject& message)
+{
+    QByteArray json = QJsonDocument(message).toJson(QJsonDocument::Compact);
+
+    char header[HEADER_SIZE] = {};
+    qToUnaligned(static_cast<quint32>(json.size()), header);
+    bool written = output.write(header, HEADER_SIZE) == HEADER_SIZE &&
+                   output.write(json) == json.size();
+
+    // The browser waits for the reply, so it must not stay in a stdio buffer
+    if (auto* file = qobject_cast<QFileDevice*>(&output))
+    {
+        written = file->flush() && written;
+    }
+    return written;
+}
+
+} // namespace uncopener
@@ -0,0 +1,83 @@
+#ifndef UNCOPENER_NATIVEMESSAGINGHOST_HPP
+#define UNCOPENER_NATIVEMESSAGINGHOST_HPP
+
+#include "Config.hpp"
+#include "PathOpener.hpp"
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QStringList>
+
+#include <optional>
+
+class QFile;
+class QIODevice;
+
+namespace uncopener
+{
+
+/// Browser native messaging host
+/// The browser starts the host once per session and exchanges JSON messages over its stdin and
+/// stdout, each prefixed by its length as 32-bit unsigned integer in native byte order. All
+/// requests go through one PathOpener, so neither a process nor the config is loaded per click.
+///
+/// Requests:  {"id": <any>, "action": "open" | "validate" | "prewarm" | "ping",
+///             "url": "<scheme URL>"}
+///            "action" defaults to "open"; "id" is echoed in the reply. "prewarm" (e.g. on
+///            hover) validates the URL and asks the resident instance to mount its share.
+/// Replies:   {"id": <any>, "success": true, "target": "<UNC path>"}
+///            {"id": <any>, "success": false, "reason": "...", "remediation": "...",
+///             "target": "<UNC path or URL>"}
+class NativeMessagingHost
+{
+public:
+    /// Largest accepted request in bytes; larger requests are skipped and answered with an error
+    static constexpr quint32 MAX_REQUEST_SIZE = 64 * 1024;
+
+    explicit NativeMessagingHost(const Config& config);
+
+    /// Get the opener all requests go through, with the collaborators the config asks for
+    [[nodiscard]] const PathOpener& opener() const { return m_opener; }
+
+    /// Get/set the resident instance prewarm requests are forwarded to
+    [[nodiscard]] QString residentServerName() const { return m_residentServerName; }
+    void setResidentServerName(const QString& name) { m_residentServerName = name; }
+
+    /// Check if the command line arguments are those of a browser starting a native messaging
+    /// host: the extension origin for Chromium browsers, the manifest path and extension ID
+    /// for Firefox
+    [[nodiscard]] static bool isHostInvocation(const QStringList& arguments);
+
+    /// Handle one request message and build the reply
+    [[nodiscard]] QJsonObject handle(const QByteArray& request);
+
+    /// Answer requests until the input ends
+    /// Returns the number of requests handled
+    int serve(QIODevice& input, QIODevice& output);
+
+    /// Open stdin and stdout for messages: binary, and unbuffered so a read returns as soon as
+    /// the requested bytes have arrived
+    [[nodiscard]] static bool openStdio(QFile& input, QFile& output);
+
+    /// Read one length-prefixed message
+    /// Returns an empty optional at the end of the input; oversized messages are skipped and
+    /// returned as an empty array
+    [[nodiscard]] static std::optional<QByteArray> readMessage(QIODevice& input);
+
+    /// Write one length-prefixed message
+    /// Returns false if the message could not be written completely
+    static bool writeMessage(QIODevice& output, const QJsonObject& message);
+
+private:
+    /// Forward a URL to the resident instance for prewarming, if its validation allows it
+    [[nodiscard]] QJsonObject prewarm(const QString& url,
+                                      const ValidationResult& validation) const;
+
+    PathOpener m_opener;
+    bool m_prewarm;
+    QString m_residentServerName;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_NATIVEMESSAGINGHOST_HPP
@@ -0,0 +1,318 @@
+#include "OpenerBackend.hpp"
+
+#ifdef UNCOPENER_HAS_DBUS
+#include "FileManagerBackend.hpp"
+#endif
+
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QThread>
+
+#ifdef Q_OS_WIN
+#include <qt_windows.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include <cerrno>
+#include <thread>
+#include <vector>
+
+extern char** environ; // NOLINT(readability-redundant-declaration): not declared by all libcs
+#endif
+
+#include <algorithm>
+#include <utility>
+
+namespace uncopener
+{
+
+namespace
+{
+
+/// Interval of checking whether a helper has exited
+constexpr unsigned long EXIT_POLL_MS = 5;
+
+qint64 elapsedUs(const QElapsedTimer& timer)
+{
+    return timer.nsecsElapsed() / 1000;
+}
+
+OpenResult notStartedError(const QString& program)
+{
+    return OpenResult::error(
+        QString("Failed to start %1").arg(program),
+        "Make sure the program is installed, or choose another opener in the configuration.");
+}
+
+OpenResult exitError(const QString& program, int exitStatus)
+{
+    QString reason = exitStatus == OpenerBackend::EXIT_CRASHED
+                         ? QString("%1 terminated unexpectedly").arg(program)
+                         : QString("%1 failed to open the path (exit status %2)")
+                               .arg(program, QString::number(exitStatus));
+    return OpenResult::error(
+        reason, "Make sure you have access to the network location and a suitable application "
+                "is configured to handle it.");
+}
+
+} // namespace
+
+template<typename Launch>
+OpenResult OpenerBackend::record(const QString& targetUrl, Launch launchTarget)
+{
+    OpenOutcome outcome;
+    outcome.targetUrl = targetUrl;
+
+    QElapsedTimer timer;
+    timer.start();
+    outcome.result = launchTarget(outcome);
+    outcome.totalLatencyUs = elapsedUs(timer);
+
+    QMutexLocker locker(&m_mutex);
+    ++m_stats.attempts;
+    if (!outcome.result.success)
+    {
+        ++m_stats.failures;
+    }
+    m_stats.totalSpawnLatencyUs += outcome.spawnLatencyUs;
+    m_stats.maxSpawnLatencyUs = std::max(m_stats.maxSpawnLatencyUs, outcome.spawnLatencyUs);
+    m_lastOutcome = outcome;
+    return outcome.result;
+}
+
+OpenResult OpenerBackend::open(const QString& targetUrl)
+{
+    return record(targetUrl,
+                  [this, &targetUrl](OpenOutcome& outcome) { return launch(targetUrl, outcome); });
+}
+
+OpenResult OpenerBackend::reveal(const QStringList& targetUrls)
+{
+    if (targetUrls.isEmpty())
+    {
+        return OpenResult::ok();
+    }
+    return record(targetUrls.first(), [this, &targetUrls](OpenOutcome& outcome)
+                  { return launchSelection(targetUrls, outcome); });
+}
+
+OpenResult OpenerBackend::launchSelection(const QStringList& targetUrls, OpenOutcome& outcome)
+{
+    for (const QString& targetUrl : targetUrls)
+    {
+        OpenResult result = launch(targetUrl, outcome);
+        if (!result.success)
+        {
+            return result;
+        }
+    }
+    return OpenResult::ok();
+}
+
+OpenOutcome OpenerBackend::lastOutcome() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_lastOutcome;
+}
+
+OpenerStats OpenerBackend::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
+
+std::shared_ptr<OpenerBackend> OpenerBackend::create(const Config& config)
+{
+    switch (config.opener())
+    {
+    case OpenerKind::Command:
+        if (std::shared_ptr<OpenerBackend> backend =
+                CommandBackend::fromCommandLine(config.openerCommand()))
+        {
+            return backend;
+        }
+        break;
+#ifndef Q_OS_WIN
+    case OpenerKind::Gio:
+        return CommandBackend::gioOpen();
+    case OpenerKind::XdgOpen:
+        return CommandBackend::xdgOpen();
+#endif
+#ifdef UNCOPENER_HAS_DBUS
+    case OpenerKind::FileManager:
+        return std::make_shared<FileManagerBackend>();
+#endif
+    default:
+        break;
+    }
+    return std::make_shared<DesktopServicesBackend>();
+}
+
+std::shared_ptr<OpenerBackend> OpenerBackend::createRevealer(const Config& config)
+{
+#ifdef UNCOPENER_HAS_DBUS
+    if (!config.revealFiletypes().isEmpty())
+    {
+        return std::make_shared<FileManagerBackend>();
+    }
+#else
+    static_cast<void>(config);
+#endif
+    return nullptr;
+}
+
+OpenResult DesktopServicesBackend::launch(const QString& targetUrl, OpenOutcome& outcome)
+{
+    QElapsedTimer timer;
+    timer.start();
+    OpenResult result = PathOpener::openTarget(targetUrl);
+    outcome.spawnLatencyUs = elapsedUs(timer);
+    outcome.exitStatus = result.success ? 0 : 1;
+    return result;
+}
+
+CommandBackend::CommandBackend(QString program, QStringList arguments)
+    : m_program(std::move(program)), m_arguments(std::move(arguments))
+{
+}
+
+std::unique_ptr<CommandBackend> CommandBackend::fromCommandLine(const QString& command)
+{
+    QStringList parts = QProcess::splitCommand(command);
+    if (parts.isEmpty())
+    {
+        return nullptr;
+    }
+    QString program = parts.takeFirst();
+    return std::make_unique<CommandBackend>(program, parts);
+}
+
+std::unique_ptr<CommandBackend> CommandBackend::gioOpen()
+{
+    return std::make_unique<CommandBackend>("gio", QStringList{"open"});
+}
+
+std::unique_ptr<CommandBackend> CommandBackend::xdgOpen()
+{
+    return std::make_unique<CommandBackend>("xdg-open", QStringList{});
+}
+
+QStringList CommandBackend::argumentsFor(const QString& targetUrl) const
+{
+    QStringList arguments = m_arguments;
+    if (!arguments.contains(TARGET_PLACEHOLDER))
+    {
+        arguments.append(targetUrl);
+        return arguments;
+    }
+    std::replace(arguments.begin(), arguments.end(), QString(TARGET_PLACEHOLDER), targetUrl);
+    return arguments;
+}
+
+#ifdef Q_OS_WIN
+OpenResult CommandBackend::launch(const QString& targetUrl, OpenOutcome& outcome)
+{
+    // Started detached, as a QProcess would kill a helper that is still running when it goes
+    QElapsedTimer timer;
+    timer.start();
+    qint64 pid = 0;
+    bool started = QProcess::startDetached(m_program, argumentsFor(targetUrl), {}, &pid);
+    outcome.spawnLatencyUs = elapsedUs(timer);
+    if (!started)
+    {
+        outcome.exitStatus = EXIT_NOT_STARTED;
+        return notStartedError(m_program);
+    }
+
+    // A helper that is gone before it could be opened has exited too early to be checked
+    HANDLE process = OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE,
+                                 static_cast<DWORD>(pid));
+    if (process == nullptr)
+    {
+        outcome.exitStatus = 0;
+        return OpenResult::ok();
+    }
+
+    DWORD exitCode = 0;
+    bool exited = WaitForSingleObject(process, static_cast<DWORD>(m_exitWaitMs)) == WAIT_OBJECT_0 &&
+                  GetExitCodeProcess(process, &exitCode) != 0;
+    CloseHandle(process);
+    if (!exited)
+    {
+        outcome.exitStatus = EXIT_RUNNING;
+        return OpenResult::ok();
+    }
+
+    outcome.exitStatus = static_cast<int>(exitCode);
+    return outcome.exitStatus == 0 ? OpenResult::ok() : exitError(m_program, outcome.exitStatus);
+}
+#else
+OpenResult CommandBackend::launch(const QString& targetUrl, OpenOutcome& outcome)
+{
+    // posix_spawnp needs a null-terminated array of mutable C strings
+    std::vector<QByteArray> encoded;
+    encoded.push_back(m_program.toLocal8Bit());
+    for (const QString& argument : argumentsFor(targetUrl))
+    {
+        encoded.push_back(argument.toLocal8Bit());
+    }
+    std::vector<char*> argv;
+    argv.reserve(encoded.size() + 1);
+    for (QByteArray& argument : encoded)
+    {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+
+    QElapsedTimer timer;
+    timer.start();
+    pid_t pid = 0;
+    int error = posix_spawnp(&pid, argv.front(), nullptr, nullptr, argv.data(), environ);
+    outcome.spawnLatencyUs = elapsedUs(timer);
+    if (error != 0)
+    {
+        outcome.exitStatus = EXIT_NOT_STARTED;
+        return notStartedError(m_program);
+    }
+
+    int status = 0;
+    QElapsedTimer waited;
+    waited.start();
+    for (;;)
+    {
+        pid_t exited = waitpid(pid, &status, WNOHANG);
+        if (exited == pid)
+        {
+            break;
+        }
+        if (exited < 0 && errno != EINTR)
+        {
+            outcome.exitStatus = EXIT_CRASHED;
+            return exitError(m_program, outcome.exitStatus);
+        }
+        if (waited.hasExpired(m_exitWaitMs))
+        {
+            // Still showing the target: reap it whenever it ends, so it leaves no zombie
+            std::thread(
+                [pid]()
+                {
+                    int ignored = 0;
+                    while (waitpid(pid, &ignored, 0) < 0 && errno == EINTR)
+                    {
+                    }
+                })
+                .detach();
+            outcome.exitStatus = EXIT_RUNNING;
+            return OpenResult::ok();
+        }
+        QThread::msleep(EXIT_POLL_MS);
+    }
+
+    outcome.exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : EXIT_CRASHED;
+    return outcome.exitStatus == 0 ? OpenResult::ok() : exitError(m_program, outcome.exitStatus);
+}
+#endif
+
+} // namespace uncopener
@@ -0,0 +1,165 @@
+#ifndef UNCOPENER_OPENERBACKEND_HPP
+#define UNCOPENER_OPENERBACKEND_HPP
+
+#include "Config.hpp"
+#include "PathOpener.hpp"
+
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+namespace uncopener
+{
+
+/// What happened when a backend handed one target to its helper
+struct OpenOutcome
+{
+    QString targetUrl;
+    qint64 spawnLatencyUs = 0; // Until the helper was started or the call was sent
+    qint64 totalLatencyUs = 0; // Until the helper exited or the call returned
+    int exitStatus = 0;        // Exit code of the helper, or one of the OpenerBackend::EXIT_*
+    OpenResult result;
+};
+
+/// Counters of an OpenerBackend since construction
+struct OpenerStats
+{
+    qint64 attempts = 0;
+    qint64 failures = 0;
+    qint64 totalSpawnLatencyUs = 0;
+    qint64 maxSpawnLatencyUs = 0;
+};
+
+/// Program that opens validated targets, behind PathOpener and AsyncOpener
+/// Unlike QDesktopServices alone, a backend reports which helper ran and how it ended, so a
+/// file manager that fails after starting is reported instead of counted as success.
+/// open() may be called from several threads at once unless isThreadSafe() says otherwise.
+class OpenerBackend
+{
+public:
+    /// The helper could not be started
+    static constexpr int EXIT_NOT_STARTED = -1;
+
+    /// The helper was terminated by a signal
+    static constexpr int EXIT_CRASHED = -2;
+
+    /// The helper was still running when the backend stopped waiting; counts as success
+    static constexpr int EXIT_RUNNING = -3;
+
+    OpenerBackend() = default;
+    virtual ~OpenerBackend() = default;
+
+    OpenerBackend(const OpenerBackend&) = delete;
+    OpenerBackend& operator=(const OpenerBackend&) = delete;
+    OpenerBackend(OpenerBackend&&) = delete;
+    OpenerBackend& operator=(OpenerBackend&&) = delete;
+
+    /// Get a short name of the helper for messages
+    [[nodiscard]] virtual QString name() const = 0;
+
+    /// Check if open() and reveal() may be called from any thread
+    /// AsyncOpener calls backends that are not on the thread it lives in.
+    [[nodiscard]] virtual bool isThreadSafe() const { return true; }
+
+    /// Open a target built by PathOpener::buildTargetUrl() and record the outcome
+    [[nodiscard]] OpenResult open(const QString& targetUrl);
+
+    /// Show targets of files in one folder selected in the file manager and record the outcome
+    /// as one attempt; the outcome names the first target
+    [[nodiscard]] OpenResult reveal(const QStringList& targetUrls);
+
+    /// Get the outcome of the most recent open() or reveal()
+    [[nodiscard]] OpenOutcome lastOutcome() const;
+
+    /// Get the attempt, failure and latency counters
+    [[nodiscard]] OpenerStats stats() const;
+
+    /// Create the backend selected in a config
+    /// Backends that do not exist on this platform fall back to the desktop default
+    [[nodiscard]] static std::shared_ptr<OpenerBackend> create(const Config& config);
+
+    /// Create the backend that shows the reveal filetypes of a config selected in their folder
+    /// Returns nullptr if the config reveals nothing or the platform has no such backend
+    [[nodiscard]] static std::shared_ptr<OpenerBackend> createRevealer(const Config& config);
+
+protected:
+    /// Hand the target to the helper and wait until it is done (or shows the target)
+    /// Sets spawnLatencyUs and exitStatus of outcome and returns the result
+    virtual OpenResult launch(const QString& targetUrl, OpenOutcome& outcome) = 0;
+
+    /// Hand targets of one folder to the helper to show them selected
+    /// The default launches each target in turn and stops at the first failure
+    virtual OpenResult launchSelection(const QStringList& targetUrls, OpenOutcome& outcome);
+
+private:
+    /// Time a call of the helper and count it in the stats
+    template<typename Launch>
+    OpenResult record(const QString& targetUrl, Launch launchTarget);
+
+    mutable QMutex m_mutex;
+    OpenOutcome m_lastOutcome;
+    OpenerStats m_stats;
+};
+
+/// Opens through QDesktopServices, see PathOpener::openTarget()
+/// There is no helper process; the exit status is 0 on success and 1 otherwise.
+class DesktopServicesBackend : public OpenerBackend
+{
+public:
+    [[nodiscard]] QString name() const override { return "desktop services"; }
+
+    /// QDesktopServices may only be used from the GUI thread
+    [[nodiscard]] bool isThreadSafe() const override { return false; }
+
+protected:
+    OpenResult launch(const QString& targetUrl, OpenOutcome& outcome) override;
+};
+
+/// Runs a command with the target as argument and waits a moment for it to exit
+/// Processes are started directly with posix_spawn (QProcess on Windows), without a shell.
+/// A helper that fails fails at once, so its exit status is awaited for a short time only; one
+/// that is still running then (e.g. xdg-open waiting for the viewer to close) shows the target
+/// and is left to run, so it does not keep a worker busy.
+class CommandBackend : public OpenerBackend
+{
+public:
+    /// Argument replaced by the target; without it the target is appended
+    static constexpr const char* TARGET_PLACEHOLDER = "%u";
+
+    /// Default longest time to wait for the exit status of the helper
+    static constexpr int DEFAULT_EXIT_WAIT_MS = 3000;
+
+    /// Run a program with fixed arguments
+    CommandBackend(QString program, QStringList arguments);
+
+    /// Split a command line like "nautilus --new-window %u" into program and arguments
+    [[nodiscard]] static std::unique_ptr<CommandBackend> fromCommandLine(const QString& command);
+
+    /// Run "gio open"
+    [[nodiscard]] static std::unique_ptr<CommandBackend> gioOpen();
+
+    /// Run "xdg-open"
+    [[nodiscard]] static std::unique_ptr<CommandBackend> xdgOpen();
+
+    [[nodiscard]] QString name() const override { return m_program; }
+
+    /// Get the arguments for a target
+    [[nodiscard]] QStringList argumentsFor(const QString& targetUrl) const;
+
+    /// Set the longest time to wait for the exit status of the helper
+    void setExitWait(int exitWaitMs) { m_exitWaitMs = exitWaitMs; }
+
+protected:
+    OpenResult launch(const QString& targetUrl, OpenOutcome& outcome) override;
+
+private:
+    QString m_program;
+    QStringList m_arguments;
+    int m_exitWaitMs = DEFAULT_EXIT_WAIT_MS;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_OPENERBACKEND_HPP
@@ -1,14 +1,69 @@
 #include "PathOpener.hpp"
 
+#include "DecisionCache.hpp"
+#include "MountIndex.hpp"
+#include "OpenerBackend.hpp"
+#include "ReachabilityProbe.hpp"
+#include "ShareHistory.hpp"
+
 #include <QDesktopServices>
+#include <QDir>
 #include <QUrl>
 
+#include <memory>
+#include <utility>
+
 namespace uncopener
 {
 
-PathOpener::PathOpener(const Config& config) : m_config(config), m_parser(config.schemeName())
+QString ValidationResult::displayPath() const
+{
+    return isSuccess(parse) ? getPath(parse).toUncString() : getError(parse).input;
+}
+
+OpenResult ValidationResult::toOpenResult() const
 {
-    config.applyTo(m_policy);
+    if (isError(parse))
+    {
+        return OpenResult::fromParseError(getError(parse));
+    }
+    if (!policy.allowed)
+    {
+        return OpenResult::fromPolicyResult(policy);
+    }
+    return OpenResult::ok();
+}
+
+PathOpener::PathOpener(const Config& config) : PathOpener(CompiledPolicy::compile(config)) {}
+
+PathOpener::PathOpener(std::shared_ptr<const CompiledPolicy> policy) : m_policy(std::move(policy))
+{
+}
+
+PathOpener PathOpener::fromConfig(const Config& config)
+{
+    PathOpener opener(config);
+    opener.setBackend(OpenerBackend::create(config));
+    opener.setRevealBackend(OpenerBackend::createRevealer(config));
+#ifndef Q_OS_WIN
+    // UNC paths open directly on Windows
+    if (config.preferLocalMounts())
+    {
+        opener.setMountIndex(std::make_shared<MountIndex>());
+    }
+#endif
+    if (config.probeServers())
+    {
+        opener.setReachabilityProbe(std::make_shared<ReachabilityProbe>(config));
+    }
+    if (config.prewarm())
+    {
+        // Counted for the resident instance, which mounts the most used shares at startup
+        auto history = std::make_shared<ShareHistory>();
+        history->load();
+        opener.setShareHistory(history);
+    }
+    return opener;
 }
 
 QString PathOpener::buildTargetUrl(const UncPath& path) const
@@ -18,7 +73,18 @@ QString PathOpener::buildTargetUrl(const UncPath& path) const
     return path.toUncString();
 #else
     // Linux: build SMB URL
-    return path.toSmbUrl(m_config.smbUsername());
+    return path.toSmbUrl(m_policy->config().smbUsername());
+#endif
+}
+
+QString PathOpener::buildLocalTarget(const QString& localPath)
+{
+#ifdef Q_OS_WIN
+    // Windows: open the path like a UNC path, see openUrl()
+    return QDir::toNativeSeparators(localPath);
+#else
+    // Linux: build a file URL
+    return QUrl::fromLocalFile(localPath).toString(QUrl::FullyEncoded);
 #endif
 }
 
@@ -34,58 +100,177 @@ bool PathOpener::openUrl(const QString& url)
 #endif
 }
 
-OpenResult PathOpener::validate(const QString& url) const
+ValidationResult PathOpener::evaluate(const QString& url) const
 {
-    // Parse the URL
-    ParseResult parseResult = m_parser.parse(url);
-    if (isError(parseResult))
+    // Same verdict as the decision filter, see CompiledPolicy::decide(); the target only sees
+    // the canonical server name
+    UrlVerdict verdict = m_policy->decide(url);
+    ValidationResult result;
+    if (verdict.parseError)
+    {
+        result.parse = m_policy->parser().createError(*verdict.parseError, url);
+        return result;
+    }
+    result.parse = verdict.path;
+    result.policy = verdict.policy.toCheckResult();
+    if (result.policy.allowed)
     {
-        return OpenResult::fromParseError(getError(parseResult));
+        buildTarget(result);
     }
+    return result;
+}
+
+void PathOpener::buildTarget(ValidationResult& result) const
+{
+    const UncPath& path = getPath(result.parse);
+    result.reveal = m_policy->reveals(path);
 
-    m_lastPath = getPath(parseResult);
+    // Fixed translations to local paths take precedence over the network target
+    const PathTranslator& translator = m_policy->translator();
+    qsizetype translation = translator.matchIndex(path);
+    if (translation == CaseFoldedTrie::NO_MATCH)
+    {
+        result.targetUrl = buildTargetUrl(path);
+        return;
+    }
+    result.translation = translator.rules().at(translation).uncPrefix;
+    QString localPath = translator.localPath(path, translation);
+    if (localPath.isEmpty())
+    {
+        // The parser rejects such paths already; never fall back to the bare local root
+        result.policy = PolicyCheckResult::deny(
+            "Path leaves the translated folder",
+            "Paths with '.' or '..' segments cannot be opened through a path translation.",
+            result.translation);
+        return;
+    }
+    result.targetUrl = buildLocalTarget(localPath);
+}
 
-    // Check against UNC allow-list (always check against UNC form)
-    QString uncPath = m_lastPath.toUncString();
-    PolicyCheckResult uncResult = m_policy.uncAllowList().check(uncPath);
-    if (!uncResult.allowed)
+ValidationResult PathOpener::evaluateCached(const QString& url) const
+{
+    if (m_cache == nullptr)
     {
-        return OpenResult::fromPolicyResult(uncResult);
+        return evaluate(url);
     }
 
-    // Check filetype policy
-    PolicyCheckResult filetypeResult = m_policy.check(uncPath);
-    if (!filetypeResult.allowed)
+    UncPath path;
+    bool parsed = !m_policy->parser().parse(url, path);
+    if (parsed)
     {
-        return OpenResult::fromPolicyResult(filetypeResult);
+        m_policy->aliases().canonicalize(path);
     }
+    QString key = parsed ? DecisionCache::keyOf(path) : DecisionCache::keyOf(url);
 
-    return OpenResult::ok();
+    const ValidationResult* cached = m_cache->find(key, m_policy->generation());
+    if (cached == nullptr)
+    {
+        ValidationResult result = evaluate(url);
+        m_cache->insert(key, m_policy->generation(), result);
+        return result;
+    }
+    if (!parsed)
+    {
+        return *cached;
+    }
+
+    const UncPath& cachedPath = getPath(cached->parse);
+    if (cachedPath.server == path.server && cachedPath.path == path.path &&
+        cachedPath.hasTrailingSlash == path.hasTrailingSlash)
+    {
+        return *cached;
+    }
+
+    // Another spelling of the cached path shares its verdict, but keeps its own target: the
+    // folder of a path translation may be case-sensitive
+    ValidationResult result;
+    result.parse = path;
+    result.policy = cached->policy;
+    if (result.policy.allowed)
+    {
+        buildTarget(result);
+    }
+    return result;
 }
 
-QString PathOpener::getTargetPath(const QString& url) const
+OpenResult PathOpener::open(const QString& url)
 {
-    OpenResult result = validate(url);
-    if (!result.success)
+    // First validate and build the target URL for this platform
+    return open(evaluateCached(url));
+}
+
+OpenResult PathOpener::open(const ValidationResult& result)
+{
+    if (!result.allowed())
+    {
+        return result.toOpenResult();
+    }
+
+    // Attempt to open it, through the local mount point if the share is mounted; a server that
+    // is down fails here instead of hanging the file manager
+    QString target = resolveTarget(result);
+    OpenResult opened = preflight(result.path().server, target);
+    if (opened.success)
+    {
+        opened = result.reveal ? reveal({target}) : launch(target);
+    }
+    if (opened.success)
     {
-        return {};
+        recordOpen(result.path());
     }
-    return buildTargetUrl(m_lastPath);
+    return opened;
 }
 
-OpenResult PathOpener::open(const QString& url)
+QString PathOpener::resolveTarget(const ValidationResult& result) const
+{
+    if (!m_mounts || !result.allowed() || !result.translation.isEmpty())
+    {
+        return result.targetUrl;
+    }
+
+    m_mounts->refresh();
+    QString localUrl = m_mounts->localUrl(result.path());
+    return localUrl.isEmpty() ? result.targetUrl : localUrl;
+}
+
+void PathOpener::recordOpen(const UncPath& path) const
 {
-    // First validate
-    OpenResult validationResult = validate(url);
-    if (!validationResult.success)
+    if (m_history)
     {
-        return validationResult;
+        m_history->record(path);
     }
+}
 
-    // Build the target URL for this platform
-    QString targetUrl = buildTargetUrl(m_lastPath);
+OpenResult PathOpener::preflight(const QString& server, const QString& targetUrl) const
+{
+    return m_probe ? m_probe->preflight(server, targetUrl) : OpenResult::ok();
+}
+
+OpenResult PathOpener::launch(const QString& targetUrl) const
+{
+    return m_backend ? m_backend->open(targetUrl) : openTarget(targetUrl);
+}
 
-    // Attempt to open
+OpenResult PathOpener::reveal(const QStringList& targetUrls) const
+{
+    if (m_revealBackend)
+    {
+        return m_revealBackend->reveal(targetUrls);
+    }
+
+    for (const QString& targetUrl : targetUrls)
+    {
+        OpenResult result = launch(targetUrl);
+        if (!result.success)
+        {
+            return result;
+        }
+    }
+    return OpenResult::ok();
+}
+
+OpenResult PathOpener::openTarget(const QString& targetUrl)
+{
     if (!openUrl(targetUrl))
     {
         return OpenResult::error(
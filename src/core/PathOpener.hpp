@@ -1,11 +1,16 @@
 #ifndef UNCOPENER_PATHOPENER_HPP
 #define UNCOPENER_PATHOPENER_HPP
 
+#include "CompiledPolicy.hpp"
 #include "Config.hpp"
 #include "SecurityPolicy.hpp"
 #include "UrlParser.hpp"
 
 #include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <utility>
 
 namespace uncopener
 {
@@ -35,39 +40,162 @@ struct OpenResult
     }
 };
 
+/// Everything known about a URL after validation, as one value without hidden state
+struct ValidationResult
+{
+    ParseResult parse;        // The parsed UNC path, or why the URL was rejected
+    PolicyCheckResult policy; // Allow-list and filetype verdict; not allowed if parsing failed
+    QString targetUrl;        // Platform-specific target; empty unless allowed
+    QString translation;      // UNC prefix of the path translation that built the target
+    bool reveal = false;      // Show the file selected in its folder instead of opening it
+
+    /// Check if the URL parsed and the policy allows it
+    [[nodiscard]] bool allowed() const { return isSuccess(parse) && policy.allowed; }
+
+    /// Get the parsed path, or an empty path if the URL did not parse
+    [[nodiscard]] UncPath path() const { return isSuccess(parse) ? getPath(parse) : UncPath(); }
+
+    /// Get a displayable form: the UNC path if the URL parsed, else the URL
+    [[nodiscard]] QString displayPath() const;
+
+    /// Get the outcome in the form open() reports it
+    [[nodiscard]] OpenResult toOpenResult() const;
+};
+
+class DecisionCache;
+class MountIndex;
+class OpenerBackend;
+class ReachabilityProbe;
+class ShareHistory;
+
 /// Handles opening UNC paths on different platforms
+/// evaluate() only reads the immutable policy snapshot; all other calls may use the decision
+/// cache, so an opener serves one thread unless only evaluate() is used
 class PathOpener
 {
 public:
     explicit PathOpener(const Config& config);
 
-    /// Parse and validate a URL, then open it
+    /// Validate against a shared snapshot instead of compiling the config again
+    explicit PathOpener(std::shared_ptr<const CompiledPolicy> policy);
+
+    /// Build an opener with the backends, mount index, probe and share history the config asks
+    /// for, as a process that opens a single request needs it
+    [[nodiscard]] static PathOpener fromConfig(const Config& config);
+
+    /// Get the snapshot this opener validates against
+    [[nodiscard]] const std::shared_ptr<const CompiledPolicy>& policy() const { return m_policy; }
+
+    /// Serve repeated URLs from a cache of validation results (nullptr disables caching)
+    /// The cache must outlive the opener
+    void setDecisionCache(DecisionCache* cache) { m_cache = cache; }
+
+    /// Open targets through a backend instead of QDesktopServices (nullptr restores the default)
+    void setBackend(std::shared_ptr<OpenerBackend> backend) { m_backend = std::move(backend); }
+
+    /// Get the backend targets are opened with (nullptr for QDesktopServices)
+    [[nodiscard]] const std::shared_ptr<OpenerBackend>& backend() const { return m_backend; }
+
+    /// Show revealed files through a backend that selects them in their folder (nullptr opens
+    /// them like other targets), see OpenerBackend::reveal()
+    void setRevealBackend(std::shared_ptr<OpenerBackend> backend)
+    {
+        m_revealBackend = std::move(backend);
+    }
+
+    /// Get the backend revealed files are shown with (nullptr if they are opened)
+    [[nodiscard]] const std::shared_ptr<OpenerBackend>& revealBackend() const
+    {
+        return m_revealBackend;
+    }
+
+    /// Open paths on locally mounted shares through their mount point (nullptr disables it)
+    void setMountIndex(std::shared_ptr<MountIndex> mounts) { m_mounts = std::move(mounts); }
+
+    /// Get the index of local mounts (nullptr if disabled)
+    [[nodiscard]] const std::shared_ptr<MountIndex>& mountIndex() const { return m_mounts; }
+
+    /// Check that the server is reachable before a network target is opened (nullptr disables it)
+    void setReachabilityProbe(std::shared_ptr<ReachabilityProbe> probe)
+    {
+        m_probe = std::move(probe);
+    }
+
+    /// Get the probe servers are checked with (nullptr if disabled)
+    [[nodiscard]] const std::shared_ptr<ReachabilityProbe>& reachabilityProbe() const
+    {
+        return m_probe;
+    }
+
+    /// Count the shares of opened paths for prewarming (nullptr disables it)
+    void setShareHistory(std::shared_ptr<ShareHistory> history) { m_history = std::move(history); }
+
+    /// Get the history opened shares are counted in (nullptr if disabled)
+    [[nodiscard]] const std::shared_ptr<ShareHistory>& shareHistory() const { return m_history; }
+
+    /// Parse and validate a URL, then open it (or reveal it, see ValidationResult::reveal)
     /// Returns the result of the operation
     [[nodiscard]] OpenResult open(const QString& url);
 
-    /// Parse and validate a URL without opening
-    /// Returns the result (success if valid and allowed)
-    [[nodiscard]] OpenResult validate(const QString& url) const;
+    /// Open the target of a result of evaluate() or evaluateCached(), if it is allowed
+    /// Lets callers that also report the parsed path validate a URL only once
+    [[nodiscard]] OpenResult open(const ValidationResult& result);
 
-    /// Get the target URL/path that would be opened for a given input URL
-    /// Returns empty string if validation fails
-    [[nodiscard]] QString getTargetPath(const QString& url) const;
+    /// Parse and validate a URL and build its target, without opening
+    /// Has no side effects and does not use the decision cache, so it is safe to call on one
+    /// opener from several threads at once
+    [[nodiscard]] ValidationResult evaluate(const QString& url) const;
 
-    /// Get the last parsed UNC path (for display purposes)
-    /// Only valid after a successful validate() or open() call
-    [[nodiscard]] const UncPath& lastParsedPath() const { return m_lastPath; }
+    /// Like evaluate(), but through the decision cache if one is set
+    /// Another spelling of a cached path shares its verdict; the target is built for its spelling
+    [[nodiscard]] ValidationResult evaluateCached(const QString& url) const;
 
-private:
     /// Build the platform-specific target URL/path from a UncPath
     [[nodiscard]] QString buildTargetUrl(const UncPath& path) const;
 
+    /// Build the platform-specific target URL/path from a local path, see PathTranslator
+    [[nodiscard]] static QString buildLocalTarget(const QString& localPath);
+
+    /// Get the target to open for an allowed result
+    /// Unless a path translation built the target, this is the file:// URL of the local mount
+    /// point if the share is mounted, else result.targetUrl. Refreshes the mount index if the
+    /// mounts changed.
+    [[nodiscard]] QString resolveTarget(const ValidationResult& result) const;
+
+    /// Count the share of an opened path in the share history, if one is set
+    /// open() does this itself; callers that open targets on their own call it once the target
+    /// opened, so failed opens are not counted
+    void recordOpen(const UncPath& path) const;
+
+    /// Check the server of a target with the reachability probe, if one is set
+    /// Succeeds at once for local targets; may block for the probe timeout otherwise
+    [[nodiscard]] OpenResult preflight(const QString& server, const QString& targetUrl) const;
+
+    /// Open a target built by buildTargetUrl() from a validated path through the backend
+    [[nodiscard]] OpenResult launch(const QString& targetUrl) const;
+
+    /// Show targets of files in one folder selected in the file manager through the reveal
+    /// backend; without one, the targets are opened in turn until one fails
+    [[nodiscard]] OpenResult reveal(const QStringList& targetUrls) const;
+
+    /// Open a target built by buildTargetUrl() from a validated path through QDesktopServices
+    [[nodiscard]] static OpenResult openTarget(const QString& targetUrl);
+
+private:
+    /// Set the reveal flag and the target of a result the policy allows
+    /// Denies the result if the path leaves the folder of its path translation
+    void buildTarget(ValidationResult& result) const;
+
     /// Actually open the target URL using the system
     [[nodiscard]] static bool openUrl(const QString& url);
 
-    Config m_config;
-    SecurityPolicy m_policy;
-    UrlParser m_parser;
-    mutable UncPath m_lastPath;
+    std::shared_ptr<const CompiledPolicy> m_policy;
+    DecisionCache* m_cache = nullptr;
+    std::shared_ptr<OpenerBackend> m_backend;
+    std::shared_ptr<OpenerBackend> m_revealBackend;
+    std::shared_ptr<MountIndex> m_mounts;
+    std::shared_ptr<ReachabilityProbe> m_probe;
+    std::shared_ptr<ShareHistory> m_history;
 };
 
 } // namespace uncopener
@@ -0,0 +1,132 @@
+#include "PathTranslator.hpp"
+
+#include "SecurityPolicy.hpp"
+
+#include <QDir>
+#include <QSet>
+#include <QStringList>
+
+namespace uncopener
+{
+
+namespace
+{
+
+/// Split a path into its non-empty segments, accepting both slash types
+QStringList pathSegments(QString path)
+{
+    path.replace('/', '\\');
+    return path.split('\\', Qt::SkipEmptyParts);
+}
+
+} // namespace
+
+bool PathTranslator::isValidRule(const PathTranslation& rule)
+{
+    return UncAllowList::isValidEntry(rule.uncPrefix) && !rule.localPath.trimmed().isEmpty();
+}
+
+PathTranslation PathTranslator::normalizeRule(const PathTranslation& rule)
+{
+    PathTranslation normalized;
+    normalized.uncPrefix = UncAllowList::normalizeEntry(rule.uncPrefix);
+    while (normalized.uncPrefix.size() > 2 && normalized.uncPrefix.endsWith('\\'))
+    {
+        normalized.uncPrefix.chop(1);
+    }
+
+    normalized.localPath = QDir::fromNativeSeparators(rule.localPath.trimmed());
+    while (normalized.localPath.size() > 1 && normalized.localPath.endsWith('/'))
+    {
+        normalized.localPath.chop(1);
+    }
+    return normalized;
+}
+
+QList<PathTranslation> PathTranslator::setRules(const QList<PathTranslation>& rules)
+{
+    clear();
+    m_rules.reserve(rules.size());
+    m_segmentCounts.reserve(rules.size());
+
+    QList<PathTranslation> rejected;
+    QSet<QString> seen;
+    for (const PathTranslation& rule : rules)
+    {
+        if (!isValidRule(rule))
+        {
+            rejected.append(rule);
+            continue;
+        }
+
+        PathTranslation normalized = normalizeRule(rule);
+        QString key = normalized.uncPrefix.toCaseFolded();
+        if (seen.contains(key))
+        {
+            continue;
+        }
+        seen.insert(key);
+
+        // The trailing backslash makes the trie match whole segments only
+        m_matcher.insert(QString(normalized.uncPrefix + '\\'), m_rules.size());
+        m_segmentCounts.append(pathSegments(normalized.uncPrefix).size());
+        m_rules.append(normalized);
+    }
+    return rejected;
+}
+
+void PathTranslator::clear()
+{
+    m_rules.clear();
+    m_segmentCounts.clear();
+    m_matcher.clear();
+}
+
+qsizetype PathTranslator::matchIndex(const UncPath& path) const
+{
+    if (m_rules.isEmpty())
+    {
+        return CaseFoldedTrie::NO_MATCH;
+    }
+
+    QString uncPath = path.toUncString();
+    uncPath.replace('/', '\\');
+    if (!uncPath.endsWith('\\'))
+    {
+        uncPath += '\\';
+    }
+    return m_matcher.longestMatch(uncPath);
+}
+
+QString PathTranslator::localPath(const UncPath& path) const
+{
+    return localPath(path, matchIndex(path));
+}
+
+QString PathTranslator::localPath(const UncPath& path, qsizetype index) const
+{
+    if (index < 0 || index >= m_rules.size() || !path.isConfined())
+    {
+        return {};
+    }
+
+    // The rest is taken by segments, since case folding may change the length of the prefix
+    QStringList rest = pathSegments(path.path);
+    QString result = m_rules.at(index).localPath;
+    qsizetype matchedSegments = m_segmentCounts.at(index) - 1; // Without the server
+    if (matchedSegments < rest.size())
+    {
+        if (!result.endsWith('/'))
+        {
+            result += '/';
+        }
+        result += rest.sliced(matchedSegments).join('/');
+    }
+    if (path.hasTrailingSlash && !result.endsWith('/'))
+    {
+        result += '/';
+    }
+    return result;
+}
+
+} // namespace uncopener
@@ -0,0 +1,72 @@
+#ifndef UNCOPENER_PATHTRANSLATOR_HPP
+#define UNCOPENER_PATHTRANSLATOR_HPP
+
+#include "CaseFoldedTrie.hpp"
+#include "UrlParser.hpp"
+
+#include <QList>
+#include <QString>
+
+namespace uncopener
+{
+
+/// A fixed mapping of a UNC prefix to a local directory, e.g. \\fs01\projects to /mnt/projects
+struct PathTranslation
+{
+    QString uncPrefix;
+    QString localPath;
+
+    [[nodiscard]] bool operator==(const PathTranslation& other) const
+    {
+        return uncPrefix == other.uncPrefix && localPath == other.localPath;
+    }
+};
+
+/// Translates UNC paths to local paths by configured prefixes
+/// Prefixes are compiled into a case-folded trie, so a lookup costs O(path length) however many
+/// rules there are. They match whole segments: \\fs01\projects covers \\fs01\projects\a, but
+/// not \\fs01\projects2. The longest matching prefix wins.
+class PathTranslator
+{
+public:
+    /// Set all rules at once (replaces existing rules)
+    /// Duplicate prefixes are detected case-insensitively; the first rule wins
+    /// Returns the list of invalid rules that were rejected
+    QList<PathTranslation> setRules(const QList<PathTranslation>& rules);
+
+    /// Get all current rules, normalized
+    [[nodiscard]] const QList<PathTranslation>& rules() const { return m_rules; }
+
+    /// Check if there are no rules
+    [[nodiscard]] bool isEmpty() const { return m_rules.isEmpty(); }
+
+    /// Remove all rules
+    void clear();
+
+    /// Get the index in rules() of the longest prefix covering the path
+    /// Returns CaseFoldedTrie::NO_MATCH if no rule matches
+    [[nodiscard]] qsizetype matchIndex(const UncPath& path) const;
+
+    /// Get the local path of a UNC path with '/' separators, or an empty string if no rule
+    /// matches or the path has "." or ".." segments; a trailing slash of the UNC path is preserved
+    [[nodiscard]] QString localPath(const UncPath& path) const;
+
+    /// Get the local path of a UNC path by the rule matchIndex() returned for it
+    [[nodiscard]] QString localPath(const UncPath& path, qsizetype index) const;
+
+    /// Check if a rule is valid (UNC prefix without forward slashes, non-empty local path)
+    [[nodiscard]] static bool isValidRule(const PathTranslation& rule);
+
+    /// Normalize a rule (UNC prefix as for the allow-list without trailing backslash, local
+    /// path with '/' separators and without trailing slash)
+    [[nodiscard]] static PathTranslation normalizeRule(const PathTranslation& rule);
+
+private:
+    QList<PathTranslation> m_rules;
+    QList<qsizetype> m_segmentCounts; // Segments of each prefix, server included
+    CaseFoldedTrie m_matcher;         // Prefixes with a trailing backslash
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_PATHTRANSLATOR_HPP
@@ -0,0 +1,165 @@
+#include "PolicyReplay.hpp"
+
+#include <QIODevice>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace uncopener
+{
+
+namespace
+{
+
+void appendDecision(const Decision& decision, DecisionFilter::Format format, QByteArray& out)
+{
+    const char* verdict = decision.allowed ? "allow" : "deny";
+
+    if (format == DecisionFilter::Format::Tsv)
+    {
+        out += '\t';
+        out += verdict;
+        out += '\t';
+        out += decision.reasonCode();
+        out += '\t';
+        DecisionFilter::appendField(out, decision.matchedRule, format);
+        return;
+    }
+
+    out += R"({"verdict":")";
+    out += verdict;
+    out += R"(","reason":")";
+    out += decision.reasonCode();
+    out += R"(","rule":")";
+    DecisionFilter::appendField(out, decision.matchedRule, format);
+    out += "\"}";
+}
+
+} // namespace
+
+PolicyReplay::PolicyReplay(const Config& before, const Config& after, int threadCount)
+    : m_before(before), m_after(after),
+      m_threadCount(threadCount > 0 ? threadCount : std::max(1, QThread::idealThreadCount()))
+{
+}
+
+void PolicyReplay::appendLine(qint64 lineNumber, QStringView url, const Decision& before,
+                              const Decision& after, DecisionFilter::Format format,
+                              QByteArray& out)
+{
+    // The schemes of the configurations may differ, so only one side may have parsed
+    const QString& target = before.target.isEmpty() ? after.target : before.target;
+
+    if (format == DecisionFilter::Format::Tsv)
+    {
+        out += QByteArray::number(lineNumber);
+        out += '\t';
+        DecisionFilter::appendField(out, url, format);
+        out += '\t';
+        DecisionFilter::appendField(out, target, format);
+        appendDecision(before, format, out);
+        appendDecision(after, format, out);
+        out += '\n';
+        return;
+    }
+
+    out += R"({"line":)";
+    out += QByteArray::number(lineNumber);
+    out += R"(,"url":")";
+    DecisionFilter::appendField(out, url, format);
+    out += R"(","target":")";
+    DecisionFilter::appendField(out, target, format);
+    out += R"(","before":)";
+    appendDecision(before, format, out);
+    out += R"(,"after":)";
+    appendDecision(after, format, out);
+    out += "}\n";
+}
+
+bool PolicyReplay::readBatch(LineReader& reader, Batch& batch)
+{
+    // Resizing keeps the capacity, so batches reuse their memory
+    batch.data.resize(0);
+    batch.ends.resize(0);
+
+    // Overlong lines are stored empty: both configurations reject them the same way
+    QByteArrayView line;
+    while (batch.ends.size() < BATCH_LINES && reader.next(line))
+    {
+        batch.data.append(line);
+        batch.ends.append(batch.data.size());
+    }
+    return !batch.ends.isEmpty();
+}
+
+void PolicyReplay::evaluateSlice(const Batch& batch, Slice& slice,
+                                 DecisionFilter::Format format) const
+{
+    for (qsizetype i = slice.begin; i < slice.end; ++i)
+    {
+        qsizetype start = i == 0 ? 0 : batch.ends.at(i - 1);
+        QByteArrayView line(batch.data.constData() + start, batch.ends.at(i) - start);
+
+        Decision before = m_before.evaluateUtf8(line);
+        Decision after = m_after.evaluateUtf8(line);
+        if (differs(before, after))
+        {
+            ++slice.changedCount;
+            appendLine(batch.firstLine + i, QString::fromUtf8(line.trimmed()), before, after,
+                       format, slice.out);
+        }
+    }
+}
+
+ReplayStats PolicyReplay::run(QIODevice& input, QIODevice& output,
+                              DecisionFilter::Format format) const
+{
+    LineReader reader(&input);
+    QThreadPool pool;
+    pool.setMaxThreadCount(m_threadCount);
+
+    std::vector<Slice> slices(static_cast<std::size_t>(m_threadCount));
+    Batch current;
+    Batch next;
+    ReplayStats stats;
+
+    bool more = readBatch(reader, current);
+    while (more)
+    {
+        // Split the batch into one contiguous slice per worker
+        const qsizetype lineCount = current.ends.size();
+        const qsizetype sliceSize = (lineCount + m_threadCount - 1) / m_threadCount;
+        qsizetype begin = 0;
+        for (Slice& slice : slices)
+        {
+            slice.begin = begin;
+            slice.end = std::min(lineCount, begin + sliceSize);
+            slice.out.resize(0);
+            slice.changedCount = 0;
+            begin = slice.end;
+            pool.start([this, &current, &slice, format]
+                       { evaluateSlice(current, slice, format); });
+        }
+
+        // Read the next batch while this one is evaluated
+        more = readBatch(reader, next);
+        next.firstLine = current.firstLine + lineCount;
+        pool.waitForDone();
+
+        // Slices are written in order, so the output follows the input order
+        for (const Slice& slice : slices)
+        {
+            output.write(slice.out);
+            stats.changedCount += slice.changedCount;
+        }
+        stats.lineCount += lineCount;
+        std::swap(current, next);
+    }
+
+    return stats;
+}
+
+} // namespace uncopener
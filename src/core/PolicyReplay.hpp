@@ -0,0 +1,83 @@
+#ifndef UNCOPENER_POLICYREPLAY_HPP
+#define UNCOPENER_POLICYREPLAY_HPP
+
+#include "Config.hpp"
+#include "DecisionFilter.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+#include <QStringView>
+
+class QIODevice;
+
+namespace uncopener
+{
+
+/// Outcome of a replay
+struct ReplayStats
+{
+    qint64 lineCount = 0;
+    qint64 changedCount = 0; // Lines whose verdict differs between the two configurations
+};
+
+/// Evaluates a URL corpus against two configurations and reports the URLs whose verdict
+/// differs, e.g. to preview a new allow-list before rolling it out
+/// Batches of lines are evaluated on all cores while the next batch is read.
+class PolicyReplay
+{
+public:
+    /// Lines per batch; at most two batches are held in memory
+    static constexpr qsizetype BATCH_LINES = 16384;
+
+    /// A threadCount of 0 uses QThread::idealThreadCount()
+    PolicyReplay(const Config& before, const Config& after, int threadCount = 0);
+
+    /// Get the number of worker threads
+    [[nodiscard]] int threadCount() const { return m_threadCount; }
+
+    /// Check if two decisions on the same URL count as a changed verdict
+    [[nodiscard]] static bool differs(const Decision& before, const Decision& after)
+    {
+        return before.allowed != after.allowed;
+    }
+
+    /// Append a changed URL as one line: line number, URL and target, then verdict, reason and
+    /// rule of both configurations
+    static void appendLine(qint64 lineNumber, QStringView url, const Decision& before,
+                           const Decision& after, DecisionFilter::Format format, QByteArray& out);
+
+    /// Read newline-delimited URLs and write one line per URL whose verdict differs, in order
+    ReplayStats run(QIODevice& input, QIODevice& output, DecisionFilter::Format format) const;
+
+private:
+    /// Lines of one batch, stored back to back
+    struct Batch
+    {
+        QByteArray data;
+        QList<qsizetype> ends; // End offset of each line in data
+        qint64 firstLine = 1;  // 1-based number of the first line
+    };
+
+    /// Lines of a batch evaluated by one worker, with its output
+    struct Slice
+    {
+        qsizetype begin = 0;
+        qsizetype end = 0;
+        QByteArray out;
+        qint64 changedCount = 0;
+    };
+
+    /// Fill a batch with up to BATCH_LINES lines; returns false at the end of the input
+    [[nodiscard]] static bool readBatch(LineReader& reader, Batch& batch);
+
+    void evaluateSlice(const Batch& batch, Slice& slice, DecisionFilter::Format format) const;
+
+    DecisionFilter m_before;
+    DecisionFilter m_after;
+    int m_threadCount;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_POLICYREPLAY_HPP
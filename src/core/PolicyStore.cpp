@@ -0,0 +1,55 @@
+#include "PolicyStore.hpp"
+
+#include <QPromise>
+
+namespace uncopener
+{
+
+PolicyStore::PolicyStore(const Config& config)
+    : m_current(CompiledPolicy::compile(config, m_nextGeneration++))
+{
+}
+
+std::shared_ptr<const CompiledPolicy> PolicyStore::snapshot() const
+{
+    return std::atomic_load(&m_current);
+}
+
+quint64 PolicyStore::reload(const Config& config)
+{
+    quint64 generation = m_nextGeneration++;
+    publish(CompiledPolicy::compile(config, generation));
+    return generation;
+}
+
+QFuture<quint64> PolicyStore::reloadInBackground(const Config& config, QThreadPool* pool)
+{
+    // The generation is taken now, so the order of the calls decides which snapshot wins
+    quint64 generation = m_nextGeneration++;
+    auto promise = std::make_shared<QPromise<quint64>>();
+    QFuture<quint64> future = promise->future();
+    promise->start();
+
+    pool->start(
+        [this, promise, config, generation]()
+        {
+            publish(CompiledPolicy::compile(config, generation));
+            promise->addResult(generation);
+            promise->finish();
+        });
+    return future;
+}
+
+void PolicyStore::publish(const std::shared_ptr<const CompiledPolicy>& policy)
+{
+    std::shared_ptr<const CompiledPolicy> current = std::atomic_load(&m_current);
+    while (current->generation() < policy->generation())
+    {
+        if (std::atomic_compare_exchange_weak(&m_current, &current, policy))
+        {
+            return;
+        }
+    }
+}
+
+} // namespace uncopener
@@ -0,0 +1,52 @@
+#ifndef UNCOPENER_POLICYSTORE_HPP
+#define UNCOPENER_POLICYSTORE_HPP
+
+#include "CompiledPolicy.hpp"
+
+#include <QFuture>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+
+namespace uncopener
+{
+
+/// Publishes the current CompiledPolicy of a long-running process
+/// Readers take a snapshot and validate against it without locking. A reload compiles the new
+/// snapshot first and then publishes it with an atomic pointer swap, so validation never waits
+/// for a reload; readers that still hold the previous snapshot finish with it.
+class PolicyStore
+{
+public:
+    /// Publish the initial snapshot (generation 1)
+    explicit PolicyStore(const Config& config);
+
+    /// Get the current snapshot
+    /// Safe to call from any thread, also while a reload is in progress
+    [[nodiscard]] std::shared_ptr<const CompiledPolicy> snapshot() const;
+
+    /// Get the generation of the current snapshot
+    [[nodiscard]] quint64 generation() const { return snapshot()->generation(); }
+
+    /// Compile a config on the calling thread and publish it
+    /// Returns the generation of the new snapshot
+    quint64 reload(const Config& config);
+
+    /// Compile a config on a pool thread and publish it when done
+    /// The future yields the generation of the new snapshot. If reloads overlap, the one
+    /// started last wins, whichever finishes first. The store must outlive the future.
+    QFuture<quint64> reloadInBackground(const Config& config,
+                                        QThreadPool* pool = QThreadPool::globalInstance());
+
+private:
+    /// Swap in a snapshot unless a newer one is already published
+    void publish(const std::shared_ptr<const CompiledPolicy>& policy);
+
+    std::atomic<quint64> m_nextGeneration{1};
+    std::shared_ptr<const CompiledPolicy> m_current; // Only accessed through std::atomic_*
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_POLICYSTORE_HPP
@@ -0,0 +1,160 @@
+#include "ReachabilityProbe.hpp"
+
+#include <QEventLoop>
+#include <QMutexLocker>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <algorithm>
+
+namespace uncopener
+{
+
+ReachabilityProbe::ReachabilityProbe(const Config& config)
+    : ReachabilityProbe(config.probeTimeoutMs())
+{
+}
+
+ReachabilityProbe::ReachabilityProbe(int timeoutMs, quint16 port, int ttlMs,
+                                     int failureThreshold, int cooldownMs)
+    : m_timeoutMs(timeoutMs > 0 ? timeoutMs : Config::DEFAULT_PROBE_TIMEOUT_MS), m_port(port),
+      m_ttlMs(std::max(ttlMs, 0)), m_failureThreshold(std::max(failureThreshold, 0)),
+      m_cooldownMs(std::max(cooldownMs, 0))
+{
+    m_clock.start();
+}
+
+ProbeVerdict ReachabilityProbe::check(const QString& server)
+{
+    return check(server, m_clock.elapsed());
+}
+
+ProbeVerdict ReachabilityProbe::check(const QString& server, qint64 nowMs)
+{
+    QString key = server.toCaseFolded();
+    {
+        QMutexLocker lock(&m_mutex);
+        const ServerState state = m_servers.value(key);
+        if (state.reachableUntilMs > nowMs)
+        {
+            ++m_stats.cacheHits;
+            return ProbeVerdict::Reachable;
+        }
+        if (state.openUntilMs > nowMs)
+        {
+            ++m_stats.failFast;
+            return ProbeVerdict::CircuitOpen;
+        }
+        ++m_stats.probes;
+    }
+
+    // Other servers are not held up while this one is probed
+    ProbeVerdict verdict = probe(server);
+
+    QMutexLocker lock(&m_mutex);
+    ServerState& state = m_servers[key];
+    if (verdict == ProbeVerdict::Reachable)
+    {
+        state = {nowMs + m_ttlMs, -1, 0};
+        return verdict;
+    }
+
+    // After the cooldown a single failed probe opens the circuit again
+    state.reachableUntilMs = -1;
+    ++state.failuresInRow;
+    if (m_failureThreshold > 0 && state.failuresInRow >= m_failureThreshold)
+    {
+        state.openUntilMs = nowMs + m_cooldownMs;
+    }
+    return verdict;
+}
+
+OpenResult ReachabilityProbe::preflight(const QString& server, const QString& targetUrl)
+{
+    if (!isNetworkTarget(targetUrl))
+    {
+        return OpenResult::ok();
+    }
+    return toOpenResult(check(server), server);
+}
+
+OpenResult ReachabilityProbe::toOpenResult(ProbeVerdict verdict, const QString& server)
+{
+    switch (verdict)
+    {
+    case ProbeVerdict::Reachable:
+        return OpenResult::ok();
+    case ProbeVerdict::Unresolved:
+        return OpenResult::error(
+            "Server name could not be resolved",
+            QString("The server name \"%1\" is unknown to this computer. Check the link for "
+                    "typos and make sure you are connected to the network, e.g. via VPN.")
+                .arg(server));
+    case ProbeVerdict::Unreachable:
+        return OpenResult::error(
+            "Server is not reachable",
+            QString("%1 did not accept a connection on the file sharing port. Make sure the "
+                    "server is running and reachable from this computer, e.g. via VPN.")
+                .arg(server));
+    case ProbeVerdict::CircuitOpen:
+        break;
+    }
+    return OpenResult::error(
+        "Server is not reachable",
+        QString("%1 failed to respond several times in a row, so it is not tried again for a "
+                "moment. Make sure the server is running and reachable and try again later.")
+            .arg(server));
+}
+
+bool ReachabilityProbe::isNetworkTarget(const QString& targetUrl)
+{
+    return targetUrl.startsWith("smb://", Qt::CaseInsensitive) || targetUrl.startsWith(R"(\\)");
+}
+
+int ReachabilityProbe::failuresInRow(const QString& server) const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_servers.value(server.toCaseFolded()).failuresInRow;
+}
+
+ProbeStats ReachabilityProbe::stats() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_stats;
+}
+
+ProbeVerdict ReachabilityProbe::probe(const QString& server) const
+{
+    // The local event loop bounds name resolution and connecting by one timeout; it works on
+    // the GUI thread as well as on the workers of AsyncOpener
+    QTcpSocket socket;
+    QEventLoop loop;
+    QTimer timer;
+    timer.setSingleShot(true);
+    QObject::connect(&socket, &QTcpSocket::connected, &loop, &QEventLoop::quit);
+    QObject::connect(&socket, &QTcpSocket::errorOccurred, &loop, &QEventLoop::quit);
+    QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+    socket.connectToHost(server, m_port);
+    timer.start(m_timeoutMs);
+    if (socket.state() != QAbstractSocket::ConnectedState &&
+        socket.state() != QAbstractSocket::UnconnectedState)
+    {
+        loop.exec();
+    }
+
+    ProbeVerdict verdict = ProbeVerdict::Unreachable;
+    if (socket.state() == QAbstractSocket::ConnectedState)
+    {
+        verdict = ProbeVerdict::Reachable;
+    }
+    else if (socket.state() == QAbstractSocket::HostLookupState ||
+             socket.error() == QAbstractSocket::HostNotFoundError)
+    {
+        verdict = ProbeVerdict::Unresolved;
+    }
+    socket.abort();
+    return verdict;
+}
+
+} // namespace uncopener
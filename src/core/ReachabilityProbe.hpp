@@ -0,0 +1,109 @@
+#ifndef UNCOPENER_REACHABILITYPROBE_HPP
+#define UNCOPENER_REACHABILITYPROBE_HPP
+
+#include "Config.hpp"
+#include "PathOpener.hpp"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <cstdint>
+
+namespace uncopener
+{
+
+/// Outcome of probing a server before its target is opened
+enum class ProbeVerdict : std::uint8_t
+{
+    Reachable,   // The server accepted a TCP connection
+    Unresolved,  // The server name did not resolve
+    Unreachable, // No connection within the timeout, or the connection was refused
+    CircuitOpen, // The server failed repeatedly; not probed until the cooldown has passed
+};
+
+/// Number of checks per outcome since construction
+struct ProbeStats
+{
+    qint64 probes = 0;    // Connection attempts actually made
+    qint64 cacheHits = 0; // Reachable servers answered from the cache
+    qint64 failFast = 0;  // Requests rejected by an open circuit
+};
+
+/// Pre-flight check of a server before its smb:// or UNC target is opened
+/// Opening a target on a server that is down can hang the file manager for half a minute.
+/// check() resolves the name and connects to the SMB port with a short timeout instead.
+/// Reachable servers are remembered for a TTL; after a number of failures in a row the circuit
+/// of the server opens and requests fail at once, until a probe after the cooldown succeeds.
+/// Servers are compared case-insensitively. check() may be called from several threads at once.
+class ReachabilityProbe
+{
+public:
+    /// Port of SMB over TCP
+    static constexpr quint16 SMB_PORT = 445;
+
+    /// Default time a reachable server is not probed again
+    static constexpr int DEFAULT_TTL_MS = 60000;
+
+    /// Default number of failures in a row that open the circuit of a server
+    static constexpr int DEFAULT_FAILURE_THRESHOLD = 3;
+
+    /// Default time an open circuit rejects requests before the server is probed again
+    static constexpr int DEFAULT_COOLDOWN_MS = 30000;
+
+    /// Probe with the timeout of the configuration and the default cache settings
+    explicit ReachabilityProbe(const Config& config);
+
+    /// Probe with explicit settings
+    explicit ReachabilityProbe(int timeoutMs, quint16 port = SMB_PORT, int ttlMs = DEFAULT_TTL_MS,
+                               int failureThreshold = DEFAULT_FAILURE_THRESHOLD,
+                               int cooldownMs = DEFAULT_COOLDOWN_MS);
+
+    /// Check a server, using the monotonic clock
+    [[nodiscard]] ProbeVerdict check(const QString& server);
+
+    /// Check a server at a given time in milliseconds (monotonic, for tests)
+    [[nodiscard]] ProbeVerdict check(const QString& server, qint64 nowMs);
+
+    /// Check the server of a target before it is opened
+    /// Succeeds without probing for local targets (mount points and path translations)
+    [[nodiscard]] OpenResult preflight(const QString& server, const QString& targetUrl);
+
+    /// Get the error for a verdict other than ProbeVerdict::Reachable
+    [[nodiscard]] static OpenResult toOpenResult(ProbeVerdict verdict, const QString& server);
+
+    /// Check if a target built by PathOpener goes over the network (smb:// URL or UNC path)
+    [[nodiscard]] static bool isNetworkTarget(const QString& targetUrl);
+
+    /// Failed probes of a server since its last successful one
+    [[nodiscard]] int failuresInRow(const QString& server) const;
+
+    /// Counts of all checks so far
+    [[nodiscard]] ProbeStats stats() const;
+
+private:
+    struct ServerState
+    {
+        qint64 reachableUntilMs = -1; // Cached success; -1 if none
+        qint64 openUntilMs = -1;      // End of the cooldown of an open circuit; -1 if closed
+        int failuresInRow = 0;
+    };
+
+    /// Resolve and connect to a server within the timeout, without touching the cache
+    [[nodiscard]] ProbeVerdict probe(const QString& server) const;
+
+    int m_timeoutMs;
+    quint16 m_port;
+    int m_ttlMs;
+    int m_failureThreshold;
+    int m_cooldownMs;
+    QElapsedTimer m_clock;
+    mutable QMutex m_mutex;
+    QHash<QString, ServerState> m_servers; // Case-folded server -> probe state
+    ProbeStats m_stats;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_REACHABILITYPROBE_HPP
@@ -0,0 +1,147 @@
+#include "RequestThrottle.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace uncopener
+{
+
+RequestThrottle::RequestThrottle(const Config& config)
+    : RequestThrottle(config.coalesceWindowMs(), config.rateLimitBurst(),
+                      config.rateLimitPerMinute())
+{
+}
+
+RequestThrottle::RequestThrottle(int coalesceWindowMs, int burst, int perMinute)
+{
+    reconfigure(coalesceWindowMs, burst, perMinute);
+    m_clock.start();
+}
+
+void RequestThrottle::reconfigure(const Config& config)
+{
+    reconfigure(config.coalesceWindowMs(), config.rateLimitBurst(), config.rateLimitPerMinute());
+}
+
+void RequestThrottle::reconfigure(int coalesceWindowMs, int burst, int perMinute)
+{
+    m_coalesceWindowMs = std::max(coalesceWindowMs, 0);
+    m_burst = perMinute > 0 ? std::max(burst, 0) : 0;
+    m_tokensPerMs = perMinute > 0 ? perMinute / 60000.0 : 0.0;
+}
+
+ThrottleVerdict RequestThrottle::admit(const QString& path, const QString& source)
+{
+    return admit(path, source, m_clock.elapsed());
+}
+
+ThrottleVerdict RequestThrottle::admit(const QString& path, const QString& source, qint64 nowMs)
+{
+    QList<qsizetype> admitted;
+    return admitBatch({path}, source, nowMs, admitted);
+}
+
+ThrottleVerdict RequestThrottle::admitBatch(const QStringList& paths, const QString& source,
+                                            QList<qsizetype>& admitted)
+{
+    return admitBatch(paths, source, m_clock.elapsed(), admitted);
+}
+
+ThrottleVerdict RequestThrottle::admitBatch(const QStringList& paths, const QString& source,
+                                            qint64 nowMs, QList<qsizetype>& admitted)
+{
+    // Coalesced paths do not use up tokens: a double click is one request
+    admitted.clear();
+    QStringList keys;
+    for (qsizetype i = 0; i < paths.size(); ++i)
+    {
+        QString key = paths.at(i).toCaseFolded();
+        if (m_coalesceWindowMs > 0)
+        {
+            auto it = m_recent.constFind(key);
+            if (it != m_recent.cend() && nowMs - it.value() < m_coalesceWindowMs)
+            {
+                ++m_stats.coalesced;
+                continue;
+            }
+        }
+        admitted.append(i);
+        keys.append(key);
+    }
+    if (admitted.isEmpty())
+    {
+        return ThrottleVerdict::Coalesced;
+    }
+
+    if (!takeToken(source, nowMs))
+    {
+        m_stats.rateLimited += admitted.size();
+        admitted.clear();
+        return ThrottleVerdict::RateLimited;
+    }
+
+    if (m_coalesceWindowMs > 0)
+    {
+        for (const QString& key : std::as_const(keys))
+        {
+            if (m_recent.size() >= MAX_TRACKED_PATHS)
+            {
+                pruneRecent(nowMs);
+            }
+            m_recent.insert(key, nowMs);
+        }
+    }
+
+    m_stats.accepted += admitted.size();
+    return ThrottleVerdict::Accepted;
+}
+
+qint64 RequestThrottle::rateLimitedInRow(const QString& source) const
+{
+    auto it = m_buckets.constFind(source);
+    return it != m_buckets.cend() ? it->rejectedInRow : 0;
+}
+
+void RequestThrottle::pruneRecent(qint64 nowMs)
+{
+    m_recent.removeIf([this, nowMs](const QHash<QString, qint64>::iterator& it)
+                      { return nowMs - it.value() >= m_coalesceWindowMs; });
+
+    // Every entry is still within the window: forget them rather than grow without bound
+    if (m_recent.size() >= MAX_TRACKED_PATHS)
+    {
+        m_recent.clear();
+    }
+}
+
+bool RequestThrottle::takeToken(const QString& source, qint64 nowMs)
+{
+    if (m_burst == 0)
+    {
+        return true;
+    }
+
+    // A new source starts with a full bucket
+    auto it = m_buckets.find(source);
+    if (it == m_buckets.end())
+    {
+        it = m_buckets.insert(source, {static_cast<double>(m_burst), nowMs, 0});
+    }
+
+    Bucket& bucket = it.value();
+    double refill = static_cast<double>(nowMs - bucket.refilledAtMs) * m_tokensPerMs;
+    bucket.tokens = std::min(bucket.tokens + refill, static_cast<double>(m_burst));
+    bucket.refilledAtMs = nowMs;
+
+    if (bucket.tokens < 1.0)
+    {
+        ++bucket.rejectedInRow;
+        return false;
+    }
+
+    bucket.tokens -= 1.0;
+    bucket.rejectedInRow = 0;
+    return true;
+}
+
+} // namespace uncopener
@@ -0,0 +1,109 @@
+#ifndef UNCOPENER_REQUESTTHROTTLE_HPP
+#define UNCOPENER_REQUESTTHROTTLE_HPP
+
+#include "Config.hpp"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+
+namespace uncopener
+{
+
+/// Outcome of offering a request to a RequestThrottle
+enum class ThrottleVerdict : std::uint8_t
+{
+    Accepted,    // Open the path
+    Coalesced,   // Same path was accepted within the coalescing window
+    RateLimited, // The source has no tokens left
+};
+
+/// Number of requests per verdict since construction
+struct ThrottleStats
+{
+    qint64 accepted = 0;
+    qint64 coalesced = 0;
+    qint64 rateLimited = 0;
+};
+
+/// Coalescing and rate limiting in front of PathOpener::open() for long-running instances
+/// Repeated requests for the same path within a window are dropped, and every source (e.g. the
+/// resident socket or the session bus) has a token bucket so a spamming page cannot flood the
+/// desktop with windows or error dialogs
+class RequestThrottle
+{
+public:
+    /// Upper bound of remembered paths; older entries are pruned when it is reached
+    static constexpr qsizetype MAX_TRACKED_PATHS = 4096;
+
+    /// Throttle with the coalescing window and rate limit of the configuration
+    explicit RequestThrottle(const Config& config);
+
+    /// Throttle with explicit settings; 0 disables the respective stage
+    RequestThrottle(int coalesceWindowMs, int burst, int perMinute);
+
+    /// Apply the coalescing window and rate limit of a changed configuration
+    /// Remembered paths, buckets and statistics are kept, so a reload does not reset limits;
+    /// tokens in a bucket are capped at the new burst on its next request
+    void reconfigure(const Config& config);
+
+    /// Apply explicit settings; 0 disables the respective stage
+    void reconfigure(int coalesceWindowMs, int burst, int perMinute);
+
+    /// Decide on a request for a path from a source, using the monotonic clock
+    /// The path should be normalized (e.g. PathOpener::displayPath()); case is ignored
+    [[nodiscard]] ThrottleVerdict admit(const QString& path, const QString& source);
+
+    /// Decide on a request at a given time in milliseconds (monotonic, for tests)
+    [[nodiscard]] ThrottleVerdict admit(const QString& path, const QString& source,
+                                        qint64 nowMs);
+
+    /// Decide on a batch of paths from a source, e.g. the locations a portal opens together
+    /// The batch is one request and takes one token, however many paths it has; paths accepted
+    /// within the coalescing window are left out of it. admitted is set to the indexes of the
+    /// paths to open. Returns RateLimited if the source has no token left, Coalesced if every
+    /// path was left out, and Accepted otherwise.
+    [[nodiscard]] ThrottleVerdict admitBatch(const QStringList& paths, const QString& source,
+                                             QList<qsizetype>& admitted);
+
+    /// Decide on a batch at a given time in milliseconds (monotonic, for tests)
+    [[nodiscard]] ThrottleVerdict admitBatch(const QStringList& paths, const QString& source,
+                                             qint64 nowMs, QList<qsizetype>& admitted);
+
+    /// Requests of a source rejected since its last accepted one
+    /// 1 right after the source ran out of tokens, to report the start of throttling once
+    [[nodiscard]] qint64 rateLimitedInRow(const QString& source) const;
+
+    /// Counts of all decisions so far
+    [[nodiscard]] const ThrottleStats& stats() const { return m_stats; }
+
+private:
+    struct Bucket
+    {
+        double tokens = 0;
+        qint64 refilledAtMs = 0;
+        qint64 rejectedInRow = 0;
+    };
+
+    /// Drop remembered paths whose window has passed
+    void pruneRecent(qint64 nowMs);
+
+    /// Take a token from the bucket of a source if one is available
+    [[nodiscard]] bool takeToken(const QString& source, qint64 nowMs);
+
+    int m_coalesceWindowMs = 0;
+    int m_burst = 0;
+    double m_tokensPerMs = 0.0;
+    QElapsedTimer m_clock;
+    QHash<QString, qint64> m_recent; // Case-folded path -> time it was last accepted
+    QHash<QString, Bucket> m_buckets;
+    ThrottleStats m_stats;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_REQUESTTHROTTLE_HPP
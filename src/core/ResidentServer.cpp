@@ -0,0 +1,258 @@
+#include "ResidentServer.hpp"
+
+#include "BatchOpener.hpp"
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QStandardPaths>
+
+#ifdef Q_OS_WIN
+#include <qt_windows.h>
+#include <shellapi.h>
+#endif
+
+#include <algorithm>
+#include <utility>
+
+namespace uncopener
+{
+
+namespace
+{
+
+const QByteArray COMMAND_OPEN = "open ";
+const QByteArray COMMAND_OPEN_BATCH = "open-batch ";
+const QByteArray COMMAND_PREWARM = "prewarm ";
+
+/// Largest batch accepted; BatchOpener reports the URLs beyond MAX_URLS itself
+constexpr qsizetype MAX_BATCH_URLS = BatchOpener::MAX_URLS + 1;
+
+/// Remove the line terminator from a request line
+QByteArray chopLineEnd(QByteArray line)
+{
+    while (line.endsWith('\n') || line.endsWith('\r'))
+    {
+        line.chop(1);
+    }
+    return line;
+}
+
+} // namespace
+
+ResidentServer::ResidentServer(QString serverName, QObject* parent)
+    : QObject(parent), m_serverName(std::move(serverName)), m_server(new QLocalServer(this))
+{
+    // Only the current user may connect
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(m_server, &QLocalServer::newConnection, this, &ResidentServer::onNewConnection);
+}
+
+QString ResidentServer::defaultServerName()
+{
+#ifdef Q_OS_WIN
+    // Named pipes share one global namespace, so the user name is part of the name
+    return "uncopener-" + qEnvironmentVariable("USERNAME");
+#else
+    // $XDG_RUNTIME_DIR is private to the user
+    return QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation) +
+           "/uncopener.sock";
+#endif
+}
+
+bool ResidentServer::listen()
+{
+    if (m_server->listen(m_serverName))
+    {
+        return true;
+    }
+
+    if (m_server->serverError() != QAbstractSocket::AddressInUseError)
+    {
+        return false;
+    }
+
+    // The name is taken: either another instance is running or a crashed one left its socket
+    QLocalSocket probe;
+    probe.connectToServer(m_serverName);
+    if (probe.waitForConnected(DEFAULT_TIMEOUT_MS))
+    {
+        return false;
+    }
+
+    QLocalServer::removeServer(m_serverName);
+    return m_server->listen(m_serverName);
+}
+
+bool ResidentServer::isListening() const
+{
+    return m_server->isListening();
+}
+
+bool ResidentServer::forward(const QString& serverName, const QStringList& urls, int timeoutMs)
+{
+    // Several URLs are announced as one batch, so they are throttled and reported together
+    QByteArray header;
+    if (urls.size() > 1)
+    {
+        header = COMMAND_OPEN_BATCH + QByteArray::number(urls.size()) + '\n';
+    }
+    return send(serverName, header, COMMAND_OPEN, urls, timeoutMs);
+}
+
+bool ResidentServer::forwardArguments(int argc, char* argv[])
+{
+    QStringList urls = processArguments(argc, argv).mid(1);
+    if (urls.isEmpty() || std::any_of(urls.cbegin(), urls.cend(),
+                                      [](const QString& arg) { return arg.startsWith('-'); }))
+    {
+        return false;
+    }
+    return forward(defaultServerName(), urls);
+}
+
+QStringList ResidentServer::processArguments(int argc, char* argv[])
+{
+    QStringList arguments;
+#ifdef Q_OS_WIN
+    // argv is in the ANSI code page, which cannot hold every URL; read the wide command line
+    // like QCoreApplication does
+    static_cast<void>(argc);
+    static_cast<void>(argv);
+    int count = 0;
+    LPWSTR* wide = CommandLineToArgvW(GetCommandLineW(), &count);
+    if (wide == nullptr)
+    {
+        return {};
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        arguments.append(QString::fromWCharArray(wide[i]));
+    }
+    LocalFree(wide);
+#else
+    for (int i = 0; i < argc; ++i)
+    {
+        arguments.append(QString::fromLocal8Bit(argv[i]));
+    }
+#endif
+    return arguments;
+}
+
+bool ResidentServer::forwardPrewarm(const QString& serverName, const QStringList& urls,
+                                    int timeoutMs)
+{
+    return send(serverName, {}, COMMAND_PREWARM, urls, timeoutMs);
+}
+
+bool ResidentServer::send(const QString& serverName, const QByteArray& header,
+                          const QByteArray& command, const QStringList& urls, int timeoutMs)
+{
+    QByteArray payload = header;
+    for (const QString& url : urls)
+    {
+        // A line break would split the request; let the caller handle such input itself
+        if (url.contains('\n') || url.contains('\r'))
+        {
+            return false;
+        }
+        payload += command + url.toUtf8() + '\n';
+    }
+
+    QLocalSocket socket;
+    socket.connectToServer(serverName);
+    if (!socket.waitForConnected(timeoutMs))
+    {
+        return false;
+    }
+
+    if (socket.write(payload) != payload.size())
+    {
+        return false;
+    }
+
+    while (socket.bytesToWrite() > 0)
+    {
+        if (!socket.waitForBytesWritten(timeoutMs))
+        {
+            return false;
+        }
+    }
+
+    socket.disconnectFromServer();
+    if (socket.state() != QLocalSocket::UnconnectedState)
+    {
+        socket.waitForDisconnected(timeoutMs);
+    }
+    return true;
+}
+
+void ResidentServer::onNewConnection()
+{
+    while (QLocalSocket* socket = m_server->nextPendingConnection())
+    {
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { readRequests(socket); });
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+
+        // A batch cut short by a client that went away is dropped
+        connect(socket, &QObject::destroyed, this, [this, socket]() { m_batches.remove(socket); });
+
+        // Requests may already be buffered if the client was quick
+        readRequests(socket);
+    }
+}
+
+void ResidentServer::readRequests(QLocalSocket* socket)
+{
+    while (socket->canReadLine())
+    {
+        QByteArray line = chopLineEnd(socket->readLine(MAX_LINE_LENGTH));
+        if (line.startsWith(COMMAND_OPEN))
+        {
+            receiveUrl(socket, QString::fromUtf8(line.mid(COMMAND_OPEN.size())));
+        }
+        else if (line.startsWith(COMMAND_OPEN_BATCH))
+        {
+            bool ok = false;
+            auto expected =
+                static_cast<qsizetype>(line.mid(COMMAND_OPEN_BATCH.size()).toLongLong(&ok));
+            if (!ok || expected < 1 || expected > MAX_BATCH_URLS ||
+                m_batches.contains(socket))
+            {
+                m_batches.remove(socket);
+                socket->abort();
+                return;
+            }
+            m_batches.insert(socket, {expected, {}});
+        }
+        else if (line.startsWith(COMMAND_PREWARM))
+        {
+            emit prewarmRequested(QString::fromUtf8(line.mid(COMMAND_PREWARM.size())));
+        }
+    }
+
+    // Refuse oversized requests that never terminate
+    if (socket->bytesAvailable() > MAX_LINE_LENGTH)
+    {
+        socket->abort();
+    }
+}
+
+void ResidentServer::receiveUrl(QLocalSocket* socket, const QString& url)
+{
+    auto it = m_batches.find(socket);
+    if (it == m_batches.end())
+    {
+        emit urlReceived(url);
+        return;
+    }
+
+    it->urls.append(url);
+    if (it->urls.size() == it->expected)
+    {
+        QStringList urls = std::move(it->urls);
+        m_batches.erase(it);
+        emit batchReceived(urls);
+    }
+}
+
+} // namespace uncopener
@@ -0,0 +1,104 @@
+#ifndef UNCOPENER_RESIDENTSERVER_HPP
+#define UNCOPENER_RESIDENTSERVER_HPP
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+class QLocalServer;
+class QLocalSocket;
+
+namespace uncopener
+{
+
+/// Per-user local socket of the resident instance
+/// Later handler invocations forward their URLs here and exit instead of loading the config
+///
+/// Protocol: one UTF-8 request per line, "open <url>\n" or "prewarm <url>\n"; unknown commands
+/// are ignored. "open-batch <count>\n" announces that the next <count> open lines form one
+/// batch (at most BatchOpener::MAX_URLS + 1), which is delivered as a whole; instances that do
+/// not know the command open the URLs one by one.
+class ResidentServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Maximum length of one request line in bytes
+    static constexpr qint64 MAX_LINE_LENGTH = 64 * 1024;
+
+    /// Default timeout for talking to a running instance in milliseconds
+    static constexpr int DEFAULT_TIMEOUT_MS = 500;
+
+    explicit ResidentServer(QString serverName = defaultServerName(), QObject* parent = nullptr);
+
+    /// Get the per-user server name (socket path on Linux, pipe name on Windows)
+    [[nodiscard]] static QString defaultServerName();
+
+    /// Get the server name this instance listens on
+    [[nodiscard]] QString serverName() const { return m_serverName; }
+
+    /// Start listening
+    /// Returns false if another instance is already listening on the name
+    [[nodiscard]] bool listen();
+
+    /// Check if the server is listening
+    [[nodiscard]] bool isListening() const;
+
+    /// Send URLs to a running resident instance
+    /// Several URLs are sent as one batch, see batchReceived()
+    /// Returns false if no instance is listening or the URLs could not be delivered
+    [[nodiscard]] static bool forward(const QString& serverName, const QStringList& urls,
+                                      int timeoutMs = DEFAULT_TIMEOUT_MS);
+
+    /// Forward the URLs of a handler invocation before any application object exists
+    /// Only invocations whose arguments are all URLs (none starts with '-') are forwarded.
+    /// Returns true if a running instance took them, so the caller can exit at once without
+    /// setting up the platform integration of a QGuiApplication.
+    [[nodiscard]] static bool forwardArguments(int argc, char* argv[]);
+
+    /// Ask a running resident instance to mount the shares of URLs ahead of opening them
+    /// Returns false if no instance is listening or the URLs could not be delivered
+    [[nodiscard]] static bool forwardPrewarm(const QString& serverName, const QStringList& urls,
+                                             int timeoutMs = DEFAULT_TIMEOUT_MS);
+
+signals:
+    /// Emitted for every single URL received from another invocation
+    void urlReceived(const QString& url);
+
+    /// Emitted for the URLs another invocation forwarded together, once all of them arrived
+    void batchReceived(const QStringList& urls);
+
+    /// Emitted for every URL whose share another invocation asked to prewarm
+    void prewarmRequested(const QString& url);
+
+private:
+    /// Get the command line arguments without QCoreApplication::arguments()
+    [[nodiscard]] static QStringList processArguments(int argc, char* argv[]);
+
+    /// A batch announced by "open-batch" whose URLs are still arriving
+    struct PendingBatch
+    {
+        qsizetype expected = 0;
+        QStringList urls;
+    };
+
+    /// Send one command line per URL, after the header line if one is given
+    [[nodiscard]] static bool send(const QString& serverName, const QByteArray& header,
+                                   const QByteArray& command, const QStringList& urls,
+                                   int timeoutMs);
+
+    void onNewConnection();
+    void readRequests(QLocalSocket* socket);
+
+    /// Add a URL to the pending batch of a socket, or emit it alone if there is none
+    void receiveUrl(QLocalSocket* socket, const QString& url);
+
+    QString m_serverName;
+    QLocalServer* m_server = nullptr;
+    QHash<QLocalSocket*, PendingBatch> m_batches;
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_RESIDENTSERVER_HPP
@@ -38,6 +38,9 @@ struct RegistrationResult
 class SchemeRegistry
 {
 public:
+    /// Well-known bus name of the DBusActivatable handler, also its desktop file ID
+    static constexpr const char* DBUS_SERVICE_NAME = "org.uncopener.UncOpener.Handler";
+
     SchemeRegistry() = default;
     virtual ~SchemeRegistry() = default;
     SchemeRegistry(const SchemeRegistry&) = delete;
@@ -57,11 +60,23 @@ public:
     /// Unregister the scheme
     [[nodiscard]] virtual RegistrationResult unregisterScheme(const QString& schemeName) = 0;
 
+    /// Register as DBusActivatable handler, so the session bus starts one instance and sends
+    /// it all later URLs (Linux only; ignored elsewhere)
+    void setDBusActivatable(bool enabled) { m_dbusActivatable = enabled; }
+    [[nodiscard]] bool isDBusActivatable() const { return m_dbusActivatable; }
+
     /// Get the path of the current binary
     [[nodiscard]] static QString currentBinaryPath();
 
+    /// Get the binary to register as URL handler
+    /// Prefers the minimal uncopener-handler next to the current binary, if installed
+    [[nodiscard]] static QString handlerBinaryPath();
+
     /// Create the platform-appropriate registry implementation
     [[nodiscard]] static std::unique_ptr<SchemeRegistry> create();
+
+private:
+    bool m_dbusActivatable = false;
 };
 
 } // namespace uncopener
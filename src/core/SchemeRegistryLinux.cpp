@@ -6,6 +6,7 @@
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QProcess>
 #include <QRegularExpression>
 #include <QStandardPaths>
@@ -25,28 +26,92 @@ QString desktopFilePath(const QString& schemeName)
     return applicationsDir + "/uncopener-" + schemeName + ".desktop";
 }
 
+/// Get the path to the .desktop file of the DBusActivatable handler
+/// Its file name must be the bus name, so it is shared by all schemes
+QString dbusDesktopFilePath()
+{
+    QString applicationsDir =
+        QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation);
+    return applicationsDir + "/" + SchemeRegistry::DBUS_SERVICE_NAME + ".desktop";
+}
+
+/// Get the path to the session bus service file that starts the DBusActivatable handler
+QString dbusServiceFilePath()
+{
+    QString dataDir = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation);
+    return dataDir + "/dbus-1/services/" + SchemeRegistry::DBUS_SERVICE_NAME + ".service";
+}
+
+/// Prefix of the MIME types of URL schemes
+const QString SCHEME_MIME_PREFIX = "x-scheme-handler/";
+
 /// Get the MIME type for a URL scheme
 QString mimeTypeForScheme(const QString& schemeName)
 {
-    return "x-scheme-handler/" + schemeName;
+    return SCHEME_MIME_PREFIX + schemeName;
 }
 
-/// Generate .desktop file content
-QString generateDesktopFileContent(const QString& schemeName, const QString& binaryPath)
+/// Generate .desktop file content for one or more schemes
+/// Launchers without D-Bus activation support still use the Exec line
+QString generateDesktopFileContent(const QStringList& schemeNames, const QString& binaryPath,
+                                   bool dbusActivatable)
 {
+    QStringList urlPrefixes;
+    QString mimeTypes;
+    for (const QString& schemeName : schemeNames)
+    {
+        urlPrefixes.append(schemeName + "://");
+        mimeTypes += mimeTypeForScheme(schemeName) + ";";
+    }
+
     QString content;
     QTextStream stream(&content);
     stream << "[Desktop Entry]\n";
     stream << "Type=Application\n";
-    stream << "Name=UncOpener (" << schemeName << ")\n";
-    stream << "Comment=Handler for " << schemeName << ":// URLs\n";
+    stream << "Name=UncOpener (" << schemeNames.join(", ") << ")\n";
+    stream << "Comment=Handler for " << urlPrefixes.join(", ") << " URLs\n";
     stream << "Exec=\"" << binaryPath << "\" %u\n";
+    if (dbusActivatable)
+    {
+        stream << "DBusActivatable=true\n";
+    }
     stream << "Terminal=false\n";
     stream << "NoDisplay=true\n";
-    stream << "MimeType=" << mimeTypeForScheme(schemeName) << ";\n";
+    stream << "MimeType=" << mimeTypes << "\n";
     return content;
 }
 
+/// Generate session bus service file content
+/// The widgets binary serves org.freedesktop.Application, since it shows the dialogs
+QString generateDBusServiceFileContent(const QString& binaryPath)
+{
+    QString content;
+    QTextStream stream(&content);
+    stream << "[D-BUS Service]\n";
+    stream << "Name=" << SchemeRegistry::DBUS_SERVICE_NAME << "\n";
+    stream << "Exec=\"" << binaryPath << "\" --dbus-service\n";
+    return content;
+}
+
+/// Write a text file, creating its directory if needed
+bool writeTextFile(const QString& path, const QString& content)
+{
+    if (!QDir().mkpath(QFileInfo(path).path()))
+    {
+        return false;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        return false;
+    }
+    QTextStream stream(&file);
+    stream << content;
+    stream.flush();
+    return stream.status() == QTextStream::Ok;
+}
+
 /// Parse Exec line from .desktop file to extract binary path
 QString extractBinaryFromExecLine(const QString& execLine)
 {
@@ -72,6 +137,64 @@ QString extractBinaryFromExecLine(const QString& execLine)
     return line;
 }
 
+/// Get the binary of the Exec line of a .desktop file that handles the MIME type
+/// Returns an empty string if the file does not exist or handles other types
+QString registeredBinary(const QString& desktopPath, const QString& mimeType)
+{
+    QFile file(desktopPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return {};
+    }
+
+    QString binaryPath;
+    bool handlesMimeType = false;
+    QTextStream stream(&file);
+    while (!stream.atEnd())
+    {
+        QString line = stream.readLine();
+        if (line.startsWith("Exec="))
+        {
+            binaryPath = extractBinaryFromExecLine(line);
+        }
+        else if (line.startsWith("MimeType="))
+        {
+            handlesMimeType = line.mid(9).split(';').contains(mimeType);
+        }
+    }
+    return handlesMimeType ? binaryPath : QString();
+}
+
+/// Get the schemes a .desktop file handles, in the order of its MimeType line
+/// Returns an empty list if the file does not exist
+QStringList registeredSchemes(const QString& desktopPath)
+{
+    QFile file(desktopPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return {};
+    }
+
+    QStringList schemeNames;
+    QTextStream stream(&file);
+    while (!stream.atEnd())
+    {
+        QString line = stream.readLine();
+        if (!line.startsWith("MimeType="))
+        {
+            continue;
+        }
+        for (const QString& mimeType : line.mid(9).split(';', Qt::SkipEmptyParts))
+        {
+            if (mimeType.startsWith(SCHEME_MIME_PREFIX))
+            {
+                schemeNames.append(mimeType.mid(SCHEME_MIME_PREFIX.size()));
+            }
+        }
+    }
+    return schemeNames;
+}
+
 } // namespace
 
 /// Linux implementation using .desktop files and xdg-mime
@@ -87,9 +210,8 @@ public:
             return RegistrationStatus::NotRegistered;
         }
 
-        // Normalize paths for comparison
-        QString currentPath = currentBinaryPath();
-        if (registeredPath == currentPath)
+        // Either binary of this installation counts as registered to this application
+        if (registeredPath == handlerBinaryPath() || registeredPath == currentBinaryPath())
         {
             return RegistrationStatus::RegisteredToThisBinary;
         }
@@ -99,66 +221,61 @@ public:
 
     [[nodiscard]] QString getRegisteredBinaryPath(const QString& schemeName) const override
     {
-        QString desktopPath = desktopFilePath(schemeName);
-        QFile file(desktopPath);
-
-        if (!file.exists() || !file.open(QIODevice::ReadOnly | QIODevice::Text))
-        {
-            return {};
-        }
-
-        // Read the file and find the Exec line
-        QTextStream stream(&file);
-        while (!stream.atEnd())
+        QString mimeType = mimeTypeForScheme(schemeName);
+        QString binaryPath = registeredBinary(desktopFilePath(schemeName), mimeType);
+        if (binaryPath.isEmpty())
         {
-            QString line = stream.readLine();
-            if (line.startsWith("Exec="))
-            {
-                return extractBinaryFromExecLine(line);
-            }
+            binaryPath = registeredBinary(dbusDesktopFilePath(), mimeType);
         }
-
-        return {};
+        return binaryPath;
     }
 
     [[nodiscard]] RegistrationResult registerScheme(const QString& schemeName) override
     {
-        QString desktopPath = desktopFilePath(schemeName);
-        QString binaryPath = currentBinaryPath();
+        QString mimeType = mimeTypeForScheme(schemeName);
+        QString desktopPath = isDBusActivatable() ? dbusDesktopFilePath()
+                                                  : desktopFilePath(schemeName);
 
-        // Ensure the applications directory exists
-        QDir applicationsDir(
-            QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation));
-        if (!applicationsDir.exists())
+        // The D-Bus desktop file is shared by all schemes, so it keeps the ones it has
+        QStringList schemeNames{schemeName};
+        if (isDBusActivatable())
         {
-            if (!applicationsDir.mkpath("."))
+            schemeNames = registeredSchemes(desktopPath);
+            if (!schemeNames.contains(schemeName))
             {
-                return RegistrationResult::error("Failed to create applications directory: " +
-                                                 applicationsDir.path());
+                schemeNames.append(schemeName);
             }
         }
 
-        // Write the .desktop file
-        QFile file(desktopPath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        // Write the .desktop file (creates the applications directory if needed)
+        QString content =
+            generateDesktopFileContent(schemeNames, handlerBinaryPath(), isDBusActivatable());
+        if (!writeTextFile(desktopPath, content))
         {
             return RegistrationResult::error("Failed to create .desktop file: " + desktopPath);
         }
 
-        QString content = generateDesktopFileContent(schemeName, binaryPath);
-        QTextStream stream(&file);
-        stream << content;
-        file.close();
-
         // Make the desktop file executable
-        file.setPermissions(file.permissions() | QFileDevice::ExeUser);
+        QFile desktopFile(desktopPath);
+        desktopFile.setPermissions(desktopFile.permissions() | QFileDevice::ExeUser);
 
-        // Update the MIME database to register the scheme handler
-        QString mimeType = mimeTypeForScheme(schemeName);
-        QString desktopFileName = "uncopener-" + schemeName + ".desktop";
+        if (isDBusActivatable())
+        {
+            // The session bus starts the service on the first URL and reuses it afterwards
+            QString servicePath = dbusServiceFilePath();
+            if (!writeTextFile(servicePath, generateDBusServiceFileContent(currentBinaryPath())))
+            {
+                return RegistrationResult::error("Failed to create D-Bus service file: " +
+                                                 servicePath);
+            }
+        }
+
+        // Only one variant may handle the scheme
+        removeOtherVariant(schemeName);
 
+        // Update the MIME database to register the scheme handler
         QProcess updateMime;
-        updateMime.start("xdg-mime", {"default", desktopFileName, mimeType});
+        updateMime.start("xdg-mime", {"default", QFileInfo(desktopPath).fileName(), mimeType});
         if (!updateMime.waitForFinished(5000))
         {
             return RegistrationResult::error("xdg-mime command timed out");
@@ -170,40 +287,79 @@ public:
             return RegistrationResult::error("xdg-mime failed: " + errorOutput);
         }
 
-        // Update the desktop database
-        QProcess updateDb;
-        updateDb.start("update-desktop-database",
-                       {QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation)});
-        updateDb.waitForFinished(5000); // Ignore errors, this is optional
-
+        updateDesktopDatabase();
         return RegistrationResult::ok();
     }
 
     [[nodiscard]] RegistrationResult unregisterScheme(const QString& schemeName) override
     {
-        QString desktopPath = desktopFilePath(schemeName);
-
         // Remove the .desktop file
+        QString desktopPath = desktopFilePath(schemeName);
         QFile file(desktopPath);
-        if (file.exists())
+        if (file.exists() && !file.remove())
         {
-            if (!file.remove())
-            {
-                return RegistrationResult::error("Failed to remove .desktop file: " + desktopPath);
-            }
+            return RegistrationResult::error("Failed to remove .desktop file: " + desktopPath);
         }
 
-        // Update the desktop database
-        QProcess updateDb;
-        updateDb.start("update-desktop-database",
-                       {QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation)});
-        updateDb.waitForFinished(5000); // Ignore errors
+        // Remove the DBusActivatable handler if it serves this scheme
+        if (!removeDBusFiles(schemeName))
+        {
+            return RegistrationResult::error("Failed to remove .desktop file: " +
+                                             dbusDesktopFilePath());
+        }
+
+        updateDesktopDatabase();
 
         // Note: We don't need to explicitly remove the xdg-mime association
         // because removing the .desktop file effectively unregisters it
 
         return RegistrationResult::ok();
     }
+
+private:
+    /// Remove the registration variant that is not selected by isDBusActivatable()
+    void removeOtherVariant(const QString& schemeName) const
+    {
+        if (isDBusActivatable())
+        {
+            QFile::remove(desktopFilePath(schemeName));
+        }
+        else
+        {
+            static_cast<void>(removeDBusFiles(schemeName));
+        }
+    }
+
+    /// Remove the scheme from the DBusActivatable handler
+    /// The files of the handler are removed with its last scheme
+    [[nodiscard]] static bool removeDBusFiles(const QString& schemeName)
+    {
+        QString desktopPath = dbusDesktopFilePath();
+        QString binaryPath = registeredBinary(desktopPath, mimeTypeForScheme(schemeName));
+        if (binaryPath.isEmpty())
+        {
+            return true;
+        }
+
+        QStringList schemeNames = registeredSchemes(desktopPath);
+        schemeNames.removeAll(schemeName);
+        if (!schemeNames.isEmpty())
+        {
+            return writeTextFile(desktopPath,
+                                 generateDesktopFileContent(schemeNames, binaryPath, true));
+        }
+
+        QFile::remove(dbusServiceFilePath());
+        return QFile::remove(desktopPath);
+    }
+
+    static void updateDesktopDatabase()
+    {
+        QProcess updateDb;
+        updateDb.start("update-desktop-database",
+                       {QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation)});
+        updateDb.waitForFinished(5000); // Ignore errors, this is optional
+    }
 };
 
 std::unique_ptr<SchemeRegistry> SchemeRegistry::create()
@@ -216,6 +372,16 @@ QString SchemeRegistry::currentBinaryPath()
     return QCoreApplication::applicationFilePath();
 }
 
+QString SchemeRegistry::handlerBinaryPath()
+{
+    QString handlerPath = QCoreApplication::applicationDirPath() + "/uncopener-handler";
+    if (QFileInfo(handlerPath).isExecutable())
+    {
+        return handlerPath;
+    }
+    return currentBinaryPath();
+}
+
 } // namespace uncopener
 
 #endif // Q_OS_WIN
@@ -4,6 +4,7 @@
 #include "SchemeRegistry.hpp"
 
 #include <QCoreApplication>
+#include <QFileInfo>
 #include <QSettings>
 
 namespace uncopener
@@ -33,9 +34,10 @@ public:
             return RegistrationStatus::NotRegistered;
         }
 
-        // Normalize paths for comparison (case-insensitive on Windows)
-        QString currentPath = currentBinaryPath();
-        if (registeredPath.compare(currentPath, Qt::CaseInsensitive) == 0)
+        // Either binary of this installation counts as registered to this application
+        // (case-insensitive on Windows)
+        if (registeredPath.compare(handlerBinaryPath(), Qt::CaseInsensitive) == 0 ||
+            registeredPath.compare(currentBinaryPath(), Qt::CaseInsensitive) == 0)
         {
             return RegistrationStatus::RegisteredToThisBinary;
         }
@@ -78,7 +80,7 @@ public:
     [[nodiscard]] RegistrationResult registerScheme(const QString& schemeName) override
     {
         QString basePath = registryPath(schemeName);
-        QString binaryPath = currentBinaryPath();
+        QString binaryPath = handlerBinaryPath();
 
         // Create the base key with URL Protocol marker
         QSettings baseKey(basePath, QSettings::NativeFormat);
@@ -92,7 +94,7 @@ public:
 
         // Create the icon key
         QSettings iconKey(basePath + "\\DefaultIcon", QSettings::NativeFormat);
-        iconKey.setValue("Default", binaryPath + ",0");
+        iconKey.setValue("Default", currentBinaryPath() + ",0");
 
         // Verify registration succeeded
         if (checkRegistration(schemeName) != RegistrationStatus::RegisteredToThisBinary)
@@ -136,6 +138,17 @@ QString SchemeRegistry::currentBinaryPath()
     return QCoreApplication::applicationFilePath().replace('/', '\\');
 }
 
+QString SchemeRegistry::handlerBinaryPath()
+{
+    QString handlerPath = QCoreApplication::applicationDirPath() + "/uncopener-handler.exe";
+    if (QFileInfo::exists(handlerPath))
+    {
+        // Same backslash requirement as currentBinaryPath()
+        return handlerPath.replace('/', '\\');
+    }
+    return currentBinaryPath();
+}
+
 } // namespace uncopener
 
 #endif // Q_OS_WIN
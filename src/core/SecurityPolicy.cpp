@@ -1,8 +1,83 @@
 #include "SecurityPolicy.hpp"
 
+#include <QSet>
+
 namespace uncopener
 {
 
+namespace
+{
+
+/// Validate, normalize and deduplicate list entries in linear time
+/// Duplicates are detected case-insensitively; the first spelling wins
+/// Returns the list of invalid entries that were rejected
+template <typename IsValid, typename Normalize>
+QStringList buildEntryList(const QStringList& entries, IsValid isValid, Normalize normalize,
+                           QStringList& result)
+{
+    QStringList rejected;
+    result.clear();
+    result.reserve(entries.size());
+
+    QSet<QString> seen;
+    seen.reserve(entries.size());
+
+    for (const QString& entry : entries)
+    {
+        if (!isValid(entry))
+        {
+            rejected.append(entry);
+            continue;
+        }
+
+        QString normalized = normalize(entry);
+        QString key = normalized.toCaseFolded();
+        if (!seen.contains(key))
+        {
+            seen.insert(key);
+            result.append(normalized);
+        }
+    }
+    return rejected;
+}
+
+/// Rebuild a matcher from a list; lookups return indices into the list
+void buildMatcher(const QStringList& entries, CaseFoldedTrie& matcher)
+{
+    matcher.clear();
+    for (qsizetype i = 0; i < entries.size(); ++i)
+    {
+        matcher.insert(entries.at(i), i);
+    }
+}
+
+} // namespace
+
+PolicyCheckResult PolicyVerdict::toCheckResult() const
+{
+    switch (reason)
+    {
+    case Reason::None:
+        return PolicyCheckResult::allow(matchedRule);
+    case Reason::NotInAllowList:
+        return PolicyCheckResult::deny("Path not in allow-list",
+                                       "The UNC path does not match any allowed path prefix. "
+                                       "Add an appropriate prefix to the allow-list in settings.",
+                                       matchedRule);
+    case Reason::FiletypeNotWhitelisted:
+        return PolicyCheckResult::deny("File type not in whitelist",
+                                       "This file type is not allowed. Only files with "
+                                       "whitelisted extensions can be opened.",
+                                       matchedRule);
+    case Reason::FiletypeBlacklisted:
+        return PolicyCheckResult::deny(
+            "File type is blacklisted",
+            "This file type has been blocked. Files with this extension cannot be opened.",
+            matchedRule);
+    }
+    return PolicyCheckResult::allow(matchedRule);
+}
+
 // UncAllowList implementation
 
 bool UncAllowList::isValidEntry(const QString& entry)
@@ -44,6 +119,7 @@ bool UncAllowList::addEntry(const QString& entry)
     QString normalized = normalizeEntry(entry);
     if (!m_entries.contains(normalized, Qt::CaseInsensitive))
     {
+        m_matcher.insert(normalized, m_entries.size());
         m_entries.append(normalized);
     }
     return true;
@@ -51,16 +127,21 @@ bool UncAllowList::addEntry(const QString& entry)
 
 QStringList UncAllowList::setEntries(const QStringList& entries)
 {
-    QStringList rejected;
-    m_entries.clear();
-    for (const QString& entry : entries)
+    QStringList rejected = buildEntryList(entries, isValidEntry, normalizeEntry, m_entries);
+    buildMatcher(m_entries, m_matcher);
+    return rejected;
+}
+
+qsizetype UncAllowList::matchIndex(QStringView uncPath) const
+{
+    // Entries only contain backslashes, so normalize the path the same way
+    if (uncPath.contains(u'/'))
     {
-        if (!addEntry(entry))
-        {
-            rejected.append(entry);
-        }
+        QString normalizedPath = uncPath.toString();
+        normalizedPath.replace('/', '\\');
+        return m_matcher.longestMatch(normalizedPath);
     }
-    return rejected;
+    return m_matcher.longestMatch(uncPath);
 }
 
 PolicyCheckResult UncAllowList::check(const QString& uncPath) const
@@ -71,22 +152,14 @@ PolicyCheckResult UncAllowList::check(const QString& uncPath) const
         return PolicyCheckResult::allow();
     }
 
-    // Normalize the path for comparison
-    QString normalizedPath = uncPath;
-    normalizedPath.replace('/', '\\');
-
-    // Check against each entry (case-insensitive prefix match)
-    for (const QString& entry : m_entries)
+    // Case-insensitive plain string-prefix match against all entries in one pass
+    qsizetype index = matchIndex(uncPath);
+    if (index != CaseFoldedTrie::NO_MATCH)
     {
-        if (normalizedPath.startsWith(entry, Qt::CaseInsensitive))
-        {
-            return PolicyCheckResult::allow();
-        }
+        return PolicyCheckResult::allow(m_entries.at(index));
     }
 
-    return PolicyCheckResult::deny("Path not in allow-list",
-                                   "The UNC path does not match any allowed path prefix. "
-                                   "Add an appropriate prefix to the allow-list in settings.");
+    return PolicyVerdict{PolicyVerdict::Reason::NotInAllowList, {}}.toCheckResult();
 }
 
 // FiletypePolicy implementation
@@ -121,6 +194,7 @@ bool FiletypePolicy::addWhitelistEntry(const QString& extension)
     QString normalized = normalizeExtension(extension);
     if (!m_whitelist.contains(normalized, Qt::CaseInsensitive))
     {
+        m_whitelistMatcher.insert(normalized, m_whitelist.size());
         m_whitelist.append(normalized);
     }
     return true;
@@ -135,6 +209,7 @@ bool FiletypePolicy::addBlacklistEntry(const QString& extension)
     QString normalized = normalizeExtension(extension);
     if (!m_blacklist.contains(normalized, Qt::CaseInsensitive))
     {
+        m_blacklistMatcher.insert(normalized, m_blacklist.size());
         m_blacklist.append(normalized);
     }
     return true;
@@ -142,36 +217,22 @@ bool FiletypePolicy::addBlacklistEntry(const QString& extension)
 
 QStringList FiletypePolicy::setWhitelist(const QStringList& extensions)
 {
-    QStringList rejected;
-    m_whitelist.clear();
-    for (const QString& ext : extensions)
-    {
-        if (!addWhitelistEntry(ext))
-        {
-            rejected.append(ext);
-        }
-    }
+    QStringList rejected =
+        buildEntryList(extensions, isValidExtension, normalizeExtension, m_whitelist);
+    buildMatcher(m_whitelist, m_whitelistMatcher);
     return rejected;
 }
 
 QStringList FiletypePolicy::setBlacklist(const QStringList& extensions)
 {
-    QStringList rejected;
-    m_blacklist.clear();
-    for (const QString& ext : extensions)
-    {
-        if (!addBlacklistEntry(ext))
-        {
-            rejected.append(ext);
-        }
-    }
+    QStringList rejected =
+        buildEntryList(extensions, isValidExtension, normalizeExtension, m_blacklist);
+    buildMatcher(m_blacklist, m_blacklistMatcher);
     return rejected;
 }
 
 PolicyCheckResult FiletypePolicy::check(const QString& filename) const
 {
-    QString lowercaseFilename = filename.toLower();
-
     if (m_mode == FiletypeMode::Whitelist)
     {
         // In whitelist mode, empty whitelist allows everything (permissive by default)
@@ -181,17 +242,13 @@ PolicyCheckResult FiletypePolicy::check(const QString& filename) const
         }
 
         // Check if filename ends with any whitelisted extension
-        for (const QString& ext : m_whitelist)
+        qsizetype index = matchIndex(filename);
+        if (index != CaseFoldedTrie::NO_MATCH)
         {
-            if (lowercaseFilename.endsWith(ext, Qt::CaseInsensitive))
-            {
-                return PolicyCheckResult::allow();
-            }
+            return PolicyCheckResult::allow(m_whitelist.at(index));
         }
 
-        return PolicyCheckResult::deny(
-            "File type not in whitelist",
-            "This file type is not allowed. Only files with whitelisted extensions can be opened.");
+        return PolicyVerdict{PolicyVerdict::Reason::FiletypeNotWhitelisted, {}}.toCheckResult();
     }
 
     // Blacklist mode
@@ -201,46 +258,72 @@ PolicyCheckResult FiletypePolicy::check(const QString& filename) const
     }
 
     // Check if filename ends with any blacklisted extension
-    for (const QString& ext : m_blacklist)
+    qsizetype index = matchIndex(filename);
+    if (index != CaseFoldedTrie::NO_MATCH)
     {
-        if (lowercaseFilename.endsWith(ext, Qt::CaseInsensitive))
-        {
-            return PolicyCheckResult::deny(
-                "File type is blacklisted",
-                "This file type has been blocked. Files with this extension cannot be opened.");
-        }
+        return PolicyVerdict{PolicyVerdict::Reason::FiletypeBlacklisted, m_blacklist.at(index)}
+            .toCheckResult();
     }
 
     return PolicyCheckResult::allow();
 }
 
+qsizetype FiletypePolicy::matchIndex(QStringView filename) const
+{
+    const CaseFoldedTrie& matcher =
+        m_mode == FiletypeMode::Whitelist ? m_whitelistMatcher : m_blacklistMatcher;
+    return matcher.longestMatch(filename);
+}
+
 // SecurityPolicy implementation
 
-PolicyCheckResult SecurityPolicy::check(const QString& uncPath) const
+PolicyVerdict SecurityPolicy::decide(QStringView uncPath) const
 {
-    // First check the UNC allow-list
-    PolicyCheckResult uncResult = m_uncAllowList.check(uncPath);
-    if (!uncResult.allowed)
+    PolicyVerdict verdict;
+
+    // An empty allow-list allows everything
+    const QStringList& allowList = m_uncAllowList.entries();
+    if (!allowList.isEmpty())
+    {
+        qsizetype index = m_uncAllowList.matchIndex(uncPath);
+        if (index == CaseFoldedTrie::NO_MATCH)
+        {
+            verdict.reason = PolicyVerdict::Reason::NotInAllowList;
+            return verdict;
+        }
+        verdict.matchedRule = allowList.at(index);
+    }
+
+    // An empty list of the current mode allows every filetype
+    const bool whitelistMode = m_filetypePolicy.mode() == FiletypeMode::Whitelist;
+    const QStringList& extensions =
+        whitelistMode ? m_filetypePolicy.whitelist() : m_filetypePolicy.blacklist();
+    QStringView filename = uncPath.sliced(uncPath.lastIndexOf(u'\\') + 1);
+    if (filename.isEmpty() || extensions.isEmpty())
     {
-        return uncResult;
+        return verdict;
     }
 
-    // Then check the filetype policy
-    // Extract the filename from the UNC path
-    QString filename = uncPath;
-    qsizetype lastSlash = uncPath.lastIndexOf('\\');
-    if (lastSlash >= 0)
+    qsizetype index = m_filetypePolicy.matchIndex(filename);
+    if (whitelistMode && index == CaseFoldedTrie::NO_MATCH)
+    {
+        return {PolicyVerdict::Reason::FiletypeNotWhitelisted, {}};
+    }
+    if (!whitelistMode && index != CaseFoldedTrie::NO_MATCH)
     {
-        filename = uncPath.mid(lastSlash + 1);
+        return {PolicyVerdict::Reason::FiletypeBlacklisted, extensions.at(index)};
     }
 
-    // If filename is empty (path ends with slash), skip filetype check
-    if (filename.isEmpty())
+    if (whitelistMode && verdict.matchedRule.isEmpty())
     {
-        return PolicyCheckResult::allow();
+        verdict.matchedRule = extensions.at(index);
     }
+    return verdict;
+}
 
-    return m_filetypePolicy.check(filename);
+PolicyCheckResult SecurityPolicy::check(const QString& uncPath) const
+{
+    return decide(uncPath).toCheckResult();
 }
 
 } // namespace uncopener
@@ -1,6 +1,8 @@
 #ifndef UNCOPENER_SECURITYPOLICY_HPP
 #define UNCOPENER_SECURITYPOLICY_HPP
 
+#include "CaseFoldedTrie.hpp"
+
 #include <QString>
 #include <QStringList>
 
@@ -16,17 +18,43 @@ struct PolicyCheckResult
     bool allowed = false;
     QString reason;      // Why the check failed (empty if allowed)
     QString remediation; // How to fix the issue (empty if allowed)
+    QString matchedRule; // Policy entry that decided the check (empty if none did)
 
-    [[nodiscard]] static PolicyCheckResult allow() { return {true, {}, {}}; }
+    [[nodiscard]] static PolicyCheckResult allow(const QString& matchedRule = {})
+    {
+        return {true, {}, {}, matchedRule};
+    }
 
-    [[nodiscard]] static PolicyCheckResult deny(const QString& reason, const QString& remediation)
+    [[nodiscard]] static PolicyCheckResult deny(const QString& reason, const QString& remediation,
+                                                const QString& matchedRule = {})
     {
-        return {false, reason, remediation};
+        return {false, reason, remediation, matchedRule};
     }
 };
 
+/// Verdict of a security policy check as a stable code; no human-readable messages are built
+struct PolicyVerdict
+{
+    enum class Reason : std::uint8_t
+    {
+        None,                   // Allowed
+        NotInAllowList,         // No allow-list entry is a prefix of the path
+        FiletypeNotWhitelisted, // Whitelist mode and no whitelisted extension matches
+        FiletypeBlacklisted,    // Blacklist mode and a blacklisted extension matches
+    };
+
+    Reason reason = Reason::None;
+    QString matchedRule; // Policy entry that decided the verdict (empty if none did)
+
+    [[nodiscard]] bool allowed() const { return reason == Reason::None; }
+
+    /// Convert to a check result with the messages for the user
+    [[nodiscard]] PolicyCheckResult toCheckResult() const;
+};
+
 /// UNC allow-list policy
 /// Checks if a UNC path starts with any entry in the allow-list
+/// Entries are compiled into a case-folded prefix trie, so a check costs O(path length)
 class UncAllowList
 {
 public:
@@ -40,15 +68,24 @@ public:
     QStringList setEntries(const QStringList& entries);
 
     /// Get all current entries
-    [[nodiscard]] QStringList entries() const { return m_entries; }
+    [[nodiscard]] const QStringList& entries() const { return m_entries; }
 
     /// Clear all entries
-    void clear() { m_entries.clear(); }
+    void clear()
+    {
+        m_entries.clear();
+        m_matcher.clear();
+    }
 
     /// Check if a UNC path is allowed
     /// The path should be in UNC format (e.g., "\\server\share\path")
+    /// On success, matchedRule holds the longest matching entry
     [[nodiscard]] PolicyCheckResult check(const QString& uncPath) const;
 
+    /// Get the index in entries() of the longest entry the path starts with
+    /// Returns CaseFoldedTrie::NO_MATCH if no entry matches
+    [[nodiscard]] qsizetype matchIndex(QStringView uncPath) const;
+
     /// Check if an entry is valid (no forward slashes, not empty)
     [[nodiscard]] static bool isValidEntry(const QString& entry);
 
@@ -57,6 +94,7 @@ public:
 
 private:
     QStringList m_entries;
+    CaseFoldedTrie m_matcher;
 };
 
 /// Filetype policy mode
@@ -67,6 +105,7 @@ enum class FiletypeMode : std::uint8_t
 };
 
 /// Filetype allow/deny policy
+/// Extensions are compiled into reversed case-folded tries, so a check costs O(filename length)
 class FiletypePolicy
 {
 public:
@@ -93,21 +132,35 @@ public:
     QStringList setBlacklist(const QStringList& extensions);
 
     /// Get whitelist entries
-    [[nodiscard]] QStringList whitelist() const { return m_whitelist; }
+    [[nodiscard]] const QStringList& whitelist() const { return m_whitelist; }
 
     /// Get blacklist entries
-    [[nodiscard]] QStringList blacklist() const { return m_blacklist; }
+    [[nodiscard]] const QStringList& blacklist() const { return m_blacklist; }
 
     /// Clear the whitelist
-    void clearWhitelist() { m_whitelist.clear(); }
+    void clearWhitelist()
+    {
+        m_whitelist.clear();
+        m_whitelistMatcher.clear();
+    }
 
     /// Clear the blacklist
-    void clearBlacklist() { m_blacklist.clear(); }
+    void clearBlacklist()
+    {
+        m_blacklist.clear();
+        m_blacklistMatcher.clear();
+    }
 
     /// Check if a filename is allowed based on its extension
-    /// Uses case-insensitive ends-with comparison
+    /// Uses case-insensitive ends-with comparison in one backward pass over the filename
+    /// matchedRule holds the longest matching extension (e.g. ".pdf.exe" over ".exe")
     [[nodiscard]] PolicyCheckResult check(const QString& filename) const;
 
+    /// Get the index of the longest extension the filename ends with, in whitelist() or
+    /// blacklist() depending on the mode
+    /// Returns CaseFoldedTrie::NO_MATCH if no extension matches
+    [[nodiscard]] qsizetype matchIndex(QStringView filename) const;
+
     /// Check if an extension entry is valid (no path separators)
     [[nodiscard]] static bool isValidExtension(const QString& extension);
 
@@ -118,6 +171,8 @@ private:
     FiletypeMode m_mode = FiletypeMode::Whitelist;
     QStringList m_whitelist;
     QStringList m_blacklist;
+    CaseFoldedTrie m_whitelistMatcher{CaseFoldedTrie::Direction::Backward};
+    CaseFoldedTrie m_blacklistMatcher{CaseFoldedTrie::Direction::Backward};
 };
 
 /// Combined security policy validator
@@ -132,8 +187,13 @@ public:
     [[nodiscard]] FiletypePolicy& filetypePolicy() { return m_filetypePolicy; }
     [[nodiscard]] const FiletypePolicy& filetypePolicy() const { return m_filetypePolicy; }
 
+    /// Run all security checks on a UNC path: the allow-list first, then the filetype of the last
+    /// path segment (paths ending with a backslash have none and skip it)
+    /// An allowed path reports the allow-list entry, or the extension if there is no allow-list
+    [[nodiscard]] PolicyVerdict decide(QStringView uncPath) const;
+
     /// Run all security checks on a UNC path
-    /// Returns the first failed check result, or success if all pass
+    /// Same verdict as decide(), with the messages of the first failed check
     [[nodiscard]] PolicyCheckResult check(const QString& uncPath) const;
 
 private:
@@ -0,0 +1,70 @@
+#include "ServerAliases.hpp"
+
+namespace uncopener
+{
+
+bool ServerAliases::isValidName(const QString& name)
+{
+    QString trimmed = name.trimmed();
+    return !trimmed.isEmpty() && !trimmed.contains('/') && !trimmed.contains('\\');
+}
+
+QStringList ServerAliases::setAliases(const QMap<QString, QString>& aliases)
+{
+    m_canonical.clear();
+    m_canonical.reserve(aliases.size());
+
+    QStringList rejected;
+    for (auto it = aliases.constBegin(); it != aliases.constEnd(); ++it)
+    {
+        if (!isValidName(it.key()) || !isValidName(it.value()))
+        {
+            rejected.append(it.key());
+            continue;
+        }
+
+        // An alias of itself would only cost a lookup
+        QString alias = it.key().trimmed().toCaseFolded();
+        QString canonical = it.value().trimmed();
+        if (alias != canonical.toCaseFolded() && !m_canonical.contains(alias))
+        {
+            m_canonical.insert(alias, canonical);
+        }
+    }
+    return rejected;
+}
+
+QString ServerAliases::canonicalName(const QString& server) const
+{
+    if (m_canonical.isEmpty())
+    {
+        return server;
+    }
+    return m_canonical.value(server.toCaseFolded(), server);
+}
+
+bool ServerAliases::canonicalize(UncPath& path) const
+{
+    if (m_canonical.isEmpty())
+    {
+        return false;
+    }
+
+    auto it = m_canonical.constFind(path.server.toCaseFolded());
+    if (it == m_canonical.constEnd())
+    {
+        return false;
+    }
+    path.server = it.value();
+    return true;
+}
+
+void ServerAliases::canonicalize(ParseResult& result) const
+{
+    if (UncPath* path = std::get_if<UncPath>(&result))
+    {
+        canonicalize(*path);
+    }
+}
+
+} // namespace uncopener
@@ -0,0 +1,55 @@
+#ifndef UNCOPENER_SERVERALIASES_HPP
+#define UNCOPENER_SERVERALIASES_HPP
+
+#include "UrlParser.hpp"
+
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+namespace uncopener
+{
+
+/// Rewrites the names a server is known by (short names, FQDNs, old names of migrated servers,
+/// DFS namespaces) to one canonical name
+/// Applied right after parsing, so the allow-list needs one entry per server and all spellings
+/// open the same target. A lookup is one hash lookup of the case-folded name; aliases are not
+/// chained, i.e. the canonical name of an alias is not looked up again.
+class ServerAliases
+{
+public:
+    /// Set all aliases at once from alias to canonical name (replaces existing aliases)
+    /// Aliases are matched case-insensitively; the first of several spellings wins
+    /// Returns the list of aliases that were rejected because either name is invalid
+    QStringList setAliases(const QMap<QString, QString>& aliases);
+
+    /// Check if there are no aliases
+    [[nodiscard]] bool isEmpty() const { return m_canonical.isEmpty(); }
+
+    /// Get the number of aliases
+    [[nodiscard]] qsizetype size() const { return m_canonical.size(); }
+
+    /// Remove all aliases
+    void clear() { m_canonical.clear(); }
+
+    /// Get the canonical name of a server, or the name itself if it is no alias
+    [[nodiscard]] QString canonicalName(const QString& server) const;
+
+    /// Rewrite the server of a path to its canonical name
+    /// Returns true if the server was an alias
+    bool canonicalize(UncPath& path) const;
+
+    /// Rewrite the server of a successful parse result to its canonical name
+    void canonicalize(ParseResult& result) const;
+
+    /// Check if a server name is valid (not empty, no path separators)
+    [[nodiscard]] static bool isValidName(const QString& name);
+
+private:
+    QHash<QString, QString> m_canonical; // Case-folded alias -> canonical name
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_SERVERALIASES_HPP
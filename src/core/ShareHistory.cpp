@@ -0,0 +1,198 @@
+#include "ShareHistory.hpp"
+
+#include "Config.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSet>
+
+#include <algorithm>
+#include <utility>
+
+namespace uncopener
+{
+
+namespace
+{
+
+const QString KEY_SHARES = "shares";
+const QString KEY_SERVER = "server";
+const QString KEY_SHARE = "share";
+const QString KEY_COUNT = "count";
+const QString KEY_LAST_OPENED = "lastOpened";
+
+QString keyOf(const QString& server, const QString& share)
+{
+    return (server + '\\' + share).toCaseFolded();
+}
+
+/// Order for mostUsed(): more opens first, then the more recent open
+bool usedMore(const ShareUse& a, const ShareUse& b)
+{
+    if (a.count != b.count)
+    {
+        return a.count > b.count;
+    }
+    return a.lastOpenedMs > b.lastOpenedMs;
+}
+
+} // namespace
+
+ShareHistory::ShareHistory(QString filePath) : m_filePath(std::move(filePath)) {}
+
+QString ShareHistory::defaultFilePath()
+{
+    return Config::configDirPath() + "/share-history.json";
+}
+
+bool ShareHistory::load()
+{
+    m_entries.clear();
+    m_index.clear();
+
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isObject())
+    {
+        return false;
+    }
+
+    const QJsonArray shares = doc.object().value(KEY_SHARES).toArray();
+    for (const QJsonValue& value : shares)
+    {
+        QJsonObject object = value.toObject();
+        ShareUse use{object.value(KEY_SERVER).toString(), object.value(KEY_SHARE).toString(),
+                     object.value(KEY_COUNT).toInteger(),
+                     object.value(KEY_LAST_OPENED).toInteger()};
+        QString key = keyOf(use.server, use.share);
+        if (use.server.isEmpty() || use.share.isEmpty() || use.count <= 0 ||
+            m_index.contains(key))
+        {
+            continue;
+        }
+        m_index.insert(key, m_entries.size());
+        m_entries.append(use);
+    }
+    prune();
+    return true;
+}
+
+bool ShareHistory::save() const
+{
+    QDir dir = QFileInfo(m_filePath).dir();
+    if (!dir.exists() && !dir.mkpath("."))
+    {
+        return false;
+    }
+
+    QJsonArray shares;
+    for (const ShareUse& use : m_entries)
+    {
+        shares.append(QJsonObject{{KEY_SERVER, use.server},
+                                  {KEY_SHARE, use.share},
+                                  {KEY_COUNT, use.count},
+                                  {KEY_LAST_OPENED, use.lastOpenedMs}});
+    }
+
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    QByteArray data = QJsonDocument(QJsonObject{{KEY_SHARES, shares}}).toJson();
+    if (file.write(data) != data.size())
+    {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+bool ShareHistory::record(const UncPath& path)
+{
+    return record(path, QDateTime::currentMSecsSinceEpoch());
+}
+
+bool ShareHistory::record(const UncPath& path, qint64 nowMs)
+{
+    QString share = shareOf(path);
+    if (path.server.isEmpty() || share.isEmpty())
+    {
+        return false;
+    }
+
+    QString key = keyOf(path.server, share);
+    auto it = m_index.constFind(key);
+    if (it != m_index.constEnd())
+    {
+        ShareUse& use = m_entries[it.value()];
+        ++use.count;
+        use.lastOpenedMs = nowMs;
+    }
+    else
+    {
+        m_index.insert(key, m_entries.size());
+        m_entries.append({path.server, share, 1, nowMs});
+        prune();
+    }
+    return save();
+}
+
+QList<ShareUse> ShareHistory::mostUsed(qsizetype count) const
+{
+    QList<ShareUse> result = m_entries;
+    std::stable_sort(result.begin(), result.end(), usedMore);
+    if (result.size() > count)
+    {
+        result.resize(std::max<qsizetype>(count, 0));
+    }
+    return result;
+}
+
+QString ShareHistory::shareOf(const UncPath& path)
+{
+    return path.path.section('\\', 0, 0, QString::SectionSkipEmpty);
+}
+
+void ShareHistory::prune()
+{
+    if (m_entries.size() <= MAX_SHARES)
+    {
+        return;
+    }
+
+    // Keep the most used shares, in the order they were first opened
+    QList<ShareUse> kept = mostUsed(MAX_SHARES);
+    QSet<QString> keys;
+    for (const ShareUse& use : std::as_const(kept))
+    {
+        keys.insert(keyOf(use.server, use.share));
+    }
+
+    QList<ShareUse> entries;
+    m_index.clear();
+    for (const ShareUse& use : std::as_const(m_entries))
+    {
+        QString key = keyOf(use.server, use.share);
+        if (keys.contains(key))
+        {
+            m_index.insert(key, entries.size());
+            entries.append(use);
+        }
+    }
+    m_entries = std::move(entries);
+}
+
+} // namespace uncopener
@@ -0,0 +1,76 @@
+#ifndef UNCOPENER_SHAREHISTORY_HPP
+#define UNCOPENER_SHAREHISTORY_HPP
+
+#include "UrlParser.hpp"
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+namespace uncopener
+{
+
+/// How often a share was opened
+struct ShareUse
+{
+    QString server;
+    QString share;
+    qint64 count = 0;
+    qint64 lastOpenedMs = 0; // Milliseconds since the epoch
+
+    /// Get the root of the share
+    [[nodiscard]] UncPath path() const { return {server, share, false}; }
+};
+
+/// Per-share open history, stored as share-history.json in the config directory
+/// MountPrewarmer mounts the most used shares ahead of the first click. Shares are compared
+/// case-insensitively; the spelling of the first open is kept. Not thread-safe.
+class ShareHistory
+{
+public:
+    /// Upper bound of remembered shares; the least used ones are dropped beyond it
+    static constexpr qsizetype MAX_SHARES = 256;
+
+    explicit ShareHistory(QString filePath = defaultFilePath());
+
+    /// Get the default history file path
+    [[nodiscard]] static QString defaultFilePath();
+
+    /// Get the file the history is loaded from and saved to
+    [[nodiscard]] QString filePath() const { return m_filePath; }
+
+    /// Load the history file
+    /// Returns false if it is missing or invalid; the history is empty then
+    bool load();
+
+    /// Save the history file atomically
+    [[nodiscard]] bool save() const;
+
+    /// Count an open of the share of a path and save the history
+    /// Returns false if the path names no share or the history could not be saved
+    bool record(const UncPath& path);
+
+    /// Count an open at a given time in milliseconds since the epoch (for tests)
+    bool record(const UncPath& path, qint64 nowMs);
+
+    /// Get up to count shares, most opened first and the more recent one first on ties
+    [[nodiscard]] QList<ShareUse> mostUsed(qsizetype count) const;
+
+    /// Get all shares in the order they were first opened
+    [[nodiscard]] const QList<ShareUse>& entries() const { return m_entries; }
+
+    /// Get the share of a path, i.e. its first segment; empty if the path names no share
+    [[nodiscard]] static QString shareOf(const UncPath& path);
+
+private:
+    /// Drop the least used shares down to MAX_SHARES and rebuild the index
+    void prune();
+
+    QString m_filePath;
+    QList<ShareUse> m_entries;
+    QHash<QString, qsizetype> m_index; // Case-folded "server\share" -> index in m_entries
+};
+
+} // namespace uncopener
+
+#endif // UNCOPENER_SHAREHISTORY_HPP
@@ -1,7 +1,6 @@
 #include "UrlParser.hpp"
 
 #include <QByteArray>
-#include <QStringList>
 #include <QUrl>
 
 #include <utility>
@@ -9,6 +8,144 @@
 namespace uncopener
 {
 
+namespace
+{
+
+/// Stack capacity for decoding; longer paths fall back to the heap
+constexpr qsizetype DECODE_BUFFER_SIZE = 512;
+
+/// Value of a hex digit, or -1
+int hexValue(QChar c)
+{
+    char16_t unit = c.unicode();
+    if (unit >= u'0' && unit <= u'9')
+    {
+        return unit - u'0';
+    }
+    if (unit >= u'a' && unit <= u'f')
+    {
+        return unit - u'a' + 10;
+    }
+    if (unit >= u'A' && unit <= u'F')
+    {
+        return unit - u'A' + 10;
+    }
+    return -1;
+}
+
+/// Percent-decode text with the result of QUrl::fromPercentEncoding(text.toUtf8())
+/// The UTF-8 bytes are built in a stack buffer; only the returned string is allocated.
+/// Inputs Qt decodes in unusual ways (invalid escapes, lone surrogates) are left to Qt.
+QString percentDecode(QStringView text)
+{
+    QVarLengthArray<char, DECODE_BUFFER_SIZE> bytes;
+    const qsizetype size = text.size();
+
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        char16_t unit = text[i].unicode();
+
+        if (unit == u'%')
+        {
+            int high = i + 1 < size ? hexValue(text[i + 1]) : -1;
+            int low = i + 2 < size ? hexValue(text[i + 2]) : -1;
+            if (high >= 0 && low >= 0)
+            {
+                bytes.append(static_cast<char>((high << 4) | low));
+                i += 2;
+                continue;
+            }
+
+            // Qt keeps a '%' literally only if fewer than two bytes follow it
+            bool fewerThanTwoBytesFollow =
+                i + 1 == size || (i + 2 == size && text[i + 1].unicode() < 0x80);
+            if (!fewerThanTwoBytesFollow)
+            {
+                return QUrl::fromPercentEncoding(text.toUtf8());
+            }
+            bytes.append('%');
+            continue;
+        }
+
+        // Encode literal characters as UTF-8
+        if (unit < 0x80)
+        {
+            bytes.append(static_cast<char>(unit));
+        }
+        else if (unit < 0x800)
+        {
+            bytes.append(static_cast<char>(0xC0 | (unit >> 6)));
+            bytes.append(static_cast<char>(0x80 | (unit & 0x3F)));
+        }
+        else if (!QChar::isSurrogate(unit))
+        {
+            bytes.append(static_cast<char>(0xE0 | (unit >> 12)));
+            bytes.append(static_cast<char>(0x80 | ((unit >> 6) & 0x3F)));
+            bytes.append(static_cast<char>(0x80 | (unit & 0x3F)));
+        }
+        else if (QChar::isHighSurrogate(unit) && i + 1 < size && text[i + 1].isLowSurrogate())
+        {
+            char32_t codePoint = QChar::surrogateToUcs4(unit, text[i + 1].unicode());
+            bytes.append(static_cast<char>(0xF0 | (codePoint >> 18)));
+            bytes.append(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            bytes.append(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            bytes.append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            ++i;
+        }
+        else
+        {
+            return QUrl::fromPercentEncoding(text.toUtf8());
+        }
+    }
+
+    return QString::fromUtf8(bytes.constData(), bytes.size());
+}
+
+/// Join path segments with backslashes, percent-decoding the result if needed
+QString joinPath(const UrlSpans::Segments& segments, bool encoded)
+{
+    if (segments.isEmpty())
+    {
+        return {};
+    }
+
+    qsizetype length = segments.size() - 1;
+    for (QStringView segment : segments)
+    {
+        length += segment.size();
+    }
+
+    if (!encoded)
+    {
+        QString path;
+        path.reserve(length);
+        for (QStringView segment : segments)
+        {
+            if (!path.isEmpty())
+            {
+                path += u'\\';
+            }
+            path += segment;
+        }
+        return path;
+    }
+
+    // Escapes may not be complete within a segment, so decode the joined path as a whole
+    QVarLengthArray<QChar, DECODE_BUFFER_SIZE> joined;
+    joined.reserve(length);
+    for (QStringView segment : segments)
+    {
+        if (!joined.isEmpty())
+        {
+            joined.append(u'\\');
+        }
+        joined.append(segment.constData(), segment.size());
+    }
+    return percentDecode(QStringView(joined.constData(), joined.size()));
+}
+
+} // namespace
+
 QString UncPath::toUncString() const
 {
     QString result = R"(\\)" + server;
@@ -47,6 +184,25 @@ QString UncPath::toSmbUrl(const QString& username) const
     return result;
 }
 
+bool UncPath::isConfined() const
+{
+    qsizetype start = 0;
+    for (qsizetype i = 0; i <= path.size(); ++i)
+    {
+        if (i < path.size() && path.at(i) != '\\' && path.at(i) != '/')
+        {
+            continue;
+        }
+        QStringView segment = QStringView(path).sliced(start, i - start);
+        if (segment == u"." || segment == u"..")
+        {
+            return false;
+        }
+        start = i + 1;
+    }
+    return true;
+}
+
 ParseError ParseError::create(Code code, const QString& input, const QString& expectedScheme,
                               const QString& foundScheme)
 {
@@ -118,191 +274,196 @@ ParseError ParseError::create(Code code, const QString& input, const QString& ex
 
 UrlParser::UrlParser(QString schemeName) : m_schemeName(std::move(schemeName)) {}
 
-QString UrlParser::percentDecode(const QString& input)
+std::optional<ParseError::Code> UrlParser::scan(QStringView input, UrlSpans& spans) const
 {
-    return QUrl::fromPercentEncoding(input.toUtf8());
-}
+    spans = UrlSpans();
 
-std::optional<QString> UrlParser::normalizePath(const QString& path, bool& hasTrailingSlash)
-{
-    if (path.isEmpty())
+    if (input.isEmpty())
     {
-        // Don't modify hasTrailingSlash - caller has already determined it
-        return QString();
+        return ParseError::Code::EmptyInput;
     }
 
-    // Check for trailing slash before normalization
-    hasTrailingSlash = path.endsWith('/') || path.endsWith('\\');
-
-    // Split the path into segments
-    // Replace backslashes with forward slashes first for uniform processing
-    QString normalizedPath = path;
-    normalizedPath.replace('\\', '/');
+    // Expected format: scheme://server/share/path (scheme is case-sensitive)
+    const qsizetype schemeLength = m_schemeName.size();
+    if (!input.startsWith(m_schemeName) || !input.sliced(schemeLength).startsWith(u"://"))
+    {
+        return schemeErrorCode(input);
+    }
 
-    QStringList segments = normalizedPath.split('/', Qt::SkipEmptyParts);
-    QStringList resultSegments;
+    // One pass over the remainder: authority up to the first '/', then the path segments
+    // separated by '/' or '\', up to a query or fragment (they are ignored per the contract)
+    const qsizetype start = schemeLength + 3;
+    qsizetype end = input.size();
+    qsizetype firstSlash = -1;
+    qsizetype segmentStart = -1;
+    bool traversal = false;
+    bool encoded = false;
 
-    for (const QString& segment : segments)
+    auto closeSegment = [&](qsizetype segmentEnd)
     {
-        if (segment == "..")
+        QStringView segment = input.sliced(segmentStart, segmentEnd - segmentStart);
+        if (segment == u"..")
         {
-            // Directory traversal detected - reject
-            return std::nullopt;
+            traversal = true;
         }
-        if (segment == ".")
+        else if (!segment.isEmpty() && segment != u".")
         {
-            // Skip single-dot segments
-            continue;
+            spans.segments.append(segment);
         }
-        resultSegments.append(segment);
-    }
-
-    // Convert back to backslash-separated path for UNC
-    return resultSegments.join('\\');
-}
+    };
 
-std::optional<ParseError> UrlParser::checkScheme(const QString& input) const
-{
-    QString schemePrefix = m_schemeName + "://";
-    QString singleSlashPrefix = m_schemeName + ":/";
-
-    // Check for single slash format (invalid)
-    if (input.startsWith(singleSlashPrefix) && !input.startsWith(schemePrefix))
+    for (qsizetype i = start; i < end; ++i)
     {
-        return ParseError::create(ParseError::Code::InvalidSchemeFormat, input, m_schemeName);
-    }
+        char16_t c = input[i].unicode();
+        if (c == u'?' || c == u'#')
+        {
+            end = i;
+            break;
+        }
 
-    // Check scheme
-    if (!input.startsWith(schemePrefix))
-    {
-        // Check if there's a different scheme
-        qsizetype colonPos = input.indexOf(':');
-        if (colonPos > 0)
+        // Percent signs and surrogates need the decoding step, everything else is copied as-is
+        encoded = encoded || c == u'%' || QChar::isSurrogate(c);
+
+        if (firstSlash < 0)
         {
-            // Ensure colon is before any path separator causing it to look like a scheme
-            qsizetype slashPos = input.indexOf('/');
-            if (slashPos < 0 || colonPos < slashPos)
+            if (c == u'/')
             {
-                QString foundScheme = input.left(colonPos);
-                return ParseError::create(ParseError::Code::WrongScheme, input, m_schemeName,
-                                          foundScheme);
+                firstSlash = i;
+                segmentStart = i + 1;
+                spans.authority = input.sliced(start, i - start);
+                spans.authorityEncoded = encoded;
+                encoded = false;
             }
         }
-        return ParseError::create(ParseError::Code::MissingScheme, input, m_schemeName);
+        else if (c == u'/' || c == u'\\')
+        {
+            closeSegment(i);
+            segmentStart = i + 1;
+        }
     }
 
-    return std::nullopt;
-}
-
-QString UrlParser::stripQueryAndFragment(const QString& input)
-{
-    qsizetype queryPos = input.indexOf('?');
-    qsizetype fragmentPos = input.indexOf('#');
-
-    qsizetype cutPos = -1;
-    if (queryPos >= 0 && fragmentPos >= 0)
+    if (firstSlash < 0)
+    {
+        // No path at all, just authority (and possibly no share)
+        spans.authority = input.sliced(start, end - start);
+        spans.authorityEncoded = encoded;
+    }
+    else
     {
-        cutPos = qMin(queryPos, fragmentPos);
+        closeSegment(end);
+        spans.pathEncoded = encoded;
+
+        // "scheme://server/" has an empty path but still a trailing slash
+        QChar last = input[end - 1];
+        spans.hasTrailingSlash = last == u'/' || last == u'\\';
     }
-    else if (queryPos >= 0)
+
+    // Check for empty or whitespace-only authority
+    if (spans.authority.isEmpty())
     {
-        cutPos = queryPos;
+        return ParseError::Code::MissingAuthority;
     }
-    else if (fragmentPos >= 0)
+    if (spans.authority.trimmed().isEmpty())
     {
-        cutPos = fragmentPos;
+        return ParseError::Code::WhitespaceAuthority;
     }
 
-    if (cutPos >= 0)
+    // Directory traversal is checked on the raw segments here; parse() checks the decoded ones
+    if (traversal)
     {
-        return input.left(cutPos);
+        return ParseError::Code::DirectoryTraversal;
     }
-    return input;
+
+    return std::nullopt;
 }
 
-ParseResult UrlParser::parse(const QString& input) const
+ParseError::Code UrlParser::schemeErrorCode(QStringView input) const
 {
-    if (input.isEmpty())
+    // Check for single slash format (invalid)
+    if (input.startsWith(m_schemeName) && input.sliced(m_schemeName.size()).startsWith(u":/"))
     {
-        return ParseError::create(ParseError::Code::EmptyInput, input);
+        return ParseError::Code::InvalidSchemeFormat;
     }
 
-    if (auto error = checkScheme(input))
+    // Check if there's a different scheme
+    qsizetype colonPos = input.indexOf(u':');
+    if (colonPos > 0)
     {
-        return *error;
+        // Ensure colon is before any path separator causing it to look like a scheme
+        qsizetype slashPos = input.indexOf(u'/');
+        if (slashPos < 0 || colonPos < slashPos)
+        {
+            return ParseError::Code::WrongScheme;
+        }
     }
+    return ParseError::Code::MissingScheme;
+}
 
-    // Expected format: scheme://server/share/path
-    QString schemePrefix = m_schemeName + "://";
-
-    // Extract the part after scheme://
-    QString remainder = input.mid(schemePrefix.length());
-
-    // Remove query string and fragment (they are ignored per the contract)
-    remainder = stripQueryAndFragment(remainder);
-
-    // Split by forward slash to get authority and path
-    qsizetype firstSlash = remainder.indexOf('/');
-
-    QString authority;
-    QString pathPart;
-
-    if (firstSlash < 0)
-    {
-        // No path at all, just authority (and possibly no share)
-        authority = remainder;
-    }
-    else
+ParseError UrlParser::createError(ParseError::Code code, const QString& input) const
+{
+    switch (code)
     {
-        authority = remainder.left(firstSlash);
-        pathPart = remainder.mid(firstSlash + 1);
+    case ParseError::Code::EmptyInput:
+    case ParseError::Code::DirectoryTraversal:
+        return ParseError::create(code, input);
+    case ParseError::Code::WrongScheme:
+        return ParseError::create(code, input, m_schemeName, input.left(input.indexOf(':')));
+    case ParseError::Code::MissingScheme:
+    case ParseError::Code::InvalidSchemeFormat:
+    case ParseError::Code::MissingAuthority:
+    case ParseError::Code::WhitespaceAuthority:
+    case ParseError::Code::InvalidCharacter:
+        break;
     }
+    return ParseError::create(code, input, m_schemeName);
+}
 
-    // Check for empty or whitespace-only authority
-    if (authority.isEmpty())
+ParseResult UrlParser::parse(const QString& input) const
+{
+    UncPath path;
+    if (auto code = parse(input, path))
     {
-        return ParseError::create(ParseError::Code::MissingAuthority, input, m_schemeName);
+        return createError(*code, input);
     }
-    if (authority.trimmed().isEmpty())
+    return path;
+}
+
+std::optional<ParseError::Code> UrlParser::parse(QStringView input, UncPath& path) const
+{
+    UrlSpans spans;
+    if (auto code = scan(input, spans))
     {
-        return ParseError::create(ParseError::Code::WhitespaceAuthority, input, m_schemeName);
+        return code;
     }
 
-    // Percent-decode the authority (server name)
-    QString server = percentDecode(authority);
-
-    // Everything else is the path
-    QString rawPath = pathPart;
-    bool hasTrailingSlash = false;
+    path = toPath(spans);
 
-    // Check if there's a trailing slash
-    // Special case: if remainder ends with '/' but pathPart is empty, we still have a trailing
-    // slash (e.g., "server/" means the URL was "scheme://server/")
-    if (!rawPath.isEmpty())
-    {
-        hasTrailingSlash = rawPath.endsWith('/') || rawPath.endsWith('\\');
-    }
-    else if (firstSlash >= 0 && remainder.endsWith('/'))
+    // Escapes can hide separators and dot segments from scan(), so check the decoded parts too
+    if (spans.authorityEncoded && (path.server.contains(u'/') || path.server.contains(u'\\')))
     {
-        // URL like "scheme://server/" - path is empty but there was a trailing slash
-        hasTrailingSlash = true;
+        return ParseError::Code::InvalidCharacter;
     }
-
-    // Normalize the path
-    auto normalizedPath = normalizePath(rawPath, hasTrailingSlash);
-    if (!normalizedPath.has_value())
+    if (spans.pathEncoded)
     {
-        return ParseError::create(ParseError::Code::DirectoryTraversal, input);
+        if (!path.isConfined())
+        {
+            return ParseError::Code::DirectoryTraversal;
+        }
+        if (path.path.contains(u'/') || path.path.count(u'\\') != spans.segments.size() - 1)
+        {
+            return ParseError::Code::InvalidCharacter;
+        }
     }
+    return std::nullopt;
+}
 
-    // Build the result
+UncPath UrlParser::toPath(const UrlSpans& spans)
+{
     UncPath result;
-    result.server = server;
-    // Decode logical path segments (normalizePath returns backslash-separated components)
-    // We want the path part of the UNC string to be properly decoded.
-    result.path = percentDecode(normalizedPath.value());
-    result.hasTrailingSlash = hasTrailingSlash;
-
+    result.server = spans.authorityEncoded ? percentDecode(spans.authority)
+                                           : spans.authority.toString();
+    result.path = joinPath(spans.segments, spans.pathEncoded);
+    result.hasTrailingSlash = spans.hasTrailingSlash;
     return result;
 }
 
@@ -2,6 +2,8 @@
 #define UNCOPENER_URLPARSER_HPP
 
 #include <QString>
+#include <QStringView>
+#include <QVarLengthArray>
 
 #include <cstdint>
 #include <optional>
@@ -22,6 +24,10 @@ struct UncPath
 
     /// Returns the SMB URL for Linux (e.g., "smb://server/path")
     [[nodiscard]] QString toSmbUrl(const QString& username = {}) const;
+
+    /// Returns false if a segment of path is "." or "..", split at both slash types
+    /// Mapping such a path onto a local directory could leave it.
+    [[nodiscard]] bool isConfined() const;
 };
 
 /// Error information for failed URL parsing
@@ -53,6 +59,20 @@ struct ParseError
 /// Result type for URL parsing: either a UncPath or a ParseError
 using ParseResult = std::variant<UncPath, ParseError>;
 
+/// Positions of the parts of a URL, found by UrlParser::scan() in a single pass
+/// All views point into the scanned input; nothing is copied
+struct UrlSpans
+{
+    /// Path segments; empty and "." segments are already dropped
+    using Segments = QVarLengthArray<QStringView, 32>;
+
+    QStringView authority;
+    Segments segments;
+    bool hasTrailingSlash = false;
+    bool authorityEncoded = false; // Authority needs percent-decoding
+    bool pathEncoded = false;      // Path segments need percent-decoding
+};
+
 /// URL parser for converting scheme URLs to UNC paths
 class UrlParser
 {
@@ -60,27 +80,33 @@ public:
     explicit UrlParser(QString schemeName);
 
     /// Parse a URL string and return either a UncPath or ParseError
+    /// Only the strings of the returned UncPath are allocated on success
     [[nodiscard]] ParseResult parse(const QString& input) const;
 
+    /// Parse a URL without building error messages
+    /// Returns the error code if the input is rejected; path is only valid on success. Encoded
+    /// dot segments (%2E%2E) and separators (%2F, %5C) are rejected like their literal forms.
+    [[nodiscard]] std::optional<ParseError::Code> parse(QStringView input, UncPath& path) const;
+
+    /// Locate authority and path segments in one left-to-right pass without allocating
+    /// Returns the error code if the input is rejected; spans are only valid on success
+    [[nodiscard]] std::optional<ParseError::Code> scan(QStringView input, UrlSpans& spans) const;
+
+    /// Build the UncPath of a successful scan(), percent-decoding where needed
+    /// Unlike parse(), the decoded path is not checked for traversal.
+    [[nodiscard]] static UncPath toPath(const UrlSpans& spans);
+
+    /// Build the error for a code returned by scan() or parse()
+    [[nodiscard]] ParseError createError(ParseError::Code code, const QString& input) const;
+
     /// Get the expected scheme name
     [[nodiscard]] QString schemeName() const { return m_schemeName; }
 
 private:
     QString m_schemeName;
 
-    /// Percent-decode a string
-    [[nodiscard]] static QString percentDecode(const QString& input);
-
-    /// Normalize path: collapse slashes, remove dot segments
-    /// Returns nullopt if directory traversal (..) is detected
-    [[nodiscard]] static std::optional<QString> normalizePath(const QString& path,
-                                                              bool& hasTrailingSlash);
-
-    /// Check if the input starts with the correct scheme
-    [[nodiscard]] std::optional<ParseError> checkScheme(const QString& input) const;
-
-    /// Remove query and fragment from the input
-    [[nodiscard]] static QString stripQueryAndFragment(const QString& input);
+    /// Classify an input that does not start with "<scheme>://"
+    [[nodiscard]] ParseError::Code schemeErrorCode(QStringView input) const;
 };
 
 /// Helper functions for working with ParseResult
@@ -0,0 +1,131 @@
+#include "BatchOpener.hpp"
+#include "Config.hpp"
+#include "ConfigCache.hpp"
+#include "NativeMessagingHost.hpp"
+#include "PathOpener.hpp"
+#include "ResidentServer.hpp"
+
+#include <QFile>
+#include <QGuiApplication>
+#include <QProcess>
+
+#include <cstdio>
+
+// Minimal URL handler linking only the core library and QtGui.
+// The widgets binary is started only when a dialog has to be shown.
+
+namespace
+{
+
+const QString SHOW_ERROR_OPTION = "--show-error";
+const QString STDIN_OPTION = "--stdin";
+const QString NATIVE_MESSAGING_OPTION = "--native-messaging";
+
+/// Path of the widgets binary next to this executable
+QString widgetsBinaryPath()
+{
+#ifdef Q_OS_WIN
+    return QCoreApplication::applicationDirPath() + "/uncopener.exe";
+#else
+    return QCoreApplication::applicationDirPath() + "/uncopener";
+#endif
+}
+
+/// Hand the invocation over to the widgets binary
+int delegateToWidgetsBinary(const QStringList& arguments)
+{
+    return QProcess::startDetached(widgetsBinaryPath(), arguments) ? 0 : 1;
+}
+
+/// Handle URL opening mode
+/// A resident instance was tried in main() already
+int runHandlerMode(const QString& url)
+{
+    // Load configuration (from the binary cache when it is fresh)
+    uncopener::Config config;
+    uncopener::ConfigCache::load(config);
+
+    // The resident instance shows dialogs, so it lives in the widgets binary
+    if (config.residentMode())
+    {
+        return delegateToWidgetsBinary({url});
+    }
+
+    // Create path opener and attempt to open
+    uncopener::PathOpener opener = uncopener::PathOpener::fromConfig(config);
+    uncopener::ValidationResult validation = opener.evaluate(url);
+    uncopener::OpenResult result = opener.open(validation);
+    if (result.success)
+    {
+        return 0;
+    }
+
+    delegateToWidgetsBinary({SHOW_ERROR_OPTION, validation.displayPath(), result.errorReason,
+                             result.errorRemediation});
+    return 1;
+}
+
+/// Answer requests of the browser extension until the browser closes the connection
+int runNativeMessagingHost()
+{
+    QFile input;
+    QFile output;
+    if (!uncopener::NativeMessagingHost::openStdio(input, output))
+    {
+        return 1;
+    }
+
+    uncopener::Config config;
+    uncopener::ConfigCache::load(config);
+
+    uncopener::NativeMessagingHost host(config);
+    host.serve(input, output);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // Later clicks hand their URL to a resident instance and exit at once, before the
+    // application object sets up the platform integration
+    if (uncopener::ResidentServer::forwardArguments(argc, argv))
+    {
+        return 0;
+    }
+
+    QGuiApplication app(argc, argv);
+    app.setApplicationName("UncOpener");
+    app.setApplicationVersion("1.0");
+    app.setOrganizationName("bebuch");
+
+    QStringList args = app.arguments();
+
+    // Native messaging replies carry all results, so no dialog is ever needed
+    if ((args.size() == 2 && args.at(1) == NATIVE_MESSAGING_OPTION) ||
+        uncopener::NativeMessagingHost::isHostInvocation(args))
+    {
+        return runNativeMessagingHost();
+    }
+
+    // A batch may end in a summary dialog, so it is opened by the widgets binary. Stdin is
+    // read here because a detached process does not reliably inherit it.
+    if (args.size() == 2 && args.at(1) == STDIN_OPTION)
+    {
+        QFile input;
+        if (!input.open(stdin, QIODevice::ReadOnly))
+        {
+            return 1;
+        }
+        QStringList urls = uncopener::BatchOpener::readUrls(input);
+        return urls.isEmpty() ? 0 : delegateToWidgetsBinary(urls);
+    }
+
+    // Only a single URL is handled here; everything else goes to the widgets binary
+    if (args.size() != 2 || args.at(1).startsWith("--"))
+    {
+        return delegateToWidgetsBinary(args.mid(1));
+    }
+
+    return runHandlerMode(args.at(1));
+}
@@ -0,0 +1,293 @@
+#include "AsyncOpener.hpp"
+#include "OpenerBackend.hpp"
+
+#include <QMutex>
+#include <QSemaphore>
+#include <QStringList>
+#include <QTest>
+#include <QThread>
+
+#include <algorithm>
+#include <memory>
+
+using namespace uncopener;
+
+namespace
+{
+
+constexpr int MAX_BLOCK_MS = 10000;
+constexpr int LONG_TIMEOUT_MS = 60000;
+
+/// Stands in for the system call: records the targets and blocks until released
+class BlockingOpen
+{
+public:
+    AsyncOpener::OpenFunction function()
+    {
+        return [this](const QString& targetUrl)
+        {
+            {
+                QMutexLocker locker(&m_mutex);
+                m_targets.append(targetUrl);
+                m_peak = std::max(m_peak, ++m_running);
+            }
+
+            // Bounded, so a failing test cannot hang in the destructor of the opener
+            static_cast<void>(m_gate.tryAcquire(1, MAX_BLOCK_MS));
+
+            QMutexLocker locker(&m_mutex);
+            --m_running;
+            return OpenResult::ok();
+        };
+    }
+
+    /// Let the given number of blocked calls return
+    void release(int count = 1) { m_gate.release(count); }
+
+    [[nodiscard]] QStringList targets() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_targets;
+    }
+
+    [[nodiscard]] int peak() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_peak;
+    }
+
+private:
+    QSemaphore m_gate;
+    mutable QMutex m_mutex;
+    QStringList m_targets;
+    int m_running = 0;
+    int m_peak = 0; // Most calls running at the same time
+};
+
+/// Records the thread targets are opened on
+class ThreadRecordingBackend : public OpenerBackend
+{
+public:
+    explicit ThreadRecordingBackend(bool threadSafe) : m_threadSafe(threadSafe) {}
+
+    [[nodiscard]] QString name() const override { return "thread recording"; }
+
+    [[nodiscard]] bool isThreadSafe() const override { return m_threadSafe; }
+
+    [[nodiscard]] QThread* openedOn() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_openedOn;
+    }
+
+protected:
+    OpenResult launch(const QString& /*targetUrl*/, OpenOutcome& /*outcome*/) override
+    {
+        QMutexLocker locker(&m_mutex);
+        m_openedOn = QThread::currentThread();
+        return OpenResult::ok();
+    }
+
+private:
+    bool m_threadSafe;
+    mutable QMutex m_mutex;
+    QThread* m_openedOn = nullptr;
+};
+
+} // namespace
+
+class AsyncOpenerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testOpenDeliversResult()
+    {
+        BlockingOpen stub;
+        AsyncOpener opener(stub.function(), 2, LONG_TIMEOUT_MS);
+
+        ValidationResult validation{UncPath{"server", "share", false},
+                                    PolicyCheckResult::allow(), "smb://server/share"};
+        QFuture<OpenResult> future = opener.open(validation);
+        QVERIFY(!future.isFinished());
+
+        stub.release();
+        QTRY_VERIFY(future.isFinished());
+        QVERIFY(future.result().success);
+        QCOMPARE(stub.targets(), QStringList{"smb://server/share"});
+        QTRY_COMPARE(opener.runningCount(), 0);
+    }
+
+    void testRevealWithoutBackendOpensEach()
+    {
+        BlockingOpen stub;
+        AsyncOpener opener(stub.function(), 2, LONG_TIMEOUT_MS);
+
+        QStringList targets = {"smb://server/share/a.pdf", "smb://server/share/b.pdf"};
+        QFuture<OpenResult> future = opener.revealTargets("server", targets);
+
+        // One request, so the targets open in turn on one worker
+        stub.release(2);
+        QTRY_VERIFY(future.isFinished());
+        QVERIFY(future.result().success);
+        QCOMPARE(stub.targets(), targets);
+        QCOMPARE(stub.peak(), 1);
+        QTRY_COMPARE(opener.runningCount(), 0);
+    }
+
+    void testThreadUnsafeBackendOpensOnOwnerThread()
+    {
+        AsyncOpener opener(LONG_TIMEOUT_MS);
+        auto unsafe = std::make_shared<ThreadRecordingBackend>(false);
+        opener.setBackend(unsafe);
+
+        QFuture<OpenResult> future = opener.openTarget("server", "smb://server/share");
+        QTRY_VERIFY(future.isFinished());
+        QVERIFY(future.result().success);
+        QCOMPARE(unsafe->openedOn(), QThread::currentThread());
+
+        // Thread-safe backends keep running on the workers
+        auto safe = std::make_shared<ThreadRecordingBackend>(true);
+        opener.setBackend(safe);
+        future = opener.openTarget("server", "smb://server/share");
+        QTRY_VERIFY(future.isFinished());
+        QVERIFY(safe->openedOn() != nullptr);
+        QVERIFY(safe->openedOn() != QThread::currentThread());
+        QTRY_COMPARE(opener.runningCount(), 0);
+    }
+
+    void testDeniedResolvesAtOnce()
+    {
+        BlockingOpen stub;
+        AsyncOpener opener(stub.function(), 2, LONG_TIMEOUT_MS);
+
+        ValidationResult validation{UncPath{"server", "share", false},
+                                    PolicyCheckResult::deny("Not allowed", "Add it"), {}};
+        QFuture<OpenResult> future = opener.open(validation);
+
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.result().errorReason, "Not allowed");
+        QVERIFY(stub.targets().isEmpty());
+    }
+
+    void testSameServerRunsInOrder()
+    {
+        BlockingOpen stub;
+        AsyncOpener opener(stub.function(), 4, LONG_TIMEOUT_MS);
+
+        QFuture<OpenResult> first = opener.openTarget("server", "smb://server/a");
+        QFuture<OpenResult> second = opener.openTarget("SERVER", "smb://server/b");
+        QTRY_COMPARE(stub.targets().size(), 1);
+        QCOMPARE(opener.runningCount(), 1);
+        QCOMPARE(opener.pendingCount(), 1);
+
+        stub.release(2);
+        QTRY_VERIFY(first.isFinished() && second.isFinished());
+        QCOMPARE(stub.targets(), (QStringList{"smb://server/a", "smb://server/b"}));
+        QCOMPARE(stub.peak(), 1);
+    }
+
+    void testServersRunInParallel()
+    {
+        BlockingOpen stub;
+        AsyncOpener opener(stub.function(), 4, LONG_TIMEOUT_MS);
+
+        QFuture<OpenResult> first = opener.openTarget("alpha", "smb://alpha/share");
+        QFuture<OpenResult> second = opener.openTarget("beta", "smb://beta/share");
+        QTRY_COMPARE(stub.peak(), 2);
+
+        stub.release(2);
+        QTRY_VERIFY(first.isFinished() && second.isFinished());
+    }
+
+    void testWorkersBounded()
+    {
+        BlockingOpen stub;
+        AsyncOpener opener(stub.function(), 2, LONG_TIMEOUT_MS);
+
+        QList<QFuture<OpenResult>> futures;
+        for (const QString& server : QStringList{"alpha", "beta", "gamma"})
+        {
+            futures.append(opener.openTarget(server, "smb://" + server + "/share"));
+        }
+        QTRY_COMPARE(stub.targets().size(), 2);
+        QCOMPARE(opener.pendingCount(), 1);
+
+        stub.release(3);
+        QTRY_VERIFY(futures.at(2).isFinished());
+        QCOMPARE(stub.peak(), 2);
+    }
+
+    void testHungCallTimesOut()
+    {
+        BlockingOpen stub;
+        AsyncOpener opener(stub.function(), 2, 50);
+
+        QFuture<OpenResult> hung = opener.openTarget("server", "smb://server/share");
+        QTRY_VERIFY(hung.isFinished());
+        QVERIFY(!hung.result().success);
+        QVERIFY(hung.result().errorReason.contains("timed out"));
+
+        // The worker is still stuck in the call and keeps the server busy
+        QCOMPARE(opener.runningCount(), 1);
+        stub.release();
+        QTRY_COMPARE(opener.runningCount(), 0);
+    }
+
+    void testStaleRequestNeverRuns()
+    {
+        BlockingOpen stub;
+        AsyncOpener opener(stub.function(), 2, 50);
+
+        QFuture<OpenResult> hung = opener.openTarget("server", "smb://server/a");
+        QFuture<OpenResult> queued = opener.openTarget("server", "smb://server/b");
+        QTRY_VERIFY(queued.isFinished());
+        QVERIFY(queued.result().errorReason.contains("timed out"));
+        QCOMPARE(opener.pendingCount(), 0);
+
+        stub.release();
+        QTRY_COMPARE(opener.runningCount(), 0);
+        QCOMPARE(stub.targets(), QStringList{"smb://server/a"});
+    }
+
+    void testCancelQueuedRequest()
+    {
+        BlockingOpen stub;
+        AsyncOpener opener(stub.function(), 2, LONG_TIMEOUT_MS);
+
+        QFuture<OpenResult> first = opener.openTarget("server", "smb://server/a");
+        QFuture<OpenResult> second = opener.openTarget("server", "smb://server/b");
+        second.cancel();
+
+        stub.release();
+        QTRY_VERIFY(first.isFinished() && second.isFinished());
+        QVERIFY(second.isCanceled());
+        QTRY_COMPARE(opener.runningCount(), 0);
+        QCOMPARE(stub.targets(), QStringList{"smb://server/a"});
+    }
+
+    void testCancelPending()
+    {
+        BlockingOpen stub;
+        AsyncOpener opener(stub.function(), 1, LONG_TIMEOUT_MS);
+
+        QFuture<OpenResult> running = opener.openTarget("alpha", "smb://alpha/share");
+        QFuture<OpenResult> queued = opener.openTarget("beta", "smb://beta/share");
+        opener.cancelPending();
+
+        QVERIFY(queued.isCanceled());
+        QCOMPARE(opener.pendingCount(), 0);
+
+        stub.release();
+        QTRY_VERIFY(running.isFinished());
+        QVERIFY(running.result().success);
+    }
+};
+
+int runAsyncOpenerTests(int argc, char* argv[])
+{
+    AsyncOpenerTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "AsyncOpenerTests.moc"
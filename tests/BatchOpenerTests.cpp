@@ -0,0 +1,263 @@
+#include "BatchOpener.hpp"
+#include "OpenerBackend.hpp"
+
+#include "ShareHistory.hpp"
+
+#include <QBuffer>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <memory>
+#include <utility>
+
+using namespace uncopener;
+
+namespace
+{
+
+/// Records every call instead of opening anything
+/// Targets containing the failing text (if given) fail to open.
+class RecordingBackend : public OpenerBackend
+{
+public:
+    explicit RecordingBackend(QString failing = {}) : m_failing(std::move(failing)) {}
+
+    [[nodiscard]] QString name() const override { return "recording"; }
+
+    /// Get one entry per call, with the targets it was given
+    [[nodiscard]] const QList<QStringList>& calls() const { return m_calls; }
+
+protected:
+    OpenResult launch(const QString& targetUrl, OpenOutcome& /*outcome*/) override
+    {
+        m_calls.append(QStringList{targetUrl});
+        if (!m_failing.isEmpty() && targetUrl.contains(m_failing))
+        {
+            return OpenResult::error("Failed", "Try again.");
+        }
+        return OpenResult::ok();
+    }
+
+    OpenResult launchSelection(const QStringList& targetUrls, OpenOutcome& /*outcome*/) override
+    {
+        m_calls.append(targetUrls);
+        return OpenResult::ok();
+    }
+
+private:
+    QString m_failing;
+    QList<QStringList> m_calls;
+};
+
+} // namespace
+
+class BatchOpenerTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static Config testConfig()
+    {
+        Config config;
+        config.setSchemeName("uncopener");
+        config.setUncAllowList({R"(\\server\share)"});
+        config.setFiletypeMode(FiletypeMode::Blacklist);
+        config.setFiletypeBlacklist({".exe"});
+        return config;
+    }
+
+private slots:
+    void testPrepareAllValid()
+    {
+        BatchOpener batch(testConfig());
+        BatchResult result;
+        QList<BatchTarget> targets = batch.prepare(
+            {"uncopener://server/share/a.txt", "uncopener://server/share/folder/"}, result);
+
+        QCOMPARE(targets.size(), 2);
+        QVERIFY(result.success());
+        QCOMPARE(result.duplicateCount, 0);
+        QCOMPARE(targets.at(0).url, "uncopener://server/share/a.txt");
+        QCOMPARE(targets.at(0).displayPath, R"(\\server\share\a.txt)");
+        QVERIFY(!targets.at(0).targetUrl.isEmpty());
+        QCOMPARE(targets.at(0).server, "server");
+    }
+
+    void testPrepareDropsDuplicateTargets()
+    {
+        BatchOpener batch(testConfig());
+        BatchResult result;
+        QList<BatchTarget> targets = batch.prepare({"uncopener://server/share/a.txt",
+                                                    "uncopener://server/share//a.txt",
+                                                    "uncopener://SERVER/Share/A.txt",
+                                                    "uncopener://server/share/./a.txt?x=1",
+                                                    "uncopener://server/share/b.txt"},
+                                                   result);
+
+        QCOMPARE(targets.size(), 2);
+        QCOMPARE(result.duplicateCount, 3);
+        QCOMPARE(targets.at(1).url, "uncopener://server/share/b.txt");
+    }
+
+    void testPrepareCollectsAllFailures()
+    {
+        BatchOpener batch(testConfig());
+        BatchResult result;
+        QList<BatchTarget> targets = batch.prepare({"uncopener://server/share/ok.txt",
+                                                    "uncopener://other/share/file.txt",
+                                                    "uncopener://server/share/setup.exe",
+                                                    "not-a-url"},
+                                                   result);
+
+        QCOMPARE(targets.size(), 1);
+        QVERIFY(!result.success());
+        QCOMPARE(result.failures.size(), 3);
+
+        QCOMPARE(result.failures.at(0).url, "uncopener://other/share/file.txt");
+        QCOMPARE(result.failures.at(0).displayPath, R"(\\other\share\file.txt)");
+        QVERIFY(!result.failures.at(0).reason.isEmpty());
+        QVERIFY(!result.failures.at(0).remediation.isEmpty());
+
+        QCOMPARE(result.failures.at(1).displayPath, R"(\\server\share\setup.exe)");
+
+        // Unparseable input is shown as given
+        QCOMPARE(result.failures.at(2).displayPath, "not-a-url");
+    }
+
+    void testPrepareReportsTooManyUrls()
+    {
+        QStringList urls;
+        for (int i = 0; i < BatchOpener::MAX_URLS + 1; ++i)
+        {
+            urls.append("uncopener://server/share/" + QString::number(i) + ".txt");
+        }
+
+        BatchOpener batch(testConfig());
+        BatchResult result;
+        QList<BatchTarget> targets = batch.prepare(urls, result);
+
+        QCOMPARE(targets.size(), BatchOpener::MAX_URLS);
+        QVERIFY(!result.success());
+        QCOMPARE(result.failures.size(), 1);
+        QCOMPARE(result.failures.at(0).url, urls.last());
+    }
+
+    void testOpenAllRecordsOnlyOpenedShares()
+    {
+        Config config = testConfig();
+        config.setUncAllowList({R"(\server\share)", R"(\serverroken)"});
+        PathOpener opener(config);
+        opener.setBackend(std::make_shared<RecordingBackend>("broken"));
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto history = std::make_shared<ShareHistory>(tempDir.path() + "/history.json");
+        opener.setShareHistory(history);
+
+        BatchResult result = BatchOpener(opener).openAll(
+            {"uncopener://server/share/a.txt", "uncopener://server/broken/b.txt"});
+
+        QCOMPARE(result.openedCount, 1);
+        QCOMPARE(result.failures.size(), 1);
+        QCOMPARE(history->entries().size(), 1);
+        QCOMPARE(history->entries().at(0).share, "share");
+    }
+
+    void testOpenAllWithOnlyFailuresOpensNothing()
+    {
+        BatchOpener batch(testConfig());
+        BatchResult result =
+            batch.openAll({"uncopener://other/share/a.txt", "uncopener://server/../x"});
+
+        QCOMPARE(result.openedCount, 0);
+        QCOMPARE(result.failures.size(), 2);
+    }
+
+    void testFolderOf()
+    {
+        QCOMPARE(BatchOpener::folderOf("smb://server/share/a/b.pdf"), "smb://server/share/a/");
+        QCOMPARE(BatchOpener::folderOf("file:///mnt/data/b.pdf"), "file:///mnt/data/");
+        QCOMPARE(BatchOpener::folderOf(R"(\\server\share\a\b.pdf)"), R"(\\server\share\a\)");
+    }
+
+    void testGroupTargetsByFolder()
+    {
+        QList<BatchTarget> targets = {
+            {"1", {}, "smb://server/share/a/1.pdf", "server", true, {}},
+            {"2", {}, "smb://server/share/b/2.pdf", "server", true, {}},
+            {"3", {}, "smb://server/share/a/3.txt", "server", false, {}},
+            {"4", {}, "smb://SERVER/share/A/4.pdf", "server", true, {}},
+            {"5", {}, "smb://server/share/a/5.txt", "server", false, {}},
+        };
+
+        // Revealed files of a folder join the group of the first one, other targets stay alone
+        QList<QList<qsizetype>> groups = BatchOpener::groupTargets(targets);
+        QCOMPARE(groups.size(), 4);
+        QCOMPARE(groups.at(0), QList<qsizetype>({0, 3}));
+        QCOMPARE(groups.at(1), QList<qsizetype>({1}));
+        QCOMPARE(groups.at(2), QList<qsizetype>({2}));
+        QCOMPARE(groups.at(3), QList<qsizetype>({4}));
+    }
+
+    void testOpenAllRevealsEachFolderOnce()
+    {
+        Config config = testConfig();
+        config.setRevealFiletypes({".pdf"});
+        PathOpener opener(config);
+        auto backend = std::make_shared<RecordingBackend>();
+        auto revealer = std::make_shared<RecordingBackend>();
+        opener.setBackend(backend);
+        opener.setRevealBackend(revealer);
+
+        BatchResult result = BatchOpener(opener).openAll({"uncopener://server/share/a/1.pdf",
+                                                          "uncopener://server/share/a/2.txt",
+                                                          "uncopener://server/share/a/3.pdf",
+                                                          "uncopener://server/share/b/4.pdf"});
+
+        QVERIFY(result.success());
+        QCOMPARE(result.openedCount, 4);
+        QCOMPARE(backend->calls().size(), 1);
+        QCOMPARE(revealer->calls().size(), 2);
+        QCOMPARE(revealer->calls().at(0).size(), 2);
+        QCOMPARE(revealer->calls().at(0).at(1),
+                 opener.evaluate("uncopener://server/share/a/3.pdf").targetUrl);
+        QCOMPARE(revealer->stats().attempts, 2);
+    }
+
+    void testReadUrls()
+    {
+        QByteArray input = "uncopener://server/share/a.txt\n"
+                           "\n"
+                           "  uncopener://server/share/b%20c.txt  \r\n"
+                           "uncopener://server/share/\xC3\xA4.txt";
+        QBuffer buffer(&input);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+        QStringList urls = BatchOpener::readUrls(buffer);
+        QCOMPARE(urls.size(), 3);
+        QCOMPARE(urls.at(0), "uncopener://server/share/a.txt");
+        QCOMPARE(urls.at(1), "uncopener://server/share/b%20c.txt");
+        QCOMPARE(urls.at(2), QString::fromUtf8("uncopener://server/share/\xC3\xA4.txt"));
+    }
+
+    void testReadUrlsIsBounded()
+    {
+        QByteArray input;
+        for (int i = 0; i < BatchOpener::MAX_URLS + 10; ++i)
+        {
+            input += "uncopener://server/share/" + QByteArray::number(i) + "\n";
+        }
+        QBuffer buffer(&input);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+        // One URL beyond the limit is kept, so the batch reports the rest as not opened
+        QCOMPARE(BatchOpener::readUrls(buffer).size(), BatchOpener::MAX_URLS + 1);
+    }
+};
+
+int runBatchOpenerTests(int argc, char* argv[])
+{
+    BatchOpenerTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "BatchOpenerTests.moc"
@@ -0,0 +1,133 @@
+#include "CaseFoldedTrie.hpp"
+
+#include <QString>
+#include <QTest>
+
+using namespace uncopener;
+
+class CaseFoldedTrieTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEmptyTrie()
+    {
+        CaseFoldedTrie trie;
+        QVERIFY(trie.isEmpty());
+        QCOMPARE(trie.longestMatch(u"anything"), CaseFoldedTrie::NO_MATCH);
+        QCOMPARE(trie.longestMatch(u""), CaseFoldedTrie::NO_MATCH);
+    }
+
+    void testForwardLongestPrefix()
+    {
+        CaseFoldedTrie trie;
+        trie.insert(u"ab", 0);
+        trie.insert(u"abcd", 1);
+        trie.insert(u"x", 2);
+
+        QCOMPARE(trie.longestMatch(u"abcdef"), qsizetype(1));
+        QCOMPARE(trie.longestMatch(u"abcx"), qsizetype(0));
+        QCOMPARE(trie.longestMatch(u"ab"), qsizetype(0));
+        QCOMPARE(trie.longestMatch(u"a"), CaseFoldedTrie::NO_MATCH);
+        QCOMPARE(trie.longestMatch(u"xyz"), qsizetype(2));
+        QCOMPARE(trie.longestMatch(u"yab"), CaseFoldedTrie::NO_MATCH);
+    }
+
+    void testBackwardLongestSuffix()
+    {
+        CaseFoldedTrie trie(CaseFoldedTrie::Direction::Backward);
+        trie.insert(u".exe", 0);
+        trie.insert(u".pdf.exe", 1);
+
+        QCOMPARE(trie.longestMatch(u"report.pdf.exe"), qsizetype(1));
+        QCOMPARE(trie.longestMatch(u"setup.exe"), qsizetype(0));
+        QCOMPARE(trie.longestMatch(u"setup.exe.txt"), CaseFoldedTrie::NO_MATCH);
+        QCOMPARE(trie.longestMatch(u"exe"), CaseFoldedTrie::NO_MATCH);
+    }
+
+    void testCaseInsensitive()
+    {
+        CaseFoldedTrie trie;
+        trie.insert(u"Stra\u00DFe\\\u00C4RGER", 0);
+
+        QCOMPARE(trie.longestMatch(u"STRA\u00DFE\\\u00E4rger\\x"), qsizetype(0));
+        QCOMPARE(trie.longestMatch(u"strasse\\\u00E4rger"), CaseFoldedTrie::NO_MATCH);
+    }
+
+    void testSurrogatePairs()
+    {
+        // U+10400 DESERET CAPITAL LETTER LONG I folds to U+10428
+        CaseFoldedTrie forward;
+        forward.insert(u"a\U00010400", 0);
+        QCOMPARE(forward.longestMatch(u"A\U00010428b"), qsizetype(0));
+
+        CaseFoldedTrie backward(CaseFoldedTrie::Direction::Backward);
+        backward.insert(u"\U00010400.txt", 0);
+        QCOMPARE(backward.longestMatch(u"x\U00010428.TXT"), qsizetype(0));
+        QCOMPARE(backward.longestMatch(u"x.txt"), CaseFoldedTrie::NO_MATCH);
+    }
+
+    void testDuplicateKeepsFirstValue()
+    {
+        CaseFoldedTrie trie;
+        trie.insert(u"key", 0);
+        trie.insert(u"KEY", 1);
+
+        QCOMPARE(trie.keyCount(), qsizetype(1));
+        QCOMPARE(trie.longestMatch(u"keys"), qsizetype(0));
+    }
+
+    void testEmptyKeyIsIgnored()
+    {
+        CaseFoldedTrie trie;
+        trie.insert(u"", 0);
+
+        QVERIFY(trie.isEmpty());
+        QCOMPARE(trie.longestMatch(u"text"), CaseFoldedTrie::NO_MATCH);
+    }
+
+    void testClear()
+    {
+        CaseFoldedTrie trie;
+        trie.insert(u"abc", 0);
+        trie.clear();
+
+        QVERIFY(trie.isEmpty());
+        QCOMPARE(trie.longestMatch(u"abc"), CaseFoldedTrie::NO_MATCH);
+
+        trie.insert(u"xyz", 5);
+        QCOMPARE(trie.longestMatch(u"xyz"), qsizetype(5));
+    }
+
+    void testMatchesQtCaseInsensitiveStartsWith()
+    {
+        const QStringList keys = {R"(\\Server\Share)", R"(\\server\SHARE\Sub)", R"(\\FS01)"};
+        const QStringList paths = {R"(\\SERVER\share\x)", R"(\\server\shar)",
+                                   R"(\\fs01\data)",      R"(\\fs0)",
+                                   R"(\\server\share\sub\y)"};
+
+        CaseFoldedTrie trie;
+        for (qsizetype i = 0; i < keys.size(); ++i)
+        {
+            trie.insert(keys.at(i), i);
+        }
+
+        for (const QString& path : paths)
+        {
+            bool expected = false;
+            for (const QString& key : keys)
+            {
+                expected = expected || path.startsWith(key, Qt::CaseInsensitive);
+            }
+            QCOMPARE(trie.longestMatch(path) != CaseFoldedTrie::NO_MATCH, expected);
+        }
+    }
+};
+
+int runCaseFoldedTrieTests(int argc, char* argv[])
+{
+    CaseFoldedTrieTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "CaseFoldedTrieTests.moc"
@@ -0,0 +1,225 @@
+#include "ConfigCache.hpp"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace uncopener;
+
+class ConfigCacheTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static Config sampleConfig()
+    {
+        Config config;
+        config.setSchemeName("cachetest");
+        config.setUncAllowList({R"(\\server\share)", "server2/share", R"(\\SERVER\Share)"});
+        config.setSmbUsername("user");
+        config.setFiletypeMode(FiletypeMode::Blacklist);
+        config.setFiletypeWhitelist({"txt"});
+        config.setFiletypeBlacklist({".EXE", ".bat"});
+        return config;
+    }
+
+private slots:
+    void testCachePathFor()
+    {
+        QCOMPARE(ConfigCache::cachePathFor("/home/user/.config/uncopener/config.json"),
+                 "/home/user/.config/uncopener/config.cache");
+    }
+
+    void testLoadCreatesCache()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QString configPath = tempDir.path() + "/config.json";
+        QVERIFY(sampleConfig().saveTo(configPath));
+
+        Config config;
+        QVERIFY(ConfigCache::loadFrom(configPath, config));
+        QVERIFY(QFile::exists(ConfigCache::cachePathFor(configPath)));
+        QCOMPARE(config.schemeName(), "cachetest");
+    }
+
+    void testReadReturnsCompiledConfig()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QString configPath = tempDir.path() + "/config.json";
+        QVERIFY(sampleConfig().saveTo(configPath));
+
+        Config first;
+        QVERIFY(ConfigCache::loadFrom(configPath, first));
+
+        Config cached;
+        QVERIFY(ConfigCache::read(configPath, cached));
+
+        QCOMPARE(cached.schemeName(), "cachetest");
+        QCOMPARE(cached.smbUsername(), "user");
+        QCOMPARE(cached.filetypeMode(), FiletypeMode::Blacklist);
+
+        // Lists are stored normalized and deduplicated
+        QCOMPARE(cached.uncAllowList(), QStringList({R"(\\server\share)"}));
+        QCOMPARE(cached.filetypeWhitelist(), QStringList{".txt"});
+        QCOMPARE(cached.filetypeBlacklist(), QStringList({".exe", ".bat"}));
+    }
+
+    void testCachedConfigGivesSamePolicy()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QString configPath = tempDir.path() + "/config.json";
+        QVERIFY(sampleConfig().saveTo(configPath));
+
+        Config parsed;
+        QVERIFY(parsed.loadFrom(configPath));
+        SecurityPolicy parsedPolicy;
+        parsed.applyTo(parsedPolicy);
+
+        Config first;
+        QVERIFY(ConfigCache::loadFrom(configPath, first));
+        Config cached;
+        QVERIFY(ConfigCache::read(configPath, cached));
+        SecurityPolicy cachedPolicy;
+        cached.applyTo(cachedPolicy);
+
+        QCOMPARE(cachedPolicy.uncAllowList().entries(), parsedPolicy.uncAllowList().entries());
+        QCOMPARE(cachedPolicy.filetypePolicy().blacklist(),
+                 parsedPolicy.filetypePolicy().blacklist());
+        QCOMPARE(cachedPolicy.filetypePolicy().whitelist(),
+                 parsedPolicy.filetypePolicy().whitelist());
+    }
+
+    void testStaleCacheAfterSizeChange()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QString configPath = tempDir.path() + "/config.json";
+        QVERIFY(sampleConfig().saveTo(configPath));
+
+        Config config;
+        QVERIFY(ConfigCache::loadFrom(configPath, config));
+
+        Config changed = sampleConfig();
+        changed.setSchemeName("changed-scheme");
+        QVERIFY(changed.saveTo(configPath));
+
+        Config cached;
+        QVERIFY(!ConfigCache::read(configPath, cached));
+
+        // Loading rebuilds the cache from the new file
+        QVERIFY(ConfigCache::loadFrom(configPath, config));
+        QCOMPARE(config.schemeName(), "changed-scheme");
+        QVERIFY(ConfigCache::read(configPath, cached));
+        QCOMPARE(cached.schemeName(), "changed-scheme");
+    }
+
+    void testStaleCacheAfterMtimeChange()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QString configPath = tempDir.path() + "/config.json";
+        QVERIFY(sampleConfig().saveTo(configPath));
+
+        Config config;
+        QVERIFY(ConfigCache::loadFrom(configPath, config));
+
+        // Same size, different modification time
+        QFile file(configPath);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QDateTime mtime = QFileInfo(configPath).lastModified().addSecs(10);
+        QVERIFY(file.setFileTime(mtime, QFileDevice::FileModificationTime));
+        file.close();
+
+        Config cached;
+        QVERIFY(!ConfigCache::read(configPath, cached));
+    }
+
+    void testStaleCacheAfterContentChange()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QString configPath = tempDir.path() + "/config.json";
+        QVERIFY(sampleConfig().saveTo(configPath));
+
+        Config config;
+        QVERIFY(ConfigCache::loadFrom(configPath, config));
+
+        // Same size and modification time, different bytes
+        QDateTime mtime = QFileInfo(configPath).lastModified();
+        QFile file(configPath);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QByteArray data = file.readAll();
+        qsizetype index = data.indexOf("cachetest");
+        QVERIFY(index >= 0);
+        data[index] = 'k';
+        QVERIFY(file.seek(0));
+        QCOMPARE(file.write(data), data.size());
+        QVERIFY(file.setFileTime(mtime, QFileDevice::FileModificationTime));
+        file.close();
+
+        Config cached;
+        QVERIFY(!ConfigCache::read(configPath, cached));
+
+        QVERIFY(ConfigCache::loadFrom(configPath, config));
+        QCOMPARE(config.schemeName(), "kachetest");
+    }
+
+    void testSchemaHashIsStable()
+    {
+        QVERIFY(!ConfigCache::schemaHash().isEmpty());
+        QCOMPARE(ConfigCache::schemaHash(), ConfigCache::schemaHash());
+    }
+
+    void testCorruptCacheIsRejected()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QString configPath = tempDir.path() + "/config.json";
+        QVERIFY(sampleConfig().saveTo(configPath));
+
+        Config config;
+        QVERIFY(ConfigCache::loadFrom(configPath, config));
+
+        // Flip the last payload byte
+        QFile cacheFile(ConfigCache::cachePathFor(configPath));
+        QVERIFY(cacheFile.open(QIODevice::ReadWrite));
+        QByteArray data = cacheFile.readAll();
+        data[data.size() - 1] = static_cast<char>(data.at(data.size() - 1) ^ 0x01);
+        QVERIFY(cacheFile.seek(0));
+        QCOMPARE(cacheFile.write(data), data.size());
+        cacheFile.close();
+
+        Config cached;
+        QVERIFY(!ConfigCache::read(configPath, cached));
+
+        // The config file is still used
+        QVERIFY(ConfigCache::loadFrom(configPath, config));
+        QCOMPARE(config.schemeName(), "cachetest");
+    }
+
+    void testLoadNonExistentConfig()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QString configPath = tempDir.path() + "/config.json";
+
+        Config config;
+        config.setSchemeName("willbereset");
+        QVERIFY(!ConfigCache::loadFrom(configPath, config));
+        QCOMPARE(config.schemeName(), QString(Config::DEFAULT_SCHEME_NAME));
+        QVERIFY(!QFile::exists(ConfigCache::cachePathFor(configPath)));
+    }
+};
+
+int runConfigCacheTests(int argc, char* argv[])
+{
+    ConfigCacheTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "ConfigCacheTests.moc"
@@ -23,6 +23,23 @@ private slots:
         QCOMPARE(config.filetypeMode(), Config::DEFAULT_FILETYPE_MODE);
         QVERIFY(config.filetypeWhitelist().isEmpty());
         QVERIFY(config.filetypeBlacklist().isEmpty());
+        QCOMPARE(config.residentMode(), Config::DEFAULT_RESIDENT_MODE);
+        QCOMPARE(config.dbusActivation(), Config::DEFAULT_DBUS_ACTIVATION);
+        QCOMPARE(config.coalesceWindowMs(), Config::DEFAULT_COALESCE_WINDOW_MS);
+        QCOMPARE(config.rateLimitBurst(), Config::DEFAULT_RATE_LIMIT_BURST);
+        QCOMPARE(config.rateLimitPerMinute(), Config::DEFAULT_RATE_LIMIT_PER_MINUTE);
+        QCOMPARE(config.openTimeoutMs(), Config::DEFAULT_OPEN_TIMEOUT_MS);
+        QCOMPARE(config.opener(), Config::DEFAULT_OPENER);
+        QVERIFY(config.openerCommand().isEmpty());
+        QVERIFY(config.revealFiletypes().isEmpty());
+        QCOMPARE(config.preferLocalMounts(), Config::DEFAULT_PREFER_LOCAL_MOUNTS);
+        QCOMPARE(config.probeServers(), Config::DEFAULT_PROBE_SERVERS);
+        QCOMPARE(config.probeTimeoutMs(), Config::DEFAULT_PROBE_TIMEOUT_MS);
+        QCOMPARE(config.prewarm(), Config::DEFAULT_PREWARM);
+        QCOMPARE(config.prewarmShares(), Config::DEFAULT_PREWARM_SHARES);
+        QVERIFY(config.prewarmCommand().isEmpty());
+        QVERIFY(config.pathTranslations().isEmpty());
+        QVERIFY(config.serverAliases().isEmpty());
     }
 
     void testSettersAndGetters()
@@ -176,6 +193,24 @@ private slots:
         original.setFiletypeMode(FiletypeMode::Blacklist);
         original.setFiletypeWhitelist({".doc", ".docx"});
         original.setFiletypeBlacklist({".exe", ".bat", ".cmd"});
+        original.setResidentMode(true);
+        original.setDBusActivation(true);
+        original.setCoalesceWindowMs(250);
+        original.setRateLimitBurst(0);
+        original.setRateLimitPerMinute(120);
+        original.setOpenTimeoutMs(0);
+        original.setOpener(OpenerKind::Command);
+        original.setOpenerCommand("nautilus %u");
+        original.setRevealFiletypes({".pdf", ".docx"});
+        original.setPreferLocalMounts(false);
+        original.setProbeServers(true);
+        original.setProbeTimeoutMs(750);
+        original.setPrewarm(true);
+        original.setPrewarmShares(3);
+        original.setPrewarmCommand("gio mount %u");
+        original.setPathTranslations({{R"(\\fs01\archive)", "/srv/archive"},
+                                      {R"(\\fs01\projects)", "/mnt/projects"}});
+        original.setServerAliases({{"fs01", "fs01.corp.example.com"}, {"oldfs", "fs01"}});
 
         QJsonObject json = original.toJson();
 
@@ -188,6 +223,69 @@ private slots:
         QCOMPARE(loaded.filetypeMode(), original.filetypeMode());
         QCOMPARE(loaded.filetypeWhitelist(), original.filetypeWhitelist());
         QCOMPARE(loaded.filetypeBlacklist(), original.filetypeBlacklist());
+        QCOMPARE(loaded.residentMode(), original.residentMode());
+        QCOMPARE(loaded.dbusActivation(), original.dbusActivation());
+        QCOMPARE(loaded.coalesceWindowMs(), original.coalesceWindowMs());
+        QCOMPARE(loaded.rateLimitBurst(), original.rateLimitBurst());
+        QCOMPARE(loaded.rateLimitPerMinute(), original.rateLimitPerMinute());
+        QCOMPARE(loaded.openTimeoutMs(), original.openTimeoutMs());
+        QCOMPARE(loaded.opener(), original.opener());
+        QCOMPARE(loaded.openerCommand(), original.openerCommand());
+        QCOMPARE(loaded.revealFiletypes(), original.revealFiletypes());
+        QCOMPARE(loaded.preferLocalMounts(), original.preferLocalMounts());
+        QCOMPARE(loaded.probeServers(), original.probeServers());
+        QCOMPARE(loaded.probeTimeoutMs(), original.probeTimeoutMs());
+        QCOMPARE(loaded.prewarm(), original.prewarm());
+        QCOMPARE(loaded.prewarmShares(), original.prewarmShares());
+        QCOMPARE(loaded.prewarmCommand(), original.prewarmCommand());
+        QVERIFY(loaded.pathTranslations() == original.pathTranslations());
+        QCOMPARE(loaded.serverAliases(), original.serverAliases());
+    }
+
+    void testInvalidThrottleValuesUseDefaults()
+    {
+        QJsonObject json;
+        json["coalesceWindowMs"] = -1;
+        json["rateLimitBurst"] = "many";
+
+        Config config;
+        QVERIFY(config.fromJson(json));
+        QCOMPARE(config.coalesceWindowMs(), Config::DEFAULT_COALESCE_WINDOW_MS);
+        QCOMPARE(config.rateLimitBurst(), Config::DEFAULT_RATE_LIMIT_BURST);
+        QCOMPARE(config.rateLimitPerMinute(), Config::DEFAULT_RATE_LIMIT_PER_MINUTE);
+    }
+
+    void testUnknownOpenerUsesDefault()
+    {
+        QJsonObject json;
+        json["opener"] = "konqueror";
+
+        Config config;
+        QVERIFY(config.fromJson(json));
+        QCOMPARE(config.opener(), Config::DEFAULT_OPENER);
+
+        json["opener"] = "XDG-Open";
+        QVERIFY(config.fromJson(json));
+        QCOMPARE(config.opener(), OpenerKind::XdgOpen);
+    }
+
+    void testPathTranslationsFromJson()
+    {
+        QJsonObject translations;
+        translations[R"(\\fs01\projects)"] = "/mnt/projects";
+        translations[R"(\\fs02\data)"] = 42;
+        QJsonObject json;
+        json["pathTranslations"] = translations;
+
+        Config config;
+        QVERIFY(config.fromJson(json));
+        QCOMPARE(config.pathTranslations().size(), 1);
+        QCOMPARE(config.pathTranslations().at(0).uncPrefix, R"(\\fs01\projects)");
+        QCOMPARE(config.pathTranslations().at(0).localPath, "/mnt/projects");
+
+        json["pathTranslations"] = QJsonArray{"/mnt/projects"};
+        QVERIFY(config.fromJson(json));
+        QVERIFY(config.pathTranslations().isEmpty());
     }
 
     void testFilePersistence()
@@ -0,0 +1,180 @@
+#include "ConfigWatcher.hpp"
+
+#include <QSaveFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace uncopener;
+
+class ConfigWatcherTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    /// Replace a file the way QSaveFile-based tools do: write a temporary file and rename it
+    static bool writeAtomically(const QString& path, const QByteArray& content)
+    {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            return false;
+        }
+        file.write(content);
+        return file.commit();
+    }
+
+    static Config configWithScheme(const QString& scheme)
+    {
+        Config config;
+        config.setSchemeName(scheme);
+        return config;
+    }
+
+private slots:
+    void testReadValidFile()
+    {
+        QTemporaryDir dir;
+        QString path = dir.path() + "/config.json";
+        QVERIFY(configWithScheme("readtest").saveTo(path));
+
+        ConfigReadResult result = ConfigWatcher::read(path);
+        QVERIFY(result.success());
+        QCOMPARE(result.config.schemeName(), "readtest");
+    }
+
+    void testReadInvalidJsonReportsReason()
+    {
+        QTemporaryDir dir;
+        QString path = dir.path() + "/config.json";
+        QVERIFY(writeAtomically(path, R"({"schemeName": )"));
+
+        ConfigReadResult result = ConfigWatcher::read(path);
+        QVERIFY(!result.success());
+        QVERIFY(result.error.contains("Invalid JSON"));
+    }
+
+    void testReadNonObjectReportsReason()
+    {
+        QTemporaryDir dir;
+        QString path = dir.path() + "/config.json";
+        QVERIFY(writeAtomically(path, "[1, 2]"));
+
+        ConfigReadResult result = ConfigWatcher::read(path);
+        QVERIFY(!result.success());
+        QVERIFY(result.error.contains("JSON object"));
+    }
+
+    void testReadMissingFileReportsReason()
+    {
+        QTemporaryDir dir;
+        ConfigReadResult result = ConfigWatcher::read(dir.path() + "/config.json");
+        QVERIFY(!result.success());
+        QVERIFY(result.error.contains("removed"));
+    }
+
+    void testAtomicRenameTriggersReload()
+    {
+        QTemporaryDir dir;
+        QString path = dir.path() + "/config.json";
+        QVERIFY(configWithScheme("before").saveTo(path));
+
+        ConfigWatcher watcher(path);
+        watcher.setDebounceInterval(50);
+        QVERIFY(watcher.start());
+        QSignalSpy changed(&watcher, &ConfigWatcher::configChanged);
+
+        QVERIFY(configWithScheme("afterrename").saveTo(path));
+
+        QVERIFY(changed.wait(5000));
+        QCOMPARE(changed.last().at(0).value<Config>().schemeName(), "afterrename");
+    }
+
+    void testRepeatedRenamesKeepWatching()
+    {
+        QTemporaryDir dir;
+        QString path = dir.path() + "/config.json";
+        QVERIFY(configWithScheme("first").saveTo(path));
+
+        ConfigWatcher watcher(path);
+        watcher.setDebounceInterval(50);
+        QVERIFY(watcher.start());
+        QSignalSpy changed(&watcher, &ConfigWatcher::configChanged);
+
+        QVERIFY(configWithScheme("second").saveTo(path));
+        QVERIFY(changed.wait(5000));
+
+        QVERIFY(configWithScheme("thirdscheme").saveTo(path));
+        QTRY_COMPARE_WITH_TIMEOUT(changed.last().at(0).value<Config>().schemeName(),
+                                  "thirdscheme", 5000);
+    }
+
+    void testBurstIsDebounced()
+    {
+        QTemporaryDir dir;
+        QString path = dir.path() + "/config.json";
+        QVERIFY(configWithScheme("initial").saveTo(path));
+
+        ConfigWatcher watcher(path);
+        watcher.setDebounceInterval(300);
+        QVERIFY(watcher.start());
+        QSignalSpy changed(&watcher, &ConfigWatcher::configChanged);
+
+        for (int i = 0; i < 5; ++i)
+        {
+            QVERIFY(configWithScheme(QString("burst%1").arg(i)).saveTo(path));
+        }
+
+        QVERIFY(changed.wait(5000));
+        QTest::qWait(500);
+        QCOMPARE(changed.count(), 1);
+        QCOMPARE(changed.last().at(0).value<Config>().schemeName(), "burst4");
+    }
+
+    void testInvalidEditReportsFailure()
+    {
+        QTemporaryDir dir;
+        QString path = dir.path() + "/config.json";
+        QVERIFY(configWithScheme("good").saveTo(path));
+
+        ConfigWatcher watcher(path);
+        watcher.setDebounceInterval(50);
+        QVERIFY(watcher.start());
+        QSignalSpy changed(&watcher, &ConfigWatcher::configChanged);
+        QSignalSpy failed(&watcher, &ConfigWatcher::reloadFailed);
+
+        QVERIFY(writeAtomically(path, "not json"));
+
+        QVERIFY(failed.wait(5000));
+        QVERIFY(failed.at(0).at(0).toString().contains("Invalid JSON"));
+        QCOMPARE(changed.count(), 0);
+    }
+
+    void testUnrelatedFileIgnored()
+    {
+        QTemporaryDir dir;
+        QString path = dir.path() + "/config.json";
+        QVERIFY(configWithScheme("unchanged").saveTo(path));
+
+        ConfigWatcher watcher(path);
+        watcher.setDebounceInterval(50);
+        QVERIFY(watcher.start());
+        QSignalSpy changed(&watcher, &ConfigWatcher::configChanged);
+        QSignalSpy failed(&watcher, &ConfigWatcher::reloadFailed);
+
+        // e.g. the binary config cache written next to config.json
+        QVERIFY(writeAtomically(dir.path() + "/config.cache", "cache"));
+
+        QTest::qWait(500);
+        QCOMPARE(changed.count(), 0);
+        QCOMPARE(failed.count(), 0);
+    }
+};
+
+int runConfigWatcherTests(int argc, char* argv[])
+{
+    ConfigWatcherTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "ConfigWatcherTests.moc"
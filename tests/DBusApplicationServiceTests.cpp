@@ -0,0 +1,163 @@
+#include "DBusApplicationService.hpp"
+#include "SchemeRegistry.hpp"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCall>
+#include <QProcess>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTest>
+
+using namespace uncopener;
+
+class DBusApplicationServiceTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    /// Private session bus, so tests never talk to a real handler instance
+    QProcess m_daemon;
+    QString m_address;
+
+    /// Connect to the private bus under a unique connection name
+    [[nodiscard]] QDBusConnection connectToPrivateBus(const QString& name) const
+    {
+        return QDBusConnection::connectToBus(m_address, name);
+    }
+
+    /// Call a method of the org.freedesktop.Application interface
+    static QDBusPendingCall call(QDBusConnection& connection, const QString& method,
+                                 const QVariantList& arguments)
+    {
+        QDBusMessage message = QDBusMessage::createMethodCall(
+            SchemeRegistry::DBUS_SERVICE_NAME, DBusApplicationService::OBJECT_PATH,
+            "org.freedesktop.Application", method);
+        message.setArguments(arguments);
+        return connection.asyncCall(message);
+    }
+
+private slots:
+    void initTestCase()
+    {
+        QString daemon = QStandardPaths::findExecutable("dbus-daemon");
+        if (daemon.isEmpty())
+        {
+            QSKIP("dbus-daemon not available");
+        }
+
+        m_daemon.start(daemon, {"--session", "--nofork", "--print-address"});
+        QVERIFY(m_daemon.waitForStarted(5000));
+        QVERIFY(m_daemon.waitForReadyRead(5000));
+        m_address = QString::fromUtf8(m_daemon.readLine()).trimmed();
+        QVERIFY(!m_address.isEmpty());
+    }
+
+    void cleanupTestCase()
+    {
+        m_daemon.kill();
+        m_daemon.waitForFinished(5000);
+    }
+
+    void cleanup()
+    {
+        QDBusConnection::disconnectFromBus("service");
+        QDBusConnection::disconnectFromBus("client");
+        QDBusConnection::disconnectFromBus("second");
+    }
+
+    void testRegister()
+    {
+        QDBusConnection bus = connectToPrivateBus("service");
+        QVERIFY(bus.isConnected());
+
+        DBusApplicationService service;
+        QVERIFY(service.registerOn(bus, SchemeRegistry::DBUS_SERVICE_NAME));
+    }
+
+    void testSecondInstanceCannotRegister()
+    {
+        QDBusConnection bus = connectToPrivateBus("service");
+        DBusApplicationService first;
+        QVERIFY(first.registerOn(bus, SchemeRegistry::DBUS_SERVICE_NAME));
+
+        QDBusConnection secondBus = connectToPrivateBus("second");
+        DBusApplicationService second;
+        QVERIFY(!second.registerOn(secondBus, SchemeRegistry::DBUS_SERVICE_NAME));
+    }
+
+    void testOpenDeliversUrls()
+    {
+        QDBusConnection bus = connectToPrivateBus("service");
+        DBusApplicationService service;
+        QVERIFY(service.registerOn(bus, SchemeRegistry::DBUS_SERVICE_NAME));
+        QSignalSpy spy(&service, &DBusApplicationService::openRequested);
+
+        QDBusConnection client = connectToPrivateBus("client");
+        QStringList urls{"uncopener://server/share/a.txt", "uncopener://server/b path/"};
+        QDBusPendingCall pending = call(client, "Open", {urls, QVariantMap()});
+
+        QVERIFY(spy.wait(2000));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toStringList(), urls);
+
+        QTRY_VERIFY_WITH_TIMEOUT(pending.isFinished(), 2000);
+        QVERIFY(!pending.isError());
+    }
+
+    void testOpenReusesInstance()
+    {
+        QDBusConnection bus = connectToPrivateBus("service");
+        DBusApplicationService service;
+        QVERIFY(service.registerOn(bus, SchemeRegistry::DBUS_SERVICE_NAME));
+        QSignalSpy spy(&service, &DBusApplicationService::openRequested);
+
+        QDBusConnection client = connectToPrivateBus("client");
+        QStringList first{"uncopener://server/a"};
+        QStringList second{"uncopener://server/b"};
+        static_cast<void>(call(client, "Open", {first, QVariantMap()}));
+        static_cast<void>(call(client, "Open", {second, QVariantMap()}));
+
+        QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 2, 2000);
+        QCOMPARE(spy.at(0).at(0).toStringList(), first);
+        QCOMPARE(spy.at(1).at(0).toStringList(), second);
+    }
+
+    void testActivate()
+    {
+        QDBusConnection bus = connectToPrivateBus("service");
+        DBusApplicationService service;
+        QVERIFY(service.registerOn(bus, SchemeRegistry::DBUS_SERVICE_NAME));
+        QSignalSpy activatedSpy(&service, &DBusApplicationService::activated);
+        QSignalSpy openSpy(&service, &DBusApplicationService::openRequested);
+
+        QDBusConnection client = connectToPrivateBus("client");
+        static_cast<void>(call(client, "Activate", {QVariantMap()}));
+
+        QVERIFY(activatedSpy.wait(2000));
+        QCOMPARE(openSpy.count(), 0);
+    }
+
+    void testOpenWithoutUrlsIsIgnored()
+    {
+        QDBusConnection bus = connectToPrivateBus("service");
+        DBusApplicationService service;
+        QVERIFY(service.registerOn(bus, SchemeRegistry::DBUS_SERVICE_NAME));
+        QSignalSpy spy(&service, &DBusApplicationService::openRequested);
+
+        QDBusConnection client = connectToPrivateBus("client");
+        QDBusPendingCall pending = call(client, "Open", {QStringList(), QVariantMap()});
+        QTRY_VERIFY_WITH_TIMEOUT(pending.isFinished(), 2000);
+
+        QVERIFY(!pending.isError());
+        QCOMPARE(spy.count(), 0);
+    }
+};
+
+int runDBusApplicationServiceTests(int argc, char* argv[])
+{
+    DBusApplicationServiceTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "DBusApplicationServiceTests.moc"
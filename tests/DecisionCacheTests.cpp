@@ -0,0 +1,190 @@
+#include "DecisionCache.hpp"
+#include "PolicyStore.hpp"
+
+#include <QTest>
+
+using namespace uncopener;
+
+class DecisionCacheTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static Config testConfig()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\server\share)"});
+        config.setFiletypeMode(FiletypeMode::Blacklist);
+        config.setFiletypeBlacklist({".exe"});
+        return config;
+    }
+
+    static ValidationResult allowed(const QString& target)
+    {
+        return {UncPath{"server", "share", false}, PolicyCheckResult::allow(), target};
+    }
+
+private slots:
+    void testMissThenHit()
+    {
+        DecisionCache cache;
+        QVERIFY(cache.find("uncopener://server/share", 1) == nullptr);
+
+        cache.insert("uncopener://server/share", 1, allowed("smb://server/share"));
+        const ValidationResult* decision = cache.find("uncopener://server/share", 1);
+        QVERIFY(decision != nullptr);
+        QCOMPARE(decision->targetUrl, "smb://server/share");
+
+        QCOMPARE(cache.stats().misses, 1);
+        QCOMPARE(cache.stats().hits, 1);
+        QCOMPARE(cache.size(), 1);
+    }
+
+    void testOtherGenerationInvalidates()
+    {
+        DecisionCache cache;
+        cache.insert("uncopener://server/share", 1, allowed("smb://server/share"));
+
+        QVERIFY(cache.find("uncopener://server/share", 2) == nullptr);
+        QCOMPARE(cache.size(), 0);
+        QCOMPARE(cache.stats().invalidations, 1);
+    }
+
+    void testLeastRecentlyUsedEvicted()
+    {
+        // Room for exactly two entries of the same cost
+        ValidationResult decision = allowed("smb://server/share");
+        qsizetype cost = DecisionCache::costOf("uncopener://a", decision);
+        DecisionCache cache(2 * cost);
+
+        cache.insert("uncopener://a", 1, decision);
+        cache.insert("uncopener://b", 1, decision);
+        QVERIFY(cache.find("uncopener://a", 1) != nullptr); // a is now most recently used
+        cache.insert("uncopener://c", 1, decision);
+
+        QVERIFY(cache.find("uncopener://a", 1) != nullptr);
+        QVERIFY(cache.find("uncopener://b", 1) == nullptr);
+        QVERIFY(cache.find("uncopener://c", 1) != nullptr);
+        QCOMPARE(cache.stats().evictions, 1);
+    }
+
+    void testMemoryCapHeld()
+    {
+        DecisionCache cache(4096);
+        for (int i = 0; i < 1000; ++i)
+        {
+            cache.insert(QString("uncopener://server/share/%1").arg(i), 1,
+                         allowed("smb://server/share"));
+            QVERIFY(cache.bytes() <= cache.maxBytes());
+        }
+        QVERIFY(cache.size() < 1000);
+        QCOMPARE(cache.stats().evictions, 1000 - cache.size());
+    }
+
+    void testOversizedEntryNotStored()
+    {
+        DecisionCache cache(16);
+        cache.insert("uncopener://server/share", 1, allowed("smb://server/share"));
+        QCOMPARE(cache.size(), 0);
+        QCOMPARE(cache.stats().evictions, 0);
+    }
+
+    void testReplaceIsNoEviction()
+    {
+        DecisionCache cache;
+        cache.insert("uncopener://server/share", 1, allowed("smb://server/a"));
+        cache.insert("uncopener://server/share", 1, allowed("smb://server/b"));
+
+        QCOMPARE(cache.size(), 1);
+        QCOMPARE(cache.stats().evictions, 0);
+        QCOMPARE(cache.find("uncopener://server/share", 1)->targetUrl, "smb://server/b");
+    }
+
+    void testOpenerServesRepeatsFromCache()
+    {
+        PathOpener opener(testConfig());
+        DecisionCache cache;
+        opener.setDecisionCache(&cache);
+
+        QVERIFY(opener.evaluateCached("uncopener://server/share/a.txt").allowed());
+        ValidationResult repeat = opener.evaluateCached("uncopener://server/share/a.txt");
+        QVERIFY(repeat.allowed());
+        QCOMPARE(cache.stats().misses, 1);
+        QCOMPARE(cache.stats().hits, 1);
+        QCOMPARE(repeat.displayPath(), R"(\\server\share\a.txt)");
+        QVERIFY(!opener.evaluateCached("uncopener://server/share/a.txt").targetUrl.isEmpty());
+    }
+
+    void testOpenerCachesDenials()
+    {
+        PathOpener opener(testConfig());
+        DecisionCache cache;
+        opener.setDecisionCache(&cache);
+
+        ValidationResult first = opener.evaluateCached("uncopener://server/share/setup.exe");
+        ValidationResult second = opener.evaluateCached("uncopener://server/share/setup.exe");
+        QVERIFY(!second.allowed());
+        QCOMPARE(second.policy.reason, first.policy.reason);
+        QCOMPARE(cache.stats().hits, 1);
+        QVERIFY(opener.evaluateCached("uncopener://server/share/setup.exe").targetUrl.isEmpty());
+    }
+
+    void testCaseAndEscapeVariantsShareEntry()
+    {
+        PathOpener opener(testConfig());
+        DecisionCache cache;
+        opener.setDecisionCache(&cache);
+
+        QVERIFY(opener.evaluateCached("uncopener://server/share/a.txt").allowed());
+        ValidationResult variant = opener.evaluateCached("uncopener://SERVER/Share/%41.TXT");
+        QVERIFY(variant.allowed());
+        QVERIFY(!opener.evaluateCached("uncopener://server/share/setup.exe").allowed());
+        QVERIFY(!opener.evaluateCached("uncopener://Server/SHARE/setup%2EEXE").allowed());
+
+        QCOMPARE(cache.size(), 2);
+        QCOMPARE(cache.stats().misses, 2);
+        QCOMPARE(cache.stats().hits, 2);
+
+        // The variant keeps its own spelling, the verdict is shared
+        QCOMPARE(variant.displayPath(), R"(\\SERVER\Share\A.TXT)");
+        QCOMPARE(variant.targetUrl, opener.evaluate("uncopener://SERVER/Share/A.TXT").targetUrl);
+    }
+
+    void testUnparsedUrlDoesNotCollideWithPath()
+    {
+        PathOpener opener(testConfig());
+        DecisionCache cache;
+        opener.setDecisionCache(&cache);
+
+        QVERIFY(opener.evaluateCached("uncopener://server/share").allowed());
+        QVERIFY(!opener.evaluateCached(R"(\\server\share)").allowed());
+        QCOMPARE(cache.size(), 2);
+    }
+
+    void testReloadInvalidatesCachedVerdicts()
+    {
+        PolicyStore store(testConfig());
+        DecisionCache cache;
+
+        PathOpener before(store.snapshot());
+        before.setDecisionCache(&cache);
+        QVERIFY(before.evaluateCached("uncopener://server/share/a.txt").allowed());
+
+        Config changed = testConfig();
+        changed.setUncAllowList({R"(\\other)"});
+        store.reload(changed);
+
+        PathOpener after(store.snapshot());
+        after.setDecisionCache(&cache);
+        QVERIFY(!after.evaluateCached("uncopener://server/share/a.txt").allowed());
+        QCOMPARE(cache.stats().invalidations, 1);
+    }
+};
+
+int runDecisionCacheTests(int argc, char* argv[])
+{
+    DecisionCacheTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "DecisionCacheTests.moc"
@@ -0,0 +1,203 @@
+#include "DecisionFilter.hpp"
+#include "PathOpener.hpp"
+
+#include <QBuffer>
+#include <QTest>
+
+using namespace uncopener;
+
+class DecisionFilterTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static Config testConfig()
+    {
+        Config config;
+        config.setSchemeName("uncopener");
+        config.setUncAllowList({R"(\\server\share)", R"(\\server\share\deep)"});
+        config.setFiletypeMode(FiletypeMode::Blacklist);
+        config.setFiletypeBlacklist({".exe", ".pdf.exe"});
+        return config;
+    }
+
+    static QByteArray runFilter(const Config& config, const QByteArray& lines,
+                                DecisionFilter::Format format)
+    {
+        QBuffer input;
+        input.setData(lines);
+        QBuffer output;
+        if (!input.open(QIODevice::ReadOnly) || !output.open(QIODevice::WriteOnly))
+        {
+            return {};
+        }
+        DecisionFilter(config).run(input, output, format);
+        return output.data();
+    }
+
+private slots:
+    void testEvaluateAllowed()
+    {
+        DecisionFilter filter(testConfig());
+        Decision decision = filter.evaluate(u"uncopener://server/share/deep/file.txt");
+
+        QVERIFY(decision.allowed);
+        QCOMPARE(decision.reason, Decision::Reason::None);
+        QCOMPARE(decision.target, R"(\\server\share\deep\file.txt)");
+        QCOMPARE(decision.matchedRule, R"(\\server\share\deep)");
+        QCOMPARE(decision.reasonCode(), "");
+    }
+
+    void testEvaluateInvalidUrl()
+    {
+        DecisionFilter filter(testConfig());
+        Decision decision = filter.evaluate(u"uncopener://server/share/../other");
+
+        QVERIFY(!decision.allowed);
+        QCOMPARE(decision.reason, Decision::Reason::InvalidUrl);
+        QCOMPARE(decision.parseError, ParseError::Code::DirectoryTraversal);
+        QVERIFY(decision.target.isEmpty());
+        QCOMPARE(decision.reasonCode(), "directory-traversal");
+    }
+
+    void testEvaluateNotInAllowList()
+    {
+        DecisionFilter filter(testConfig());
+        Decision decision = filter.evaluate(u"uncopener://other/share/file.txt");
+
+        QVERIFY(!decision.allowed);
+        QCOMPARE(decision.reasonCode(), "not-in-allow-list");
+        QCOMPARE(decision.target, R"(\\other\share\file.txt)");
+        QVERIFY(decision.matchedRule.isEmpty());
+    }
+
+    void testEvaluateBlacklistedReportsLongestExtension()
+    {
+        DecisionFilter filter(testConfig());
+        Decision decision = filter.evaluate(u"uncopener://server/share/Report.PDF.exe");
+
+        QVERIFY(!decision.allowed);
+        QCOMPARE(decision.reasonCode(), "filetype-blacklisted");
+        QCOMPARE(decision.matchedRule, ".pdf.exe");
+    }
+
+    void testEvaluateWhitelist()
+    {
+        Config config;
+        config.setFiletypeWhitelist({".txt"});
+        DecisionFilter filter(config);
+
+        Decision allowed = filter.evaluate(u"uncopener://server/share/a.TXT");
+        QVERIFY(allowed.allowed);
+        QCOMPARE(allowed.matchedRule, ".txt");
+
+        Decision denied = filter.evaluate(u"uncopener://server/share/a.doc");
+        QVERIFY(!denied.allowed);
+        QCOMPARE(denied.reasonCode(), "filetype-not-whitelisted");
+        QVERIFY(denied.matchedRule.isEmpty());
+
+        // Directories have no filetype
+        QVERIFY(filter.evaluate(u"uncopener://server/share/folder/").allowed);
+    }
+
+    void testEvaluateAgreesWithPathOpener()
+    {
+        Config config = testConfig();
+        DecisionFilter filter(config);
+        PathOpener opener(config);
+
+        const QStringList urls = {"uncopener://server/share/a.txt",
+                                  "uncopener://SERVER/SHARE/a.txt",
+                                  "uncopener://server/share/a.exe",
+                                  "uncopener://server/shared/a.txt",
+                                  "uncopener://server/share/file%20name.exe",
+                                  "uncopener://server",
+                                  "uncopener:/server/share",
+                                  "http://server/share",
+                                  ""};
+        for (const QString& url : urls)
+        {
+            Decision decision = filter.evaluate(url);
+            ValidationResult validation = opener.evaluate(url);
+            QCOMPARE(decision.allowed, opener.evaluate(url).allowed());
+            QCOMPARE(decision.matchedRule, validation.policy.matchedRule);
+        }
+    }
+
+    void testEvaluateResolvesServerAliases()
+    {
+        Config config = testConfig();
+        config.setServerAliases({{"srv", "server"}, {"server.corp.example.com", "server"}});
+        DecisionFilter filter(config);
+        PathOpener opener(config);
+
+        for (const QString& url : {QString("uncopener://SRV/share/a.txt"),
+                                   QString("uncopener://server.corp.example.com/share/a.txt")})
+        {
+            Decision decision = filter.evaluate(url);
+            QVERIFY(decision.allowed);
+            QCOMPARE(decision.target, R"(\\server\share\a.txt)");
+            QCOMPARE(decision.target, opener.evaluate(url).displayPath());
+        }
+    }
+
+    void testRunWritesJsonLinePerInputLine()
+    {
+        QByteArray output = runFilter(testConfig(),
+                                      "uncopener://server/share/a.txt\n"
+                                      "\n"
+                                      "  uncopener://server/share/b.exe \r\n"
+                                      "uncopener://server/share/\"quoted\"",
+                                      DecisionFilter::Format::Json);
+
+        QList<QByteArray> lines = output.split('\n');
+        QCOMPARE(lines.size(), 5);
+        QCOMPARE(lines.at(0), R"({"verdict":"allow","reason":"",)"
+                              R"("target":"\\\\server\\share\\a.txt","rule":"\\\\server\\share"})");
+        QCOMPARE(lines.at(1),
+                 R"({"verdict":"deny","reason":"empty-input","target":"","rule":""})");
+        QCOMPARE(lines.at(2), R"({"verdict":"deny","reason":"filetype-blacklisted",)"
+                              R"("target":"\\\\server\\share\\b.exe","rule":".exe"})");
+        QVERIFY(lines.at(3).contains(R"(\"quoted\")"));
+        QVERIFY(lines.at(4).isEmpty());
+    }
+
+    void testRunWritesTsv()
+    {
+        QByteArray output = runFilter(testConfig(), "uncopener://other/share/a%09b.txt\n",
+                                      DecisionFilter::Format::Tsv);
+
+        // The decoded tab must not break the columns
+        QCOMPARE(output, "deny\tnot-in-allow-list\t\\\\other\\share\\a b.txt\t\n");
+    }
+
+    void testRunEncodesUtf8()
+    {
+        QByteArray output = runFilter(Config(), "uncopener://server/share/%C3%A4.txt\n",
+                                      DecisionFilter::Format::Tsv);
+
+        QCOMPARE(QString::fromUtf8(output),
+                 QString(u"allow\t\t\\\\server\\share\\\u00e4.txt\t\n"));
+    }
+
+    void testRunRejectsOverlongLine()
+    {
+        QByteArray longLine = "uncopener://server/share/" +
+                              QByteArray(DecisionFilter::MAX_LINE_LENGTH, 'a') + "\n";
+        QByteArray output = runFilter(testConfig(), longLine + "uncopener://server/share/a.txt\n",
+                                      DecisionFilter::Format::Tsv);
+
+        QList<QByteArray> lines = output.split('\n');
+        QCOMPARE(lines.size(), 3);
+        QCOMPARE(lines.at(0), "deny\tline-too-long\t\t");
+        QVERIFY(lines.at(1).startsWith("allow\t"));
+    }
+};
+
+int runDecisionFilterTests(int argc, char* argv[])
+{
+    DecisionFilterTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "DecisionFilterTests.moc"
@@ -1,3 +1,4 @@
+#include "BatchErrorDialog.hpp"
 #include "ErrorDialog.hpp"
 #include "MainWindow.hpp"
 
@@ -6,6 +7,7 @@
 #include <QLabel>
 #include <QLineEdit>
 #include <QTest>
+#include <QTreeWidget>
 
 class DialogsTest : public QObject
 {
@@ -62,6 +64,28 @@ private slots:
         QVERIFY(dialog.isModal());
     }
 
+    void testBatchErrorDialogListsFailures()
+    {
+        QList<uncopener::BatchFailure> failures = {
+            {"uncopener://a/s/x", R"(\\a\s\x)", "Path not in allow-list", "Add it"},
+            {"bad", "bad", "No URL scheme found in input", "Use the scheme"}};
+        BatchErrorDialog dialog(failures, 5);
+
+        QCOMPARE(dialog.windowTitle(), QString("UncOpener - Error"));
+        QVERIFY(dialog.isModal());
+
+        auto* title = dialog.findChild<QLabel*>("titleLabel");
+        QVERIFY(title != nullptr);
+        QCOMPARE(title->text(), "Failed to open 2 of 5 URLs");
+
+        auto* list = dialog.findChild<QTreeWidget*>("failureList");
+        QVERIFY(list != nullptr);
+        QCOMPARE(list->topLevelItemCount(), 2);
+        QCOMPARE(list->topLevelItem(0)->text(0), R"(\\a\s\x)");
+        QCOMPARE(list->topLevelItem(0)->text(1), "Path not in allow-list");
+        QCOMPARE(list->topLevelItem(1)->text(2), "Use the scheme");
+    }
+
     void testMainWindowHasWindowIcon()
     {
         MainWindow window;
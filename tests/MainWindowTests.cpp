@@ -115,6 +115,34 @@ private:
         return nullptr;
     }
 
+    QLineEdit* findTestUrlEdit(MainWindow& window)
+    {
+        QList<QLineEdit*> edits = window.findChildren<QLineEdit*>();
+        for (QLineEdit* edit : edits)
+        {
+            if (edit->placeholderText().startsWith("uncopener://"))
+            {
+                return edit;
+            }
+        }
+        return nullptr;
+    }
+
+    QLabel* findTestResultLabel(MainWindow& window)
+    {
+        QList<QLabel*> labels = window.findChildren<QLabel*>();
+        for (QLabel* label : labels)
+        {
+            QString text = label->text();
+            if (text.startsWith("Opens: ") || text.startsWith("Blocked: ") ||
+                text.startsWith("Enter a link"))
+            {
+                return label;
+            }
+        }
+        return nullptr;
+    }
+
     QLabel* findStatusLabel(MainWindow& window)
     {
         QList<QLabel*> labels = window.findChildren<QLabel*>();
@@ -687,6 +715,61 @@ private slots:
         QVERIFY2(filetypeEntry->text().isEmpty(),
                  "Filetype entry edit should be cleared after adding");
     }
+
+    // ========== Link Test Tests ==========
+
+    void testLinkTestShowsTarget()
+    {
+        MainWindow window;
+
+        QLineEdit* schemeEdit = findSchemeNameEdit(window);
+        QLineEdit* uncEntry = findUncEntryEdit(window);
+        QLineEdit* testUrlEdit = findTestUrlEdit(window);
+        QLabel* resultLabel = findTestResultLabel(window);
+        QVERIFY(schemeEdit);
+        QVERIFY(uncEntry);
+        QVERIFY(testUrlEdit);
+        QVERIFY(resultLabel);
+
+        schemeEdit->setText("linktest");
+        uncEntry->setText(R"(\\linkserver)");
+        QTest::keyClick(uncEntry, Qt::Key_Return);
+
+        testUrlEdit->setText("linktest://linkserver/share/");
+        QTRY_VERIFY2(resultLabel->text().startsWith("Opens: "), qPrintable(resultLabel->text()));
+
+        testUrlEdit->setText("other://linkserver/share/");
+        QTRY_VERIFY(resultLabel->text().startsWith("Blocked: "));
+
+        // The result follows edits of the settings
+        schemeEdit->setText("other");
+        QTRY_VERIFY(resultLabel->text().startsWith("Opens: "));
+    }
+
+    void testLinkTestWaitsForPauseInTyping()
+    {
+        MainWindow window;
+
+        QLineEdit* schemeEdit = findSchemeNameEdit(window);
+        QLineEdit* uncEntry = findUncEntryEdit(window);
+        QLineEdit* testUrlEdit = findTestUrlEdit(window);
+        QLabel* resultLabel = findTestResultLabel(window);
+        QVERIFY(schemeEdit);
+        QVERIFY(uncEntry);
+        QVERIFY(testUrlEdit);
+        QVERIFY(resultLabel);
+
+        schemeEdit->setText("typedtest");
+        uncEntry->setText(R"(\\typedserver)");
+        QTest::keyClick(uncEntry, Qt::Key_Return);
+        QTRY_VERIFY(resultLabel->text().startsWith("Enter a link"));
+
+        // Keystrokes do not evaluate the partial link
+        testUrlEdit->setText("typedtest://typedserver/share/");
+        testUrlEdit->setText("typedtest://typedserver/share/a");
+        QVERIFY(resultLabel->text().startsWith("Enter a link"));
+        QTRY_VERIFY2(resultLabel->text().startsWith("Opens: "), qPrintable(resultLabel->text()));
+    }
 };
 
 int runMainWindowTests(int argc, char* argv[])
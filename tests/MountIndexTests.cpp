@@ -0,0 +1,188 @@
+#include "MountIndex.hpp"
+#include "PathOpener.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QUrl>
+
+#include <memory>
+
+using namespace uncopener;
+
+namespace
+{
+
+// Two cifs mounts (one of a folder below the share, one with a space in the mount point),
+// an smb3 mount, and unrelated mounts that must be ignored
+const QByteArray MOUNTINFO =
+    "22 1 8:1 / / rw,relatime shared:1 - ext4 /dev/sda1 rw\n"
+    "40 22 0:40 / /mnt/data rw,relatime shared:20 - cifs //server/data rw,vers=3.1.1\n"
+    "41 22 0:41 /projects /mnt/projects rw,relatime - cifs //server/share rw\n"
+    "42 22 0:42 / /media/my\\040share rw,relatime - smb3 //other/my\\040share rw\n"
+    "43 22 0:43 / /mnt/nfs rw,relatime - nfs4 server:/export rw\n";
+
+} // namespace
+
+class MountIndexTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dir;
+
+    [[nodiscard]] QString mountInfoPath() const { return m_dir.filePath("mountinfo"); }
+    [[nodiscard]] QString gvfsPath() const { return m_dir.filePath("gvfs"); }
+
+    void writeMountInfo(const QByteArray& content) const
+    {
+        QFile file(mountInfoPath());
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(content);
+    }
+
+    static UncPath unc(const QString& server, const QString& path, bool trailingSlash = false)
+    {
+        UncPath result;
+        result.server = server;
+        result.path = path;
+        result.hasTrailingSlash = trailingSlash;
+        return result;
+    }
+
+private slots:
+    void init()
+    {
+        QVERIFY(m_dir.isValid());
+        writeMountInfo(MOUNTINFO);
+        QDir(gvfsPath()).removeRecursively();
+        QVERIFY(QDir().mkpath(gvfsPath() + "/smb-share:server=gv,share=my%20data,user=me"));
+        QVERIFY(QDir().mkpath(gvfsPath() + "/sftp:host=gv"));
+    }
+
+    void testParseMountInfo()
+    {
+        QList<MountEntry> entries = MountIndex::parseMountInfo(MOUNTINFO);
+        QCOMPARE(entries.size(), 3);
+        QCOMPARE(entries.at(0).server, "server");
+        QCOMPARE(entries.at(0).path, "data");
+        QCOMPARE(entries.at(0).localPath, "/mnt/data");
+        QCOMPARE(entries.at(1).path, R"(share\projects)");
+        QCOMPARE(entries.at(2).path, "my share");
+        QCOMPARE(entries.at(2).localPath, "/media/my share");
+    }
+
+    void testParseGvfsName()
+    {
+        MountEntry entry;
+        QVERIFY(MountIndex::parseGvfsName("smb-share:domain=WG,server=srv,share=a%2Cb", entry));
+        QCOMPARE(entry.server, "srv");
+        QCOMPARE(entry.path, "a,b");
+
+        QVERIFY(!MountIndex::parseGvfsName("smb-share:server=srv", entry));
+        QVERIFY(!MountIndex::parseGvfsName("sftp:host=srv", entry));
+    }
+
+    void testLookup()
+    {
+        MountIndex index(mountInfoPath(), gvfsPath());
+        QCOMPARE(index.entries().size(), 4);
+
+        QCOMPARE(index.localPath(unc("server", R"(data\reports\q1.pdf)")),
+                 "/mnt/data/reports/q1.pdf");
+        QCOMPARE(index.localPath(unc("server", "data")), "/mnt/data");
+        QCOMPARE(index.localPath(unc("other", R"(my share\a.txt)")), "/media/my share/a.txt");
+        QCOMPARE(index.localPath(unc("gv", R"(my data\x)")),
+                 gvfsPath() + "/smb-share:server=gv,share=my%20data,user=me/x");
+
+        // Not mounted: other share, other server, only a folder of the share is mounted
+        QVERIFY(index.localPath(unc("server", "backup")).isEmpty());
+        QVERIFY(index.localPath(unc("unknown", "data")).isEmpty());
+        QVERIFY(index.localPath(unc("server", R"(share\other)")).isEmpty());
+    }
+
+    void testLongestPrefixWins()
+    {
+        writeMountInfo(MOUNTINFO +
+                       "44 22 0:44 / /mnt/share rw - cifs //server/share rw\n");
+        MountIndex index(mountInfoPath(), {});
+
+        QCOMPARE(index.localPath(unc("server", R"(share\projects\x.txt)")),
+                 "/mnt/projects/x.txt");
+        QCOMPARE(index.localPath(unc("server", R"(share\other\x.txt)")),
+                 "/mnt/share/other/x.txt");
+    }
+
+    void testTraversalIsNotMapped()
+    {
+        MountIndex index(mountInfoPath(), gvfsPath());
+
+        // What the parser decodes from %2E%2E and %2F
+        QVERIFY(index.localPath(unc("server", R"(data\..\..\etc\passwd)")).isEmpty());
+        QVERIFY(index.localPath(unc("server", R"(data\reports/../../../etc)")).isEmpty());
+        QVERIFY(index.localPath(unc("server", R"(data\.\x.txt)")).isEmpty());
+        QVERIFY(index.localUrl(unc("gv", R"(my data\..)")).isEmpty());
+
+        // Dots within a name are fine
+        QCOMPARE(index.localPath(unc("server", R"(data\..x\a..b)")), "/mnt/data/..x/a..b");
+    }
+
+    void testCaseInsensitiveAndTrailingSlash()
+    {
+        MountIndex index(mountInfoPath(), {});
+        QCOMPARE(index.localPath(unc("SERVER", R"(Data\Folder)", true)), "/mnt/data/Folder/");
+        QCOMPARE(index.localUrl(unc("other", "my share", true)),
+                 "file:///media/my%20share/");
+    }
+
+    void testRefreshOnlyOnChange()
+    {
+        MountIndex index(mountInfoPath(), gvfsPath());
+        QVERIFY(!index.refresh());
+
+        writeMountInfo("40 22 0:40 / /mnt/data rw - cifs //server/data rw\n");
+        QVERIFY(index.refresh());
+        QVERIFY(index.localPath(unc("other", "my share")).isEmpty());
+
+        QVERIFY(QDir(gvfsPath()).removeRecursively());
+        QVERIFY(index.refresh());
+        QVERIFY(index.localPath(unc("gv", "my data")).isEmpty());
+        QVERIFY(!index.refresh());
+    }
+
+    void testMissingSources()
+    {
+        MountIndex index(m_dir.filePath("missing"), m_dir.filePath("missing-gvfs"));
+        QVERIFY(index.entries().isEmpty());
+        QVERIFY(index.localPath(unc("server", "data")).isEmpty());
+    }
+
+    void testPathOpenerResolvesMountedTarget()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\server)"});
+        PathOpener opener(config);
+
+        ValidationResult mounted = opener.evaluate("uncopener://server/data/a.txt");
+        ValidationResult unmounted = opener.evaluate("uncopener://server/backup/a.txt");
+        QCOMPARE(opener.resolveTarget(mounted), mounted.targetUrl);
+
+        opener.setMountIndex(std::make_shared<MountIndex>(mountInfoPath(), gvfsPath()));
+        QCOMPARE(opener.resolveTarget(mounted), QUrl::fromLocalFile("/mnt/data/a.txt").toString());
+        QCOMPARE(opener.resolveTarget(unmounted), unmounted.targetUrl);
+
+        // Denied paths never resolve to a target
+        ValidationResult denied = opener.evaluate("uncopener://other/my share/a.txt");
+        QVERIFY(!denied.allowed());
+        QVERIFY(opener.resolveTarget(denied).isEmpty());
+    }
+};
+
+int runMountIndexTests(int argc, char* argv[])
+{
+    MountIndexTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "MountIndexTests.moc"
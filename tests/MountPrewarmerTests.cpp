@@ -0,0 +1,171 @@
+#include "MountIndex.hpp"
+#include "MountPrewarmer.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <memory>
+
+using namespace uncopener;
+
+class MountPrewarmerTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    QString m_shell;
+    QTemporaryDir m_dir;
+
+    /// Run a shell script as mount command, with the target as $1
+    [[nodiscard]] std::unique_ptr<CommandBackend> stub(const QString& script) const
+    {
+        return std::make_unique<CommandBackend>(
+            m_shell, QStringList{"-c", script, "stub", CommandBackend::TARGET_PLACEHOLDER});
+    }
+
+    static UncPath unc(const QString& server, const QString& path)
+    {
+        UncPath result;
+        result.server = server;
+        result.path = path;
+        return result;
+    }
+
+private slots:
+    void initTestCase() { m_shell = QStandardPaths::findExecutable("sh"); }
+
+    void testTargetFor()
+    {
+        MountPrewarmer prewarmer(nullptr, R"(DOMAIN\me)");
+#ifdef Q_OS_WIN
+        QCOMPARE(prewarmer.targetFor(unc("server", "data")), R"(\\server\data)");
+#else
+        QCOMPARE(prewarmer.targetFor(unc("server", "data")), "smb://DOMAIN%5Cme@server/data");
+#endif
+    }
+
+    void testCommandFor()
+    {
+        Config config;
+        config.setPrewarmCommand("my-mount --quiet %u");
+        std::unique_ptr<CommandBackend> command = MountPrewarmer::commandFor(config);
+        QVERIFY(command != nullptr);
+        QCOMPARE(command->name(), "my-mount");
+        QCOMPARE(command->argumentsFor("smb://server/data"),
+                 QStringList({"--quiet", "smb://server/data"}));
+    }
+
+    void testDisabledWithoutCommand()
+    {
+        MountPrewarmer prewarmer(nullptr);
+        QVERIFY(!prewarmer.isEnabled());
+        QVERIFY(!prewarmer.request(unc("server", "data"), 0));
+        QCOMPARE(prewarmer.runningCount(), 0);
+    }
+
+    void testRequestWithoutShareDropped()
+    {
+        MountPrewarmer prewarmer(std::make_unique<CommandBackend>("true", QStringList{}));
+        QVERIFY(!prewarmer.request(unc("server", ""), 0));
+        QVERIFY(!prewarmer.request(unc("", "data"), 0));
+    }
+
+    void testMountsShareRoot()
+    {
+        if (m_shell.isEmpty())
+        {
+            QSKIP("sh not available");
+        }
+        QString expected = MountPrewarmer(nullptr, "me").targetFor(unc("server", "data"));
+        MountPrewarmer prewarmer(stub(QString(R"(test "$1" = "%1")").arg(expected)), "me");
+
+        QSignalSpy finished(&prewarmer, &MountPrewarmer::mountFinished);
+        QSignalSpy idle(&prewarmer, &MountPrewarmer::idle);
+        QVERIFY(prewarmer.request(unc("server", R"(data\folder\a.txt)"), 0));
+        QVERIFY(idle.wait(5000));
+        QCOMPARE(finished.count(), 1);
+        QCOMPARE(finished.at(0).at(0).toString(), expected);
+        QVERIFY(finished.at(0).at(1).toBool());
+    }
+
+    void testFailedMountReported()
+    {
+        if (m_shell.isEmpty())
+        {
+            QSKIP("sh not available");
+        }
+        MountPrewarmer prewarmer(stub("exit 2"));
+
+        QSignalSpy finished(&prewarmer, &MountPrewarmer::mountFinished);
+        QVERIFY(prewarmer.request(unc("server", "data"), 0));
+        QVERIFY(finished.wait(5000));
+        QVERIFY(!finished.at(0).at(1).toBool());
+    }
+
+    void testRequestedOncePerTtl()
+    {
+        if (m_shell.isEmpty())
+        {
+            QSKIP("sh not available");
+        }
+        MountPrewarmer prewarmer(stub("exit 0"), {}, MountPrewarmer::DEFAULT_MAX_CONCURRENT, 1000);
+
+        // Any path of the share counts, whether the mount succeeded or not
+        QSignalSpy idle(&prewarmer, &MountPrewarmer::idle);
+        QVERIFY(prewarmer.request(unc("server", R"(data\a.txt)"), 0));
+        QVERIFY(!prewarmer.request(unc("SERVER", R"(Data\b.txt)"), 999));
+        QVERIFY(prewarmer.request(unc("server", "other"), 999));
+        QVERIFY(prewarmer.request(unc("server", "data"), 1000));
+        QTRY_VERIFY_WITH_TIMEOUT(idle.count() > 0 && prewarmer.runningCount() == 0, 5000);
+    }
+
+    void testConcurrencyCap()
+    {
+        if (m_shell.isEmpty())
+        {
+            QSKIP("sh not available");
+        }
+        MountPrewarmer prewarmer(stub("sleep 0.2"), {}, 2);
+
+        QSignalSpy finished(&prewarmer, &MountPrewarmer::mountFinished);
+        QSignalSpy idle(&prewarmer, &MountPrewarmer::idle);
+        QCOMPARE(prewarmer.prewarm({{"server", "a", 3, 0}, {"server", "b", 2, 0},
+                                    {"server", "c", 1, 0}}),
+                 3);
+        QCOMPARE(prewarmer.runningCount(), 2);
+        QCOMPARE(prewarmer.pendingCount(), 1);
+
+        QVERIFY(idle.wait(5000));
+        QCOMPARE(finished.count(), 3);
+        QCOMPARE(idle.count(), 1);
+        QCOMPARE(prewarmer.runningCount(), 0);
+    }
+
+    void testMountedShareSkipped()
+    {
+        QVERIFY(m_dir.isValid());
+        QString mountInfoPath = m_dir.filePath("mountinfo");
+        QFile file(mountInfoPath);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write("40 22 0:40 / /mnt/data rw,relatime shared:20 - cifs //server/data rw\n");
+        file.close();
+
+        MountPrewarmer prewarmer(std::make_unique<CommandBackend>("true", QStringList{}));
+        prewarmer.setMountIndex(
+            std::make_shared<MountIndex>(mountInfoPath, m_dir.filePath("no-gvfs")));
+        QVERIFY(!prewarmer.request(unc("server", R"(data\a.txt)"), 0));
+        QCOMPARE(prewarmer.runningCount(), 0);
+    }
+};
+
+int runMountPrewarmerTests(int argc, char* argv[])
+{
+    MountPrewarmerTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "MountPrewarmerTests.moc"
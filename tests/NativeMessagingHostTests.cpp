@@ -0,0 +1,223 @@
+#include "NativeMessagingHost.hpp"
+
+#include <QBuffer>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QtEndian>
+
+using namespace uncopener;
+
+class NativeMessagingHostTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static Config testConfig()
+    {
+        Config config;
+        config.setSchemeName("uncopener");
+        config.setUncAllowList({R"(\\server\share)"});
+        return config;
+    }
+
+    /// Frame a message like the browser does
+    static QByteArray frame(const QByteArray& message)
+    {
+        char header[4] = {};
+        qToUnaligned(static_cast<quint32>(message.size()), header);
+        return QByteArray(header, 4) + message;
+    }
+
+    static QJsonObject parse(const QByteArray& message)
+    {
+        return QJsonDocument::fromJson(message).object();
+    }
+
+private slots:
+    void testValidateAllowedUrl()
+    {
+        NativeMessagingHost host(testConfig());
+        QJsonObject reply = host.handle(
+            R"({"id":7,"action":"validate","url":"uncopener://server/share/file.txt"})");
+
+        QCOMPARE(reply.value("success").toBool(), true);
+        QCOMPARE(reply.value("target").toString(), R"(\\server\share\file.txt)");
+        QCOMPARE(reply.value("id").toInt(), 7);
+    }
+
+    void testOpenRejectedUrlReportsReason()
+    {
+        NativeMessagingHost host(testConfig());
+        QJsonObject reply =
+            host.handle(R"({"id":"a","url":"uncopener://other/share/file.txt"})");
+
+        QCOMPARE(reply.value("success").toBool(), false);
+        QCOMPARE(reply.value("reason").toString(), "Path not in allow-list");
+        QVERIFY(!reply.value("remediation").toString().isEmpty());
+        QCOMPARE(reply.value("target").toString(), R"(\\other\share\file.txt)");
+        QCOMPARE(reply.value("id").toString(), "a");
+    }
+
+    void testPing()
+    {
+        NativeMessagingHost host(testConfig());
+        QJsonObject reply = host.handle(R"({"action":"ping"})");
+
+        QCOMPARE(reply.value("success").toBool(), true);
+        QVERIFY(reply.contains("version"));
+        QVERIFY(!reply.contains("id"));
+    }
+
+    void testPrewarmDisabled()
+    {
+        NativeMessagingHost host(testConfig());
+        QJsonObject reply =
+            host.handle(R"({"action":"prewarm","url":"uncopener://server/share/file.txt"})");
+
+        QCOMPARE(reply.value("success").toBool(), false);
+        QCOMPARE(reply.value("reason").toString(), "Prewarming is disabled");
+        QCOMPARE(reply.value("target").toString(), R"(\\server\share\file.txt)");
+    }
+
+    void testPrewarmRejectedUrl()
+    {
+        Config config = testConfig();
+        config.setPrewarm(true);
+        NativeMessagingHost host(config);
+        QJsonObject reply =
+            host.handle(R"({"action":"prewarm","url":"uncopener://other/share/file.txt"})");
+
+        QCOMPARE(reply.value("success").toBool(), false);
+        QCOMPARE(reply.value("reason").toString(), "Path not in allow-list");
+    }
+
+    void testPrewarmWithoutResidentInstance()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        Config config = testConfig();
+        config.setPrewarm(true);
+        NativeMessagingHost host(config);
+        host.setResidentServerName(dir.filePath("no-such-instance.sock"));
+        QJsonObject reply =
+            host.handle(R"({"action":"prewarm","url":"uncopener://server/share/file.txt"})");
+
+        QCOMPARE(reply.value("success").toBool(), false);
+        QCOMPARE(reply.value("reason").toString(), "No resident instance is running");
+    }
+
+    void testOpenerFollowsConfig()
+    {
+        NativeMessagingHost plain(testConfig());
+        QVERIFY(plain.opener().mountIndex() == nullptr);
+        QVERIFY(plain.opener().reachabilityProbe() == nullptr);
+
+        Config config = testConfig();
+        config.setPreferLocalMounts(true);
+        config.setProbeServers(true);
+        NativeMessagingHost host(config);
+#ifdef Q_OS_WIN
+        QVERIFY(host.opener().mountIndex() == nullptr);
+#else
+        QVERIFY(host.opener().mountIndex() != nullptr);
+#endif
+        QVERIFY(host.opener().reachabilityProbe() != nullptr);
+    }
+
+    void testInvalidRequests()
+    {
+        NativeMessagingHost host(testConfig());
+
+        QCOMPARE(host.handle("not json").value("success").toBool(), false);
+        QCOMPARE(host.handle("[1,2]").value("reason").toString(), "Invalid request");
+        QCOMPARE(host.handle({}).value("success").toBool(), false);
+
+        QJsonObject reply = host.handle(R"({"action":"delete","url":"uncopener://s/x"})");
+        QCOMPARE(reply.value("success").toBool(), false);
+        QVERIFY(reply.value("reason").toString().contains("delete"));
+    }
+
+    void testMessageFraming()
+    {
+        QBuffer buffer;
+        QVERIFY(buffer.open(QIODevice::ReadWrite));
+        QVERIFY(NativeMessagingHost::writeMessage(buffer, {{"success", true}}));
+
+        QByteArray data = buffer.data();
+        QCOMPARE(qFromUnaligned<quint32>(data.constData()), static_cast<quint32>(16));
+        QCOMPARE(data.mid(4), R"({"success":true})");
+
+        buffer.seek(0);
+        std::optional<QByteArray> message = NativeMessagingHost::readMessage(buffer);
+        QVERIFY(message.has_value());
+        QCOMPARE(*message, R"({"success":true})");
+        QVERIFY(!NativeMessagingHost::readMessage(buffer).has_value());
+    }
+
+    void testTruncatedMessageEndsInput()
+    {
+        QBuffer input;
+        input.setData(frame(R"({"action":"ping"})").left(10));
+        QVERIFY(input.open(QIODevice::ReadOnly));
+
+        QVERIFY(!NativeMessagingHost::readMessage(input).has_value());
+    }
+
+    void testServeAnswersEveryRequestInOrder()
+    {
+        QByteArray oversized(NativeMessagingHost::MAX_REQUEST_SIZE + 1, ' ');
+        QBuffer input;
+        input.setData(frame(R"({"id":1,"action":"ping"})") + frame(oversized) +
+                      frame(R"({"id":3,"action":"validate","url":"uncopener://server/share"})"));
+        QVERIFY(input.open(QIODevice::ReadOnly));
+        QBuffer output;
+        QVERIFY(output.open(QIODevice::ReadWrite));
+
+        NativeMessagingHost host(testConfig());
+        QCOMPARE(host.serve(input, output), 3);
+
+        output.seek(0);
+        QCOMPARE(parse(*NativeMessagingHost::readMessage(output)).value("id").toInt(), 1);
+
+        // The oversized request is skipped, and the stream stays in sync
+        QJsonObject skipped = parse(*NativeMessagingHost::readMessage(output));
+        QCOMPARE(skipped.value("success").toBool(), false);
+
+        QJsonObject third = parse(*NativeMessagingHost::readMessage(output));
+        QCOMPARE(third.value("id").toInt(), 3);
+        QCOMPARE(third.value("success").toBool(), true);
+    }
+
+    void testIsHostInvocation()
+    {
+        QVERIFY(NativeMessagingHost::isHostInvocation(
+            {"uncopener", "chrome-extension://abcdefghijklmnop/"}));
+        QVERIFY(NativeMessagingHost::isHostInvocation(
+            {"uncopener.exe", "chrome-extension://abcdefghijklmnop/", "--parent-window=0"}));
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QString manifest = dir.filePath("org.uncopener.json");
+        QFile file(manifest);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.close();
+        QVERIFY(NativeMessagingHost::isHostInvocation(
+            {"uncopener", manifest, "uncclickable@example.org"}));
+
+        QVERIFY(!NativeMessagingHost::isHostInvocation({"uncopener"}));
+        QVERIFY(!NativeMessagingHost::isHostInvocation({"uncopener", "uncopener://server/share"}));
+        QVERIFY(!NativeMessagingHost::isHostInvocation(
+            {"uncopener", "uncopener://server/a.json", "uncopener://server/b"}));
+        QVERIFY(!NativeMessagingHost::isHostInvocation(
+            {"uncopener", dir.filePath("missing.json"), "uncclickable@example.org"}));
+    }
+};
+
+int runNativeMessagingHostTests(int argc, char* argv[])
+{
+    NativeMessagingHostTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "NativeMessagingHostTests.moc"
@@ -0,0 +1,222 @@
+#include "OpenerBackend.hpp"
+#ifdef UNCOPENER_HAS_DBUS
+#include "FileManagerBackend.hpp"
+#endif
+
+#include <QStandardPaths>
+#include <QTest>
+
+#include <memory>
+
+using namespace uncopener;
+
+class OpenerBackendTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    QString m_shell;
+
+    /// Stub command: a shell running a script, with the target as $1
+    [[nodiscard]] std::unique_ptr<CommandBackend> stub(const QString& script) const
+    {
+        return std::make_unique<CommandBackend>(
+            m_shell, QStringList{"-c", script, "stub", CommandBackend::TARGET_PLACEHOLDER});
+    }
+
+private slots:
+    void initTestCase() { m_shell = QStandardPaths::findExecutable("sh"); }
+
+    void testTargetAppended()
+    {
+        CommandBackend backend("gio", {"open"});
+        QCOMPARE(backend.argumentsFor("smb://server/share"),
+                 (QStringList{"open", "smb://server/share"}));
+    }
+
+    void testTargetReplacesPlaceholder()
+    {
+        auto backend = CommandBackend::fromCommandLine(R"("my opener" --new-window %u --quiet)");
+        QVERIFY(backend != nullptr);
+        QCOMPARE(backend->name(), "my opener");
+        QCOMPARE(backend->argumentsFor("smb://server/share"),
+                 (QStringList{"--new-window", "smb://server/share", "--quiet"}));
+    }
+
+    void testEmptyCommandFallsBack()
+    {
+        QVERIFY(CommandBackend::fromCommandLine("  ") == nullptr);
+
+        Config config;
+        config.setOpener(OpenerKind::Command);
+        QCOMPARE(OpenerBackend::create(config)->name(), DesktopServicesBackend().name());
+
+        config.setOpenerCommand("nautilus %u");
+        QCOMPARE(OpenerBackend::create(config)->name(), "nautilus");
+    }
+
+    void testStubSuccessRecorded()
+    {
+        if (m_shell.isEmpty())
+        {
+            QSKIP("sh not available");
+        }
+        std::unique_ptr<CommandBackend> backend = stub(R"(test "$1" = smb://server/share)");
+        OpenResult result = backend->open("smb://server/share");
+
+        QVERIFY(result.success);
+        OpenOutcome outcome = backend->lastOutcome();
+        QCOMPARE(outcome.targetUrl, "smb://server/share");
+        QCOMPARE(outcome.exitStatus, 0);
+        QVERIFY(outcome.spawnLatencyUs <= outcome.totalLatencyUs);
+        QCOMPARE(backend->stats().attempts, 1);
+        QCOMPARE(backend->stats().failures, 0);
+    }
+
+    void testStubExitStatusReported()
+    {
+        if (m_shell.isEmpty())
+        {
+            QSKIP("sh not available");
+        }
+        std::unique_ptr<CommandBackend> backend = stub("exit 3");
+        OpenResult result = backend->open("smb://server/share");
+
+        QVERIFY(!result.success);
+        QVERIFY(result.errorReason.contains("exit status 3"));
+        QCOMPARE(backend->lastOutcome().exitStatus, 3);
+        QCOMPARE(backend->stats().failures, 1);
+    }
+
+    void testRevealOpensEachTargetWithoutSelection()
+    {
+        if (m_shell.isEmpty())
+        {
+            QSKIP("sh not available");
+        }
+        std::unique_ptr<CommandBackend> backend = stub(R"(test "$1" != smb://server/share/b)");
+
+        // One attempt that stops at the first target that fails
+        OpenResult result = backend->reveal(
+            {"smb://server/share/a", "smb://server/share/b", "smb://server/share/c"});
+        QVERIFY(!result.success);
+        QCOMPARE(backend->lastOutcome().targetUrl, "smb://server/share/a");
+        QCOMPARE(backend->lastOutcome().exitStatus, 1);
+        QCOMPARE(backend->stats().attempts, 1);
+        QCOMPARE(backend->stats().failures, 1);
+    }
+
+    void testCreateRevealer()
+    {
+        Config config;
+        QVERIFY(OpenerBackend::createRevealer(config) == nullptr);
+
+        config.setRevealFiletypes({".pdf"});
+#ifdef UNCOPENER_HAS_DBUS
+        QCOMPARE(OpenerBackend::createRevealer(config)->name(), "file manager");
+#else
+        QVERIFY(OpenerBackend::createRevealer(config) == nullptr);
+#endif
+    }
+
+    void testStubKilledBySignal()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("No signals on Windows");
+#else
+        if (m_shell.isEmpty())
+        {
+            QSKIP("sh not available");
+        }
+        std::unique_ptr<CommandBackend> backend = stub("kill -9 $$");
+        QVERIFY(!backend->open("smb://server/share").success);
+        QCOMPARE(backend->lastOutcome().exitStatus, OpenerBackend::EXIT_CRASHED);
+#endif
+    }
+
+    void testStubLatencyCoversRuntime()
+    {
+        if (m_shell.isEmpty())
+        {
+            QSKIP("sh not available");
+        }
+        std::unique_ptr<CommandBackend> backend = stub("sleep 0.2");
+        QVERIFY(backend->open("smb://server/share").success);
+
+        OpenOutcome outcome = backend->lastOutcome();
+        QVERIFY(outcome.totalLatencyUs >= 200000);
+        QVERIFY(outcome.spawnLatencyUs < outcome.totalLatencyUs);
+        QCOMPARE(backend->stats().maxSpawnLatencyUs, outcome.spawnLatencyUs);
+    }
+
+    void testLongRunningHelperIsNotAwaited()
+    {
+        if (m_shell.isEmpty())
+        {
+            QSKIP("sh not available");
+        }
+        // Like xdg-open waiting for the viewer to close
+        std::unique_ptr<CommandBackend> backend = stub("sleep 2");
+        backend->setExitWait(100);
+        QVERIFY(backend->open("smb://server/share").success);
+
+        OpenOutcome outcome = backend->lastOutcome();
+        QCOMPARE(outcome.exitStatus, OpenerBackend::EXIT_RUNNING);
+        QVERIFY(outcome.totalLatencyUs < 1000000);
+    }
+
+    void testMissingProgram()
+    {
+        CommandBackend backend("uncopener-no-such-program", {});
+        QVERIFY(!backend.open("smb://server/share").success);
+
+        // Some C libraries report the failed exec as exit status 127 of the child
+        int exitStatus = backend.lastOutcome().exitStatus;
+        QVERIFY(exitStatus == OpenerBackend::EXIT_NOT_STARTED || exitStatus == 127);
+    }
+
+    void testStubBehindPathOpener()
+    {
+        if (m_shell.isEmpty())
+        {
+            QSKIP("sh not available");
+        }
+        Config config;
+        config.setUncAllowList({R"(\\server\share)"});
+
+        PathOpener opener(config);
+        std::shared_ptr<CommandBackend> backend = stub("exit 2");
+        opener.setBackend(backend);
+
+        OpenResult result = opener.open("uncopener://server/share/file.txt");
+        QVERIFY(!result.success);
+        QVERIFY(result.errorReason.contains("exit status 2"));
+        QCOMPARE(backend->lastOutcome().targetUrl,
+                 opener.evaluate("uncopener://server/share/file.txt").targetUrl);
+    }
+
+#ifdef UNCOPENER_HAS_DBUS
+    void testFileManagerWithoutBus()
+    {
+        FileManagerBackend backend(QDBusConnection("uncopener-not-connected"));
+        QVERIFY(!backend.open("smb://server/share/").success);
+        QCOMPARE(backend.lastOutcome().exitStatus, OpenerBackend::EXIT_NOT_STARTED);
+    }
+
+    void testFileManagerRevealWithoutBus()
+    {
+        FileManagerBackend backend(QDBusConnection("uncopener-not-connected"));
+        QVERIFY(!backend.reveal({"smb://server/share/a.pdf", "smb://server/share/b.pdf"}).success);
+        QCOMPARE(backend.lastOutcome().targetUrl, "smb://server/share/a.pdf");
+        QCOMPARE(backend.stats().attempts, 1);
+    }
+#endif
+};
+
+int runOpenerBackendTests(int argc, char* argv[])
+{
+    OpenerBackendTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "OpenerBackendTests.moc"
@@ -1,6 +1,12 @@
+#include "OpenerBackend.hpp"
 #include "PathOpener.hpp"
 
 #include <QTest>
+#include <QThread>
+
+#include <atomic>
+#include <memory>
+#include <vector>
 
 using namespace uncopener;
 
@@ -16,7 +22,7 @@ private slots:
         config.setUncAllowList({R"(\\server\share)"});
 
         PathOpener opener(config);
-        OpenResult result = opener.validate("uncopener://server/share/file.txt");
+        OpenResult result = opener.evaluate("uncopener://server/share/file.txt").toOpenResult();
 
         QVERIFY(result.success);
         QVERIFY(result.errorReason.isEmpty());
@@ -29,7 +35,7 @@ private slots:
         config.setUncAllowList({R"(\\server\share)"});
 
         PathOpener opener(config);
-        OpenResult result = opener.validate("invalid-url");
+        OpenResult result = opener.evaluate("invalid-url").toOpenResult();
 
         QVERIFY(!result.success);
         QVERIFY(!result.errorReason.isEmpty());
@@ -42,7 +48,7 @@ private slots:
         config.setUncAllowList({R"(\\allowed\share)"});
 
         PathOpener opener(config);
-        OpenResult result = opener.validate("uncopener://notallowed/share/file.txt");
+        OpenResult result = opener.evaluate("uncopener://notallowed/share/file.txt").toOpenResult();
 
         QVERIFY(!result.success);
         QVERIFY(result.errorReason.contains("allow"));
@@ -57,7 +63,7 @@ private slots:
         config.setFiletypeBlacklist({".exe"});
 
         PathOpener opener(config);
-        OpenResult result = opener.validate("uncopener://server/share/malware.exe");
+        OpenResult result = opener.evaluate("uncopener://server/share/malware.exe").toOpenResult();
 
         QVERIFY(!result.success);
         QVERIFY(result.errorReason.contains("blacklist"));
@@ -73,9 +79,9 @@ private slots:
 
         PathOpener opener(config);
 
-        QVERIFY(opener.validate("uncopener://server/share/doc.txt").success);
-        QVERIFY(opener.validate("uncopener://server/share/doc.pdf").success);
-        QVERIFY(!opener.validate("uncopener://server/share/doc.exe").success);
+        QVERIFY(opener.evaluate("uncopener://server/share/doc.txt").allowed());
+        QVERIFY(opener.evaluate("uncopener://server/share/doc.pdf").allowed());
+        QVERIFY(!opener.evaluate("uncopener://server/share/doc.exe").allowed());
     }
 
     void testGetTargetPathWindows()
@@ -85,7 +91,7 @@ private slots:
         config.setUncAllowList({R"(\\server\share)"});
 
         PathOpener opener(config);
-        QString target = opener.getTargetPath("uncopener://server/share/path/file.txt");
+        QString target = opener.evaluate("uncopener://server/share/path/file.txt").targetUrl;
 
 #ifdef Q_OS_WIN
         QCOMPARE(target, R"(\\server\share\path\file.txt)");
@@ -102,7 +108,7 @@ private slots:
         config.setSmbUsername("testuser");
 
         PathOpener opener(config);
-        QString target = opener.getTargetPath("uncopener://server/share/file.txt");
+        QString target = opener.evaluate("uncopener://server/share/file.txt").targetUrl;
 
 #ifdef Q_OS_WIN
         // Windows doesn't use username in path
@@ -120,7 +126,7 @@ private slots:
         config.setSmbUsername(R"(DOMAIN\user)");
 
         PathOpener opener(config);
-        QString target = opener.getTargetPath("uncopener://server/share/file.txt");
+        QString target = opener.evaluate("uncopener://server/share/file.txt").targetUrl;
 
 #ifndef Q_OS_WIN
         // Linux should percent-encode the backslash
@@ -136,8 +142,8 @@ private slots:
 
         PathOpener opener(config);
 
-        QString withSlash = opener.getTargetPath("uncopener://server/share/folder/");
-        QString withoutSlash = opener.getTargetPath("uncopener://server/share/folder");
+        QString withSlash = opener.evaluate("uncopener://server/share/folder/").targetUrl;
+        QString withoutSlash = opener.evaluate("uncopener://server/share/folder").targetUrl;
 
 #ifdef Q_OS_WIN
         QVERIFY(withSlash.endsWith('\\'));
@@ -155,7 +161,7 @@ private slots:
         config.setUncAllowList({R"(\\server\share)"});
 
         PathOpener opener(config);
-        QString target = opener.getTargetPath("invalid-url");
+        QString target = opener.evaluate("invalid-url").targetUrl;
 
         QVERIFY(target.isEmpty());
     }
@@ -167,10 +173,10 @@ private slots:
         config.setUncAllowList({R"(\\server\share)"});
 
         PathOpener opener(config);
-        auto result = opener.validate("uncopener://server/share/path/file.txt");
-        QVERIFY(result.success);
+        ValidationResult result = opener.evaluate("uncopener://server/share/path/file.txt");
+        QVERIFY(result.allowed());
 
-        const UncPath& path = opener.lastParsedPath();
+        UncPath path = result.path();
         QCOMPARE(path.server, "server");
         QCOMPARE(path.path, R"(share\path\file.txt)");
     }
@@ -182,11 +188,140 @@ private slots:
         config.setUncAllowList({R"(\\server\share)"});
 
         PathOpener opener(config);
-        OpenResult result = opener.validate("uncopener://server/share/../other/file.txt");
+        OpenResult result =
+            opener.evaluate("uncopener://server/share/../other/file.txt").toOpenResult();
 
         QVERIFY(!result.success);
         QVERIFY(result.errorReason.contains("traversal"));
     }
+
+    void testEvaluateAllowed()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\server\share)"});
+
+        PathOpener opener(config);
+        ValidationResult result = opener.evaluate("uncopener://server/share/file.txt");
+
+        QVERIFY(result.allowed());
+        QVERIFY(result.toOpenResult().success);
+        QCOMPARE(result.path().server, "server");
+        QCOMPARE(result.displayPath(), R"(\\server\share\file.txt)");
+        QCOMPARE(result.targetUrl, opener.buildTargetUrl(result.path()));
+    }
+
+    void testEvaluateReveal()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\server\share)"});
+        config.setRevealFiletypes({"pdf", ".tar.gz"});
+
+        PathOpener opener(config);
+        QVERIFY(opener.evaluate("uncopener://server/share/a/Report.PDF").reveal);
+        QVERIFY(opener.evaluate("uncopener://server/share/backup.tar.gz").reveal);
+        QVERIFY(!opener.evaluate("uncopener://server/share/a/notes.txt").reveal);
+        QVERIFY(!opener.evaluate("uncopener://server/share/pdf/").reveal);
+        QVERIFY(!opener.evaluate("uncopener://other/share/a.pdf").reveal);
+    }
+
+    void testEvaluateParseError()
+    {
+        PathOpener opener{Config()};
+        ValidationResult result = opener.evaluate("invalid-url");
+
+        QVERIFY(isError(result.parse));
+        QVERIFY(!result.allowed());
+        QVERIFY(result.path().server.isEmpty());
+        QCOMPARE(result.displayPath(), "invalid-url");
+        QVERIFY(result.targetUrl.isEmpty());
+        QCOMPARE(result.toOpenResult().errorReason, getError(result.parse).reason);
+    }
+
+    void testEvaluatePolicyDenied()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\server\share)"});
+
+        PathOpener opener(config);
+        ValidationResult result = opener.evaluate("uncopener://other/share/file.txt");
+
+        QVERIFY(isSuccess(result.parse));
+        QVERIFY(!result.policy.allowed);
+        QVERIFY(!result.allowed());
+        QVERIFY(result.targetUrl.isEmpty());
+        QCOMPARE(result.toOpenResult().errorReason, result.policy.reason);
+        QCOMPARE(result.toOpenResult().errorReason,
+                 opener.evaluate("uncopener://other/share/file.txt").toOpenResult().errorReason);
+    }
+
+    void testFromConfigFollowsConfig()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\server\share)"});
+
+        // What the handler opens a clicked URL with
+        PathOpener plain = PathOpener::fromConfig(config);
+        QVERIFY(plain.backend() != nullptr);
+        QVERIFY(plain.mountIndex() == nullptr);
+        QVERIFY(plain.reachabilityProbe() == nullptr);
+        QVERIFY(plain.shareHistory() == nullptr);
+
+        config.setOpener(OpenerKind::Command);
+        config.setOpenerCommand("opener --new-window");
+        config.setPreferLocalMounts(true);
+        config.setProbeServers(true);
+        PathOpener opener = PathOpener::fromConfig(config);
+        QVERIFY(dynamic_cast<CommandBackend*>(opener.backend().get()) != nullptr);
+#ifdef Q_OS_WIN
+        QVERIFY(opener.mountIndex() == nullptr);
+#else
+        QVERIFY(opener.mountIndex() != nullptr);
+#endif
+        QVERIFY(opener.reachabilityProbe() != nullptr);
+        QVERIFY(opener.evaluate("uncopener://server/share/a.txt").allowed());
+    }
+
+    void testEvaluateConcurrently()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\server\share)"});
+        config.setFiletypeMode(FiletypeMode::Blacklist);
+        config.setFiletypeBlacklist({".exe"});
+
+        const PathOpener opener(config);
+        const QString allowedUrl = "uncopener://server/share/file.txt";
+        const QString deniedUrl = "uncopener://server/share/setup.exe";
+        const QString expectedTarget = opener.evaluate(allowedUrl).targetUrl;
+
+        constexpr int threadCount = 4;
+        constexpr int iterations = 2000;
+        std::atomic<int> mismatches{0};
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back(QThread::create(
+                [&]()
+                {
+                    for (int j = 0; j < iterations; ++j)
+                    {
+                        ValidationResult allowed = opener.evaluate(allowedUrl);
+                        ValidationResult denied = opener.evaluate(deniedUrl);
+                        if (!allowed.allowed() || allowed.targetUrl != expectedTarget ||
+                            denied.allowed() || !denied.targetUrl.isEmpty())
+                        {
+                            ++mismatches;
+                        }
+                    }
+                }));
+            threads.back()->start();
+        }
+        for (const auto& thread : threads)
+        {
+            QVERIFY(thread->wait());
+        }
+
+        QCOMPARE(mismatches.load(), 0);
+    }
 };
 
 int runPathOpenerTests(int argc, char* argv[])
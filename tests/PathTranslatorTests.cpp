@@ -0,0 +1,181 @@
+#include "MountIndex.hpp"
+#include "PathOpener.hpp"
+#include "PathTranslator.hpp"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <memory>
+
+using namespace uncopener;
+
+class PathTranslatorTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static UncPath unc(const QString& server, const QString& path, bool trailingSlash = false)
+    {
+        UncPath result;
+        result.server = server;
+        result.path = path;
+        result.hasTrailingSlash = trailingSlash;
+        return result;
+    }
+
+    static PathTranslator translator()
+    {
+        PathTranslator result;
+        static_cast<void>(result.setRules({
+            {R"(\\fs01\projects)", "/mnt/projects"},
+            {R"(\\fs01\projects\archive\)", "/srv/archive/"},
+            {R"(\\fs02)", "/mnt/fs02"},
+        }));
+        return result;
+    }
+
+private slots:
+    void testNormalizeRule()
+    {
+        PathTranslation rule =
+            PathTranslator::normalizeRule({R"( fs01\projects\ )", " /mnt/projects/ "});
+        QCOMPARE(rule.uncPrefix, R"(\\fs01\projects)");
+        QCOMPARE(rule.localPath, "/mnt/projects");
+        QCOMPARE(PathTranslator::normalizeRule({R"(\\fs01)", "/"}).localPath, "/");
+    }
+
+    void testInvalidRulesRejected()
+    {
+        PathTranslator translator;
+        QList<PathTranslation> rejected = translator.setRules({
+            {"//fs01/projects", "/mnt/projects"},
+            {R"(\\fs01\data)", "  "},
+            {R"(\\fs01\ok)", "/mnt/ok"},
+            {R"(\\FS01\OK)", "/mnt/other"},
+        });
+        QCOMPARE(rejected.size(), 2);
+        QCOMPARE(translator.rules().size(), 1);
+        QCOMPARE(translator.rules().at(0).localPath, "/mnt/ok");
+    }
+
+    void testLongestPrefixWins()
+    {
+        PathTranslator t = translator();
+        QCOMPARE(t.localPath(unc("fs01", R"(projects\a\b.txt)")), "/mnt/projects/a/b.txt");
+        QCOMPARE(t.localPath(unc("fs01", R"(projects\archive\2020\c.txt)")),
+                 "/srv/archive/2020/c.txt");
+        QCOMPARE(t.localPath(unc("fs02", R"(any\share)")), "/mnt/fs02/any/share");
+    }
+
+    void testWholeSegmentsOnly()
+    {
+        PathTranslator t = translator();
+        QVERIFY(t.localPath(unc("fs01", R"(projects2\a.txt)")).isEmpty());
+        QVERIFY(t.localPath(unc("fs01", "other")).isEmpty());
+        QVERIFY(t.localPath(unc("fs03", "projects")).isEmpty());
+        QCOMPARE(t.matchIndex(unc("fs01", R"(projects\archived)")), 0);
+    }
+
+    void testCaseInsensitiveAndTrailingSlash()
+    {
+        PathTranslator t = translator();
+        QCOMPARE(t.localPath(unc("FS01", R"(Projects\Docs)", true)), "/mnt/projects/Docs/");
+        QCOMPARE(t.localPath(unc("fs01", "projects")), "/mnt/projects");
+        QCOMPARE(t.localPath(unc("fs01", "projects", true)), "/mnt/projects/");
+    }
+
+    void testManyRules()
+    {
+        QList<PathTranslation> rules;
+        for (int i = 0; i < 1000; ++i)
+        {
+            rules.append({QString(R"(\\fs%1\share)").arg(i), QString("/mnt/fs%1").arg(i)});
+        }
+        PathTranslator t;
+        QVERIFY(t.setRules(rules).isEmpty());
+        QCOMPARE(t.localPath(unc("fs999", R"(share\x)")), "/mnt/fs999/x");
+        QCOMPARE(t.localPath(unc("fs0", "share")), "/mnt/fs0");
+    }
+
+    void testPathOpenerUsesTranslation()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\fs01)"});
+        config.setPathTranslations({{R"(\\fs01\projects)", "/mnt/projects"}});
+        PathOpener opener(config);
+
+        ValidationResult translated = opener.evaluate("uncopener://fs01/projects/a.txt");
+        QVERIFY(translated.allowed());
+        QCOMPARE(translated.translation, R"(\\fs01\projects)");
+        QCOMPARE(translated.targetUrl, PathOpener::buildLocalTarget("/mnt/projects/a.txt"));
+
+        ValidationResult plain = opener.evaluate("uncopener://fs01/other/a.txt");
+        QVERIFY(plain.translation.isEmpty());
+        QCOMPARE(plain.targetUrl, opener.buildTargetUrl(plain.path()));
+
+        // The allow-list is checked on the UNC path before translating
+        ValidationResult denied = opener.evaluate("uncopener://fs02/projects/a.txt");
+        QVERIFY(!denied.allowed());
+        QVERIFY(denied.targetUrl.isEmpty());
+    }
+
+    void testEncodedTraversalNotTranslated()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\fs01)"});
+        config.setPathTranslations({{R"(\\fs01\projects)", "/mnt/projects"}});
+        PathOpener opener(config);
+
+        // %2E%2E and %2F decode to ".." and '/', which must not reach the local path
+        const QStringList urls = {"uncopener://fs01/projects/%2E%2E/%2E%2E/etc/passwd",
+                                  "uncopener://fs01/projects/a%2F..%2F..%2F..%2Fetc/passwd",
+                                  "uncopener://fs01/projects%2F..%2F..%2Fetc/passwd",
+                                  "uncopener://fs01/projects/a%2Fb.txt"};
+        for (const QString& url : urls)
+        {
+            ValidationResult result = opener.evaluate(url);
+            QVERIFY2(!result.allowed(), qPrintable(url));
+            QVERIFY(result.targetUrl.isEmpty());
+        }
+
+        // The translator refuses such paths on its own as well
+        PathTranslator t = translator();
+        QVERIFY(t.localPath(unc("fs01", R"(projects\..\..\etc\passwd)")).isEmpty());
+        QVERIFY(t.localPath(unc("fs01", "projects/a/../../../etc")).isEmpty());
+        QVERIFY(t.localPath(unc("fs02", R"(share\.\x)")).isEmpty());
+        QCOMPARE(t.localPath(unc("fs01", R"(projects\..x)")), "/mnt/projects/..x");
+    }
+
+    void testTranslationWinsOverMount()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("Local mounts are only used on Linux");
+#endif
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QFile mountInfo(dir.filePath("mountinfo"));
+        QVERIFY(mountInfo.open(QIODevice::WriteOnly));
+        mountInfo.write("40 22 0:40 / /mnt/cifs rw - cifs //fs01/projects rw\n");
+        mountInfo.close();
+
+        Config config;
+        config.setPathTranslations({{R"(\\fs01\projects\fixed)", "/mnt/fixed"}});
+        PathOpener opener(config);
+        opener.setMountIndex(std::make_shared<MountIndex>(mountInfo.fileName(), QString()));
+
+        ValidationResult fixed = opener.evaluate("uncopener://fs01/projects/fixed/a.txt");
+        QCOMPARE(opener.resolveTarget(fixed), fixed.targetUrl);
+
+        ValidationResult mounted = opener.evaluate("uncopener://fs01/projects/b.txt");
+        QCOMPARE(opener.resolveTarget(mounted), PathOpener::buildLocalTarget("/mnt/cifs/b.txt"));
+    }
+};
+
+int runPathTranslatorTests(int argc, char* argv[])
+{
+    PathTranslatorTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "PathTranslatorTests.moc"
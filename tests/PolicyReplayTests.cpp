@@ -0,0 +1,126 @@
+#include "PolicyReplay.hpp"
+
+#include <QBuffer>
+#include <QTest>
+
+using namespace uncopener;
+
+class PolicyReplayTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static Config beforeConfig()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\server\share)"});
+        return config;
+    }
+
+    static Config afterConfig()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\server\share\public)", R"(\\other)"});
+        return config;
+    }
+
+    static QByteArray runReplay(const QByteArray& lines, DecisionFilter::Format format,
+                                int threadCount, ReplayStats& stats)
+    {
+        QBuffer input;
+        input.setData(lines);
+        QBuffer output;
+        if (!input.open(QIODevice::ReadOnly) || !output.open(QIODevice::WriteOnly))
+        {
+            return {};
+        }
+        PolicyReplay replay(beforeConfig(), afterConfig(), threadCount);
+        stats = replay.run(input, output, format);
+        return output.data();
+    }
+
+private slots:
+    void testReportsOnlyChangedVerdicts()
+    {
+        ReplayStats stats;
+        QByteArray output = runReplay("uncopener://server/share/public/a.txt\n"
+                                      "uncopener://server/share/private/b.txt\n"
+                                      "uncopener://other/share/c.txt\n"
+                                      "uncopener://third/share/d.txt\n",
+                                      DecisionFilter::Format::Tsv, 2, stats);
+
+        QCOMPARE(stats.lineCount, 4);
+        QCOMPARE(stats.changedCount, 2);
+        QList<QByteArray> lines = output.split('\n');
+        QCOMPARE(lines.size(), 3);
+        QCOMPARE(lines.at(0), "2\tuncopener://server/share/private/b.txt\t"
+                              "\\\\server\\share\\private\\b.txt\t"
+                              "allow\t\t\\\\server\\share\t"
+                              "deny\tnot-in-allow-list\t");
+        QCOMPARE(lines.at(1), "3\tuncopener://other/share/c.txt\t\\\\other\\share\\c.txt\t"
+                              "deny\tnot-in-allow-list\t\t"
+                              "allow\t\t\\\\other");
+    }
+
+    void testJsonLine()
+    {
+        ReplayStats stats;
+        QByteArray output = runReplay("uncopener://other/x\n", DecisionFilter::Format::Json, 1,
+                                      stats);
+
+        QCOMPARE(output, R"({"line":1,"url":"uncopener://other/x","target":"\\\\other\\x",)"
+                         R"("before":{"verdict":"deny","reason":"not-in-allow-list","rule":""},)"
+                         R"("after":{"verdict":"allow","reason":"","rule":"\\\\other"}})"
+                         "\n");
+    }
+
+    void testKeepsInputOrderAcrossBatchesAndThreads()
+    {
+        // Every third line changes verdict; spans several batches
+        const qsizetype lineCount = PolicyReplay::BATCH_LINES * 2 + 100;
+        QByteArray lines;
+        for (qsizetype i = 0; i < lineCount; ++i)
+        {
+            lines += i % 3 == 0 ? "uncopener://other/x\n" : "uncopener://server/share/public/\n";
+        }
+
+        ReplayStats stats;
+        QByteArray output = runReplay(lines, DecisionFilter::Format::Tsv, 4, stats);
+
+        QCOMPARE(stats.lineCount, lineCount);
+        QCOMPARE(stats.changedCount, (lineCount + 2) / 3);
+
+        QList<QByteArray> changed = output.split('\n');
+        changed.removeLast();
+        QCOMPARE(changed.size(), stats.changedCount);
+        for (qsizetype i = 0; i < changed.size(); ++i)
+        {
+            const QByteArray& line = changed.at(i);
+            QCOMPARE(line.left(line.indexOf('\t')), QByteArray::number(i * 3 + 1));
+        }
+    }
+
+    void testEmptyInput()
+    {
+        ReplayStats stats;
+        QByteArray output = runReplay({}, DecisionFilter::Format::Json, 0, stats);
+
+        QVERIFY(output.isEmpty());
+        QCOMPARE(stats.lineCount, 0);
+        QCOMPARE(stats.changedCount, 0);
+    }
+
+    void testDefaultThreadCount()
+    {
+        PolicyReplay replay(beforeConfig(), afterConfig());
+        QVERIFY(replay.threadCount() >= 1);
+    }
+};
+
+int runPolicyReplayTests(int argc, char* argv[])
+{
+    PolicyReplayTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "PolicyReplayTests.moc"
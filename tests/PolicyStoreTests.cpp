@@ -0,0 +1,162 @@
+#include "PathOpener.hpp"
+#include "PolicyStore.hpp"
+
+#include <QSemaphore>
+#include <QTest>
+#include <QThread>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace uncopener;
+
+class PolicyStoreTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static Config configFor(const QString& share)
+    {
+        Config config;
+        config.setUncAllowList({share});
+        return config;
+    }
+
+    static bool allows(const std::shared_ptr<const CompiledPolicy>& policy, const QString& url)
+    {
+        return PathOpener(policy).evaluate(url).allowed();
+    }
+
+private slots:
+    void testCompileKeepsConfig()
+    {
+        Config config = configFor(R"(\\server\share)");
+        config.setSmbUsername("user");
+
+        auto policy = CompiledPolicy::compile(config, 7);
+        QCOMPARE(policy->generation(), 7);
+        QCOMPARE(policy->config().smbUsername(), "user");
+        QCOMPARE(policy->parser().schemeName(), config.schemeName());
+        QCOMPARE(policy->policy().uncAllowList().entries(), QStringList{R"(\\server\share)"});
+    }
+
+    void testOpenersShareSnapshot()
+    {
+        auto policy = CompiledPolicy::compile(configFor(R"(\\server\share)"));
+        PathOpener first(policy);
+        PathOpener second(policy);
+
+        QCOMPARE(first.policy().get(), second.policy().get());
+        QVERIFY(first.evaluate("uncopener://server/share/a.txt").allowed());
+        QVERIFY(!second.evaluate("uncopener://other/share/a.txt").allowed());
+    }
+
+    void testInitialGeneration()
+    {
+        PolicyStore store(configFor(R"(\\server\share)"));
+        QCOMPARE(store.generation(), 1);
+        QVERIFY(allows(store.snapshot(), "uncopener://server/share/a.txt"));
+    }
+
+    void testReloadPublishesNewSnapshot()
+    {
+        PolicyStore store(configFor(R"(\\server\share)"));
+        auto before = store.snapshot();
+
+        QCOMPARE(store.reload(configFor(R"(\\other\share)")), 2);
+        auto after = store.snapshot();
+
+        QCOMPARE(after->generation(), 2);
+        QVERIFY(allows(after, "uncopener://other/share/a.txt"));
+        QVERIFY(!allows(after, "uncopener://server/share/a.txt"));
+
+        // Readers holding the previous snapshot keep their policy
+        QCOMPARE(before->generation(), 1);
+        QVERIFY(allows(before, "uncopener://server/share/a.txt"));
+    }
+
+    void testReloadInBackground()
+    {
+        PolicyStore store(configFor(R"(\\server\share)"));
+
+        QFuture<quint64> future = store.reloadInBackground(configFor(R"(\\other\share)"));
+        future.waitForFinished();
+
+        QCOMPARE(future.result(), 2);
+        QCOMPARE(store.generation(), 2);
+        QVERIFY(allows(store.snapshot(), "uncopener://other/share/a.txt"));
+    }
+
+    void testOlderReloadDoesNotReplaceNewer()
+    {
+        PolicyStore store(configFor(R"(\\first\share)"));
+
+        // Hold the only pool thread so the background reload finishes after the newer one
+        QThreadPool pool;
+        pool.setMaxThreadCount(1);
+        QSemaphore release;
+        pool.start([&release]() { release.acquire(); });
+
+        QFuture<quint64> older = store.reloadInBackground(configFor(R"(\\older\share)"), &pool);
+        quint64 newer = store.reload(configFor(R"(\\newer\share)"));
+
+        release.release();
+        older.waitForFinished();
+
+        QCOMPARE(store.generation(), newer);
+        QVERIFY(allows(store.snapshot(), "uncopener://newer/share/a.txt"));
+        QVERIFY(!allows(store.snapshot(), "uncopener://older/share/a.txt"));
+    }
+
+    void testReadersDuringReloads()
+    {
+        PolicyStore store(configFor(R"(\\server\share)"));
+        std::atomic<bool> stop{false};
+        std::atomic<int> inconsistent{0};
+
+        // Every snapshot allows exactly the share of its own config
+        auto read = [&store, &stop, &inconsistent]()
+        {
+            while (!stop.load())
+            {
+                auto policy = store.snapshot();
+                bool server = allows(policy, "uncopener://server/share/a.txt");
+                bool other = allows(policy, "uncopener://other/share/a.txt");
+                if (server == other)
+                {
+                    ++inconsistent;
+                }
+            }
+        };
+
+        std::vector<std::unique_ptr<QThread>> readers;
+        for (int i = 0; i < 4; ++i)
+        {
+            readers.emplace_back(QThread::create(read));
+            readers.back()->start();
+        }
+
+        for (int i = 0; i < 200; ++i)
+        {
+            store.reload(configFor(i % 2 == 0 ? R"(\\other\share)" : R"(\\server\share)"));
+        }
+
+        stop.store(true);
+        for (const auto& reader : readers)
+        {
+            QVERIFY(reader->wait(5000));
+        }
+
+        QCOMPARE(inconsistent.load(), 0);
+        QCOMPARE(store.generation(), 201);
+    }
+};
+
+int runPolicyStoreTests(int argc, char* argv[])
+{
+    PolicyStoreTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "PolicyStoreTests.moc"
@@ -0,0 +1,207 @@
+#include "AsyncOpener.hpp"
+#include "PathOpener.hpp"
+#include "ReachabilityProbe.hpp"
+
+#include <QAtomicInt>
+#include <QTcpServer>
+#include <QTest>
+
+#include <memory>
+
+using namespace uncopener;
+
+namespace
+{
+
+constexpr int PROBE_TIMEOUT_MS = 2000;
+constexpr int TTL_MS = 1000;
+constexpr int THRESHOLD = 2;
+constexpr int COOLDOWN_MS = 5000;
+
+/// Get a port nothing listens on, so connecting to it is refused at once
+quint16 closedPort()
+{
+    QTcpServer server;
+    if (!server.listen(QHostAddress::Any))
+    {
+        return 0;
+    }
+    quint16 port = server.serverPort();
+    server.close();
+    return port;
+}
+
+} // namespace
+
+/// A local TCP listener stands in for the file server
+class ReachabilityProbeTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testReachableServerIsCached()
+    {
+        QTcpServer server;
+        QVERIFY(server.listen(QHostAddress::Any));
+        ReachabilityProbe probe(PROBE_TIMEOUT_MS, server.serverPort(), TTL_MS, THRESHOLD,
+                                COOLDOWN_MS);
+
+        QCOMPARE(probe.check("localhost", 0), ProbeVerdict::Reachable);
+        QCOMPARE(probe.check("LOCALHOST", TTL_MS - 1), ProbeVerdict::Reachable);
+        QCOMPARE(probe.stats().probes, 1);
+        QCOMPARE(probe.stats().cacheHits, 1);
+
+        // Past the TTL the server is probed again
+        QCOMPARE(probe.check("localhost", TTL_MS), ProbeVerdict::Reachable);
+        QCOMPARE(probe.stats().probes, 2);
+    }
+
+    void testRefusedConnectionIsUnreachable()
+    {
+        quint16 port = closedPort();
+        QVERIFY(port != 0);
+        ReachabilityProbe probe(PROBE_TIMEOUT_MS, port, TTL_MS, THRESHOLD, COOLDOWN_MS);
+
+        QCOMPARE(probe.check("localhost", 0), ProbeVerdict::Unreachable);
+        QCOMPARE(probe.failuresInRow("localhost"), 1);
+
+        // Failures are not cached, the next request probes again
+        QCOMPARE(probe.check("localhost", 1), ProbeVerdict::Unreachable);
+        QCOMPARE(probe.stats().probes, 2);
+    }
+
+    void testUnknownNameIsUnresolved()
+    {
+        ReachabilityProbe probe(PROBE_TIMEOUT_MS, ReachabilityProbe::SMB_PORT);
+        QCOMPARE(probe.check("no-such-server.invalid", 0), ProbeVerdict::Unresolved);
+    }
+
+    void testCircuitOpensAfterRepeatedFailures()
+    {
+        quint16 port = closedPort();
+        QVERIFY(port != 0);
+        ReachabilityProbe probe(PROBE_TIMEOUT_MS, port, TTL_MS, THRESHOLD, COOLDOWN_MS);
+
+        QCOMPARE(probe.check("localhost", 0), ProbeVerdict::Unreachable);
+        QCOMPARE(probe.check("localhost", 10), ProbeVerdict::Unreachable);
+        QCOMPARE(probe.check("localhost", 20), ProbeVerdict::CircuitOpen);
+        QCOMPARE(probe.check("localhost", 10 + COOLDOWN_MS - 1), ProbeVerdict::CircuitOpen);
+        QCOMPARE(probe.stats().probes, 2);
+        QCOMPARE(probe.stats().failFast, 2);
+
+        // After the cooldown one more failure opens the circuit again
+        QCOMPARE(probe.check("localhost", 10 + COOLDOWN_MS), ProbeVerdict::Unreachable);
+        QCOMPARE(probe.check("localhost", 20 + COOLDOWN_MS), ProbeVerdict::CircuitOpen);
+    }
+
+    void testSuccessClosesCircuit()
+    {
+        QTcpServer server;
+        QVERIFY(server.listen(QHostAddress::Any));
+        quint16 port = server.serverPort();
+        server.close();
+        ReachabilityProbe probe(PROBE_TIMEOUT_MS, port, TTL_MS, THRESHOLD, COOLDOWN_MS);
+
+        QCOMPARE(probe.check("localhost", 0), ProbeVerdict::Unreachable);
+        QCOMPARE(probe.check("localhost", 0), ProbeVerdict::Unreachable);
+        QCOMPARE(probe.check("localhost", 0), ProbeVerdict::CircuitOpen);
+
+        // The server comes back; the first probe after the cooldown closes the circuit
+        if (!server.listen(QHostAddress::Any, port))
+        {
+            QSKIP("Port was taken in the meantime");
+        }
+        QCOMPARE(probe.check("localhost", COOLDOWN_MS), ProbeVerdict::Reachable);
+        QCOMPARE(probe.failuresInRow("localhost"), 0);
+        QCOMPARE(probe.check("localhost", COOLDOWN_MS + 1), ProbeVerdict::Reachable);
+    }
+
+    void testOtherServersAreUnaffected()
+    {
+        quint16 port = closedPort();
+        QVERIFY(port != 0);
+        ReachabilityProbe probe(PROBE_TIMEOUT_MS, port, TTL_MS, 1, COOLDOWN_MS);
+
+        QCOMPARE(probe.check("localhost", 0), ProbeVerdict::Unreachable);
+        QCOMPARE(probe.check("localhost", 1), ProbeVerdict::CircuitOpen);
+        QCOMPARE(probe.check("127.0.0.1", 1), ProbeVerdict::Unreachable);
+    }
+
+    void testPreflightSkipsLocalTargets()
+    {
+        quint16 port = closedPort();
+        QVERIFY(port != 0);
+        ReachabilityProbe probe(PROBE_TIMEOUT_MS, port);
+
+        QVERIFY(probe.preflight("localhost", "file:///mnt/projects/a.txt").success);
+        QVERIFY(probe.preflight("localhost", "C:\\projects\\a.txt").success);
+        QCOMPARE(probe.stats().probes, 0);
+
+        OpenResult result = probe.preflight("localhost", "smb://localhost/share/a.txt");
+        QVERIFY(!result.success);
+        QCOMPARE(result.errorReason, "Server is not reachable");
+        QVERIFY(!probe.preflight("localhost", R"(\\localhost\share\a.txt)").success);
+        QCOMPARE(probe.stats().probes, 2);
+    }
+
+    void testIsNetworkTarget()
+    {
+        QVERIFY(ReachabilityProbe::isNetworkTarget("smb://server/share"));
+        QVERIFY(ReachabilityProbe::isNetworkTarget("SMB://server/share"));
+        QVERIFY(ReachabilityProbe::isNetworkTarget(R"(\\server\share)"));
+        QVERIFY(!ReachabilityProbe::isNetworkTarget("file:///mnt/share"));
+        QVERIFY(!ReachabilityProbe::isNetworkTarget("/mnt/share"));
+    }
+
+    void testPathOpenerFailsFastWithoutLaunching()
+    {
+        quint16 port = closedPort();
+        QVERIFY(port != 0);
+        Config config;
+        config.setUncAllowList({R"(\\localhost\share)"});
+        PathOpener opener(config);
+        auto probe =
+            std::make_shared<ReachabilityProbe>(PROBE_TIMEOUT_MS, port, TTL_MS, 1, COOLDOWN_MS);
+        opener.setReachabilityProbe(probe);
+
+        OpenResult first = opener.open("uncopener://localhost/share/a.txt");
+        QVERIFY(!first.success);
+        QCOMPARE(first.errorReason, "Server is not reachable");
+
+        OpenResult second = opener.open("uncopener://localhost/share/b.txt");
+        QVERIFY(!second.success);
+        QVERIFY(second.errorRemediation.contains("several times in a row"));
+        QCOMPARE(probe->stats().probes, 1);
+        QCOMPARE(probe->stats().failFast, 1);
+    }
+
+    void testAsyncOpenerProbesOnWorker()
+    {
+        quint16 port = closedPort();
+        QVERIFY(port != 0);
+        QAtomicInt calls;
+        AsyncOpener opener(
+            [&calls](const QString&)
+            {
+                calls.ref();
+                return OpenResult::ok();
+            },
+            2, 0);
+        opener.setReachabilityProbe(std::make_shared<ReachabilityProbe>(PROBE_TIMEOUT_MS, port));
+
+        QFuture<OpenResult> network = opener.openTarget("localhost", "smb://localhost/share");
+        QFuture<OpenResult> local = opener.openTarget("localhost", "file:///mnt/share");
+        QTRY_VERIFY(network.isFinished() && local.isFinished());
+        QVERIFY(!network.result().success);
+        QVERIFY(local.result().success);
+        QCOMPARE(calls.loadRelaxed(), 1);
+    }
+};
+
+int runReachabilityProbeTests(int argc, char* argv[])
+{
+    ReachabilityProbeTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "ReachabilityProbeTests.moc"
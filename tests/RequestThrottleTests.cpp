@@ -0,0 +1,218 @@
+#include "RequestThrottle.hpp"
+
+#include <QTest>
+
+using namespace uncopener;
+
+class RequestThrottleTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    const QString m_path = R"(\\server\share\file.txt)";
+    const QString m_source = "resident";
+
+private slots:
+    void testFirstRequestAccepted()
+    {
+        RequestThrottle throttle(1000, 5, 30);
+        QCOMPARE(throttle.admit(m_path, m_source, 0), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.stats().accepted, 1);
+    }
+
+    void testRepeatWithinWindowCoalesced()
+    {
+        RequestThrottle throttle(1000, 5, 30);
+        QCOMPARE(throttle.admit(m_path, m_source, 0), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.admit(m_path, m_source, 200), ThrottleVerdict::Coalesced);
+        QCOMPARE(throttle.admit(m_path, m_source, 999), ThrottleVerdict::Coalesced);
+        QCOMPARE(throttle.stats().accepted, 1);
+        QCOMPARE(throttle.stats().coalesced, 2);
+    }
+
+    void testRepeatAfterWindowAccepted()
+    {
+        RequestThrottle throttle(1000, 5, 30);
+        QCOMPARE(throttle.admit(m_path, m_source, 0), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.admit(m_path, m_source, 1000), ThrottleVerdict::Accepted);
+    }
+
+    void testCoalescingIgnoresCase()
+    {
+        RequestThrottle throttle(1000, 5, 30);
+        QCOMPARE(throttle.admit(m_path, m_source, 0), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.admit(m_path.toUpper(), m_source, 10), ThrottleVerdict::Coalesced);
+    }
+
+    void testCoalescingAcrossSources()
+    {
+        RequestThrottle throttle(1000, 5, 30);
+        QCOMPARE(throttle.admit(m_path, "resident", 0), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.admit(m_path, "dbus", 10), ThrottleVerdict::Coalesced);
+    }
+
+    void testDifferentPathsNotCoalesced()
+    {
+        RequestThrottle throttle(1000, 5, 30);
+        QCOMPARE(throttle.admit(R"(\\server\share\a)", m_source, 0), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.admit(R"(\\server\share\b)", m_source, 0), ThrottleVerdict::Accepted);
+    }
+
+    void testBurstThenRateLimited()
+    {
+        RequestThrottle throttle(0, 3, 60);
+        for (int i = 0; i < 3; ++i)
+        {
+            QCOMPARE(throttle.admit(QString::number(i), m_source, 0), ThrottleVerdict::Accepted);
+        }
+        QCOMPARE(throttle.admit("3", m_source, 0), ThrottleVerdict::RateLimited);
+        QCOMPARE(throttle.admit("4", m_source, 0), ThrottleVerdict::RateLimited);
+        QCOMPARE(throttle.stats().rateLimited, 2);
+        QCOMPARE(throttle.rateLimitedInRow(m_source), 2);
+    }
+
+    void testTokensRefill()
+    {
+        // 60 per minute: one token per second
+        RequestThrottle throttle(0, 1, 60);
+        QCOMPARE(throttle.admit("a", m_source, 0), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.admit("b", m_source, 500), ThrottleVerdict::RateLimited);
+        QCOMPARE(throttle.rateLimitedInRow(m_source), 1);
+        QCOMPARE(throttle.admit("c", m_source, 1000), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.rateLimitedInRow(m_source), 0);
+    }
+
+    void testRefillCappedAtBurst()
+    {
+        RequestThrottle throttle(0, 2, 60);
+        QCOMPARE(throttle.admit("a", m_source, 0), ThrottleVerdict::Accepted);
+
+        // A long pause refills at most the burst size
+        for (int i = 0; i < 2; ++i)
+        {
+            QCOMPARE(throttle.admit(QString::number(i), m_source, 60000),
+                     ThrottleVerdict::Accepted);
+        }
+        QCOMPARE(throttle.admit("b", m_source, 60000), ThrottleVerdict::RateLimited);
+    }
+
+    void testSourcesHaveSeparateBuckets()
+    {
+        RequestThrottle throttle(0, 1, 60);
+        QCOMPARE(throttle.admit("a", "resident", 0), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.admit("b", "resident", 0), ThrottleVerdict::RateLimited);
+        QCOMPARE(throttle.admit("c", "dbus", 0), ThrottleVerdict::Accepted);
+    }
+
+    void testCoalescedRequestsUseNoTokens()
+    {
+        RequestThrottle throttle(1000, 1, 60);
+        QCOMPARE(throttle.admit(m_path, m_source, 0), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.admit(m_path, m_source, 10), ThrottleVerdict::Coalesced);
+        QCOMPARE(throttle.rateLimitedInRow(m_source), 0);
+        QCOMPARE(throttle.stats().rateLimited, 0);
+    }
+
+    void testBatchLargerThanBurstTakesOneToken()
+    {
+        RequestThrottle throttle(1000, 5, 30);
+        QStringList paths;
+        for (int i = 0; i < 20; ++i)
+        {
+            paths.append(R"(\\server\share\)" + QString::number(i));
+        }
+
+        QList<qsizetype> admitted;
+        QCOMPARE(throttle.admitBatch(paths, m_source, 0, admitted), ThrottleVerdict::Accepted);
+        QCOMPARE(admitted.size(), 20);
+        QCOMPARE(throttle.stats().accepted, 20);
+
+        // Four tokens are left for other requests
+        for (int i = 0; i < 4; ++i)
+        {
+            QCOMPARE(throttle.admit(QString::number(i), m_source, 0), ThrottleVerdict::Accepted);
+        }
+        QCOMPARE(throttle.admitBatch({"x", "y"}, m_source, 0, admitted),
+                 ThrottleVerdict::RateLimited);
+        QVERIFY(admitted.isEmpty());
+        QCOMPARE(throttle.stats().rateLimited, 2);
+        QCOMPARE(throttle.rateLimitedInRow(m_source), 1);
+    }
+
+    void testBatchLeavesOutCoalescedPaths()
+    {
+        RequestThrottle throttle(1000, 2, 60);
+        QCOMPARE(throttle.admit("a", m_source, 0), ThrottleVerdict::Accepted);
+
+        // Only "b" is new
+        QList<qsizetype> admitted;
+        QCOMPARE(throttle.admitBatch({"A", "b"}, m_source, 100, admitted),
+                 ThrottleVerdict::Accepted);
+        QCOMPARE(admitted, QList<qsizetype>{1});
+        QCOMPARE(throttle.stats().coalesced, 1);
+
+        // A batch of repeats takes no token, although the bucket is empty now
+        QCOMPARE(throttle.admitBatch({"a", "B"}, m_source, 200, admitted),
+                 ThrottleVerdict::Coalesced);
+        QVERIFY(admitted.isEmpty());
+        QCOMPARE(throttle.rateLimitedInRow(m_source), 0);
+    }
+
+    void testReconfigureKeepsState()
+    {
+        RequestThrottle throttle(1000, 1, 60);
+        QCOMPARE(throttle.admit(m_path, m_source, 0), ThrottleVerdict::Accepted);
+
+        // A reload with other limits neither forgets the path nor refills the bucket
+        throttle.reconfigure(2000, 2, 60);
+        QCOMPARE(throttle.admit(m_path, m_source, 1500), ThrottleVerdict::Coalesced);
+        QCOMPARE(throttle.admit("a", m_source, 1500), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.admit("b", m_source, 1500), ThrottleVerdict::RateLimited);
+        QCOMPARE(throttle.stats().accepted, 2);
+    }
+
+    void testZeroDisablesStages()
+    {
+        RequestThrottle throttle(0, 0, 0);
+        for (int i = 0; i < 100; ++i)
+        {
+            QCOMPARE(throttle.admit(m_path, m_source, 0), ThrottleVerdict::Accepted);
+        }
+        QCOMPARE(throttle.stats().accepted, 100);
+    }
+
+    void testPruneKeepsRecentPaths()
+    {
+        RequestThrottle throttle(1000, 0, 0);
+        QCOMPARE(throttle.admit(m_path, m_source, 0), ThrottleVerdict::Accepted);
+        for (qsizetype i = 0; i < RequestThrottle::MAX_TRACKED_PATHS; ++i)
+        {
+            QCOMPARE(throttle.admit(QString::number(i), m_source, 2000),
+                     ThrottleVerdict::Accepted);
+        }
+
+        // The first path expired and was pruned; the later ones are still coalesced
+        QCOMPARE(throttle.admit("0", m_source, 2500), ThrottleVerdict::Coalesced);
+        QCOMPARE(throttle.admit(m_path, m_source, 2500), ThrottleVerdict::Accepted);
+    }
+
+    void testConfigSettings()
+    {
+        Config config;
+        config.setCoalesceWindowMs(0);
+        config.setRateLimitBurst(1);
+        config.setRateLimitPerMinute(1);
+
+        RequestThrottle throttle(config);
+        QCOMPARE(throttle.admit(m_path, m_source), ThrottleVerdict::Accepted);
+        QCOMPARE(throttle.admit(m_path, m_source), ThrottleVerdict::RateLimited);
+    }
+};
+
+int runRequestThrottleTests(int argc, char* argv[])
+{
+    RequestThrottleTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "RequestThrottleTests.moc"
@@ -0,0 +1,177 @@
+#include "RequestThrottle.hpp"
+#include "ResidentServer.hpp"
+
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QUuid>
+
+using namespace uncopener;
+
+class ResidentServerTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_tempDir;
+
+    /// Unique server name so tests never talk to a real resident instance
+    [[nodiscard]] QString uniqueServerName() const
+    {
+        QString id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+#ifdef Q_OS_WIN
+        return "uncopener-test-" + id;
+#else
+        return m_tempDir.path() + "/" + id + ".sock";
+#endif
+    }
+
+private slots:
+    void testDefaultServerNameNotEmpty()
+    {
+        QVERIFY(!ResidentServer::defaultServerName().isEmpty());
+    }
+
+    void testForwardWithoutServerFails()
+    {
+        QVERIFY(!ResidentServer::forward(uniqueServerName(), {"uncopener://server/share"}, 100));
+    }
+
+    void testForwardSingleUrl()
+    {
+        ResidentServer server(uniqueServerName());
+        QVERIFY(server.listen());
+        QVERIFY(server.isListening());
+
+        QSignalSpy spy(&server, &ResidentServer::urlReceived);
+        QVERIFY(
+            ResidentServer::forward(server.serverName(), {"uncopener://server/share/file.txt"}));
+
+        QVERIFY(spy.wait(2000));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toString(), "uncopener://server/share/file.txt");
+    }
+
+    void testForwardMultipleUrls()
+    {
+        ResidentServer server(uniqueServerName());
+        QVERIFY(server.listen());
+
+        QSignalSpy single(&server, &ResidentServer::urlReceived);
+        QSignalSpy batch(&server, &ResidentServer::batchReceived);
+        QVERIFY(ResidentServer::forward(server.serverName(),
+                                        {"uncopener://server/a", "uncopener://server/b path/"}));
+
+        QVERIFY(batch.wait(2000));
+        QCOMPARE(batch.at(0).at(0).toStringList(),
+                 QStringList({"uncopener://server/a", "uncopener://server/b path/"}));
+        QCOMPARE(single.count(), 0);
+    }
+
+    void testBatchLargerThanBurstArrivesWhole()
+    {
+        ResidentServer server(uniqueServerName());
+        QVERIFY(server.listen());
+
+        // More URLs than the default rate limit burst, as a portal may open them
+        QStringList urls;
+        for (int i = 0; i < Config::DEFAULT_RATE_LIMIT_BURST * 4; ++i)
+        {
+            urls.append("uncopener://server/share/" + QString::number(i));
+        }
+
+        QSignalSpy single(&server, &ResidentServer::urlReceived);
+        QSignalSpy batch(&server, &ResidentServer::batchReceived);
+        QVERIFY(ResidentServer::forward(server.serverName(), urls));
+
+        QVERIFY(batch.wait(2000));
+        QCOMPARE(batch.count(), 1);
+        QCOMPARE(batch.at(0).at(0).toStringList(), urls);
+        QCOMPARE(single.count(), 0);
+
+        // The batch goes through the throttle as one request
+        RequestThrottle throttle(Config{});
+        QList<qsizetype> admitted;
+        QCOMPARE(throttle.admitBatch(urls, "resident", admitted), ThrottleVerdict::Accepted);
+        QCOMPARE(admitted.size(), urls.size());
+    }
+
+    void testForwardUtf8Url()
+    {
+        ResidentServer server(uniqueServerName());
+        QVERIFY(server.listen());
+
+        QSignalSpy spy(&server, &ResidentServer::urlReceived);
+        QString url = QString::fromUtf8("uncopener://server/share/B\xC3\xBC" "cher");
+        QVERIFY(ResidentServer::forward(server.serverName(), {url}));
+
+        QVERIFY(spy.wait(2000));
+        QCOMPARE(spy.at(0).at(0).toString(), url);
+    }
+
+    void testForwardPrewarm()
+    {
+        ResidentServer server(uniqueServerName());
+        QVERIFY(server.listen());
+
+        QSignalSpy opened(&server, &ResidentServer::urlReceived);
+        QSignalSpy prewarmed(&server, &ResidentServer::prewarmRequested);
+        QVERIFY(ResidentServer::forwardPrewarm(server.serverName(), {"uncopener://server/a"}));
+
+        QVERIFY(prewarmed.wait(2000));
+        QCOMPARE(prewarmed.at(0).at(0).toString(), "uncopener://server/a");
+        QCOMPARE(opened.count(), 0);
+    }
+
+    void testForwardRejectsLineBreaks()
+    {
+        ResidentServer server(uniqueServerName());
+        QVERIFY(server.listen());
+
+        QVERIFY(!ResidentServer::forward(server.serverName(), {"uncopener://server/a\nopen x"}));
+    }
+
+    void testOptionsAreNotForwarded()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("The wide command line of the process is read instead of argv");
+#endif
+        QByteArray program = "uncopener";
+        QByteArray option = "--resident";
+        QByteArray url = "uncopener://server/share";
+        char* onlyProgram[] = {program.data()};
+        char* withOption[] = {program.data(), url.data(), option.data()};
+        QVERIFY(!ResidentServer::forwardArguments(1, onlyProgram));
+        QVERIFY(!ResidentServer::forwardArguments(3, withOption));
+    }
+
+    void testSecondListenerFails()
+    {
+        ResidentServer first(uniqueServerName());
+        QVERIFY(first.listen());
+
+        ResidentServer second(first.serverName());
+        QVERIFY(!second.listen());
+        QVERIFY(!second.isListening());
+    }
+
+    void testListenAfterPreviousInstanceClosed()
+    {
+        QString name = uniqueServerName();
+        {
+            ResidentServer first(name);
+            QVERIFY(first.listen());
+        }
+
+        ResidentServer second(name);
+        QVERIFY(second.listen());
+    }
+};
+
+int runResidentServerTests(int argc, char* argv[])
+{
+    ResidentServerTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "ResidentServerTests.moc"
@@ -1,6 +1,7 @@
 #include "SchemeRegistry.hpp"
 
 #include <QCoreApplication>
+#include <QStandardPaths>
 #include <QTest>
 
 using namespace uncopener;
@@ -34,6 +35,18 @@ private slots:
 #endif
     }
 
+    void testHandlerBinaryPathIsAbsolute()
+    {
+        // Falls back to the current binary if no uncopener-handler is installed next to it
+        QString path = SchemeRegistry::handlerBinaryPath();
+        QVERIFY(!path.isEmpty());
+#ifdef Q_OS_WIN
+        QVERIFY(path.length() >= 2 && path.at(1) == ':');
+#else
+        QVERIFY(path.startsWith('/'));
+#endif
+    }
+
     void testCheckRegistrationUnknownScheme()
     {
         auto registry = SchemeRegistry::create();
@@ -110,6 +123,47 @@ private slots:
         // Should be back to not registered
         QCOMPARE(registry->checkRegistration(testScheme), RegistrationStatus::NotRegistered);
     }
+
+    // The D-Bus desktop file is shared, so registering a scheme must keep the others
+    void testDBusSchemesShareDesktopFile()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("D-Bus activation is Linux only");
+#endif
+        // Keep the files of a real D-Bus registration untouched
+        QStandardPaths::setTestModeEnabled(true);
+        auto registry = SchemeRegistry::create();
+        registry->setDBusActivatable(true);
+        const QString first = "uncopener_dbus_test_first";
+        const QString second = "uncopener_dbus_test_second";
+
+        if (!registry->registerScheme(first).success || !registry->registerScheme(second).success)
+        {
+            static_cast<void>(registry->unregisterScheme(first));
+            static_cast<void>(registry->unregisterScheme(second));
+            QStandardPaths::setTestModeEnabled(false);
+            QSKIP("Cannot test registration - xdg-mime not available", SkipSingle);
+        }
+
+        bool bothRegistered =
+            registry->checkRegistration(first) == RegistrationStatus::RegisteredToThisBinary &&
+            registry->checkRegistration(second) == RegistrationStatus::RegisteredToThisBinary;
+
+        // Unregistering one scheme keeps the other
+        bool firstUnregistered = registry->unregisterScheme(first).success;
+        RegistrationStatus firstStatus = registry->checkRegistration(first);
+        RegistrationStatus secondStatus = registry->checkRegistration(second);
+        bool secondUnregistered = registry->unregisterScheme(second).success;
+        RegistrationStatus lastStatus = registry->checkRegistration(second);
+        QStandardPaths::setTestModeEnabled(false);
+
+        QVERIFY(bothRegistered);
+        QVERIFY(firstUnregistered);
+        QCOMPARE(firstStatus, RegistrationStatus::NotRegistered);
+        QCOMPARE(secondStatus, RegistrationStatus::RegisteredToThisBinary);
+        QVERIFY(secondUnregistered);
+        QCOMPARE(lastStatus, RegistrationStatus::NotRegistered);
+    }
 };
 
 int runSchemeRegistryTests(int argc, char* argv[])
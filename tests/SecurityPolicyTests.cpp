@@ -97,6 +97,74 @@ private slots:
         QCOMPARE(UncAllowList::normalizeEntry(R"(\\server\share)"), R"(\\server\share)");
     }
 
+    void testUncAllowListPlainStringPrefix()
+    {
+        UncAllowList list;
+        list.addEntry(R"(\\server\sha)");
+
+        // Entries match as plain string prefixes, not on component boundaries
+        QVERIFY(list.check(R"(\\server\share\path)").allowed);
+        QVERIFY(list.check(R"(\\server\sha)").allowed);
+        QVERIFY(!list.check(R"(\\server\sh)").allowed);
+    }
+
+    void testUncAllowListForwardSlashPath()
+    {
+        UncAllowList list;
+        list.addEntry(R"(\\server\share)");
+
+        QVERIFY(list.check("//server/share/path").allowed);
+        QVERIFY(!list.check("//server/other/path").allowed);
+    }
+
+    void testUncAllowListNonAsciiCaseInsensitive()
+    {
+        UncAllowList list;
+        list.addEntry(QString(u"\\\\server\\\u00DCbersicht"));
+
+        QVERIFY(list.check(QString(u"\\\\SERVER\\\u00FCbersicht\\datei.txt")).allowed);
+        QVERIFY(!list.check(R"(\\server\uebersicht)").allowed);
+    }
+
+    void testUncAllowListReportsLongestMatch()
+    {
+        UncAllowList list;
+        list.setEntries({R"(\\server\share)", R"(\\server\share\projects)", R"(\\other)"});
+
+        auto result = list.check(R"(\\SERVER\Share\Projects\plan.txt)");
+        QVERIFY(result.allowed);
+        QCOMPARE(result.matchedRule, R"(\\server\share\projects)");
+        QCOMPARE(list.matchIndex(uR"(\\server\share\projects\plan.txt)"), qsizetype(1));
+
+        result = list.check(R"(\\server\share\other)");
+        QVERIFY(result.allowed);
+        QCOMPARE(result.matchedRule, R"(\\server\share)");
+
+        QCOMPARE(list.matchIndex(uR"(\\unknown\share)"), CaseFoldedTrie::NO_MATCH);
+    }
+
+    void testUncAllowListAddEntryAfterSetEntries()
+    {
+        UncAllowList list;
+        list.setEntries({R"(\\server1\share)"});
+        list.addEntry(R"(\\server2\share)");
+
+        auto result = list.check(R"(\\server2\share\file.txt)");
+        QVERIFY(result.allowed);
+        QCOMPARE(result.matchedRule, R"(\\server2\share)");
+    }
+
+    void testUncAllowListClear()
+    {
+        UncAllowList list;
+        list.addEntry(R"(\\server\share)");
+        list.clear();
+        list.addEntry(R"(\\other\share)");
+
+        QVERIFY(!list.check(R"(\\server\share\file.txt)").allowed);
+        QVERIFY(list.check(R"(\\other\share\file.txt)").allowed);
+    }
+
     // Filetype Policy Tests
 
     void testFiletypePolicyWhitelistEmpty()
@@ -202,6 +270,78 @@ private slots:
         QVERIFY(!policy.check("file.txt.exe").allowed);
     }
 
+    void testFiletypePolicyDoubleExtension()
+    {
+        FiletypePolicy policy;
+        policy.setMode(FiletypeMode::Blacklist);
+        policy.setBlacklist({".exe", ".pdf.exe"});
+
+        auto result = policy.check("Invoice.PDF.exe");
+        QVERIFY(!result.allowed);
+        QCOMPARE(result.matchedRule, ".pdf.exe");
+
+        result = policy.check("setup.EXE");
+        QVERIFY(!result.allowed);
+        QCOMPARE(result.matchedRule, ".exe");
+
+        QVERIFY(policy.check("report.pdf").allowed);
+        QVERIFY(policy.check("exe").allowed);
+    }
+
+    void testFiletypePolicyWhitelistReportsMatch()
+    {
+        FiletypePolicy policy;
+        policy.setMode(FiletypeMode::Whitelist);
+        policy.setWhitelist({"txt", "tar.gz"});
+        policy.addWhitelistEntry("gz");
+
+        auto result = policy.check("backup.TAR.GZ");
+        QVERIFY(result.allowed);
+        QCOMPARE(result.matchedRule, ".tar.gz");
+
+        result = policy.check("log.gz");
+        QVERIFY(result.allowed);
+        QCOMPARE(result.matchedRule, ".gz");
+    }
+
+    void testFiletypePolicyLargeBlacklist()
+    {
+        QStringList extensions;
+        for (int i = 0; i < 5000; ++i)
+        {
+            extensions.append(QString(".ext%1").arg(i));
+        }
+
+        FiletypePolicy policy;
+        policy.setMode(FiletypeMode::Blacklist);
+        QVERIFY(policy.setBlacklist(extensions).isEmpty());
+
+        QVERIFY(!policy.check("file.EXT4999").allowed);
+        QVERIFY(!policy.check("file.ext0").allowed);
+        QVERIFY(policy.check("file.ext5000").allowed);
+        QVERIFY(policy.check("file.txt").allowed);
+    }
+
+    void testFiletypePolicyClearLists()
+    {
+        FiletypePolicy policy;
+        policy.setMode(FiletypeMode::Blacklist);
+        policy.addBlacklistEntry(".exe");
+        policy.clearBlacklist();
+        policy.addBlacklistEntry(".bat");
+
+        QVERIFY(policy.check("file.exe").allowed);
+        QVERIFY(!policy.check("file.bat").allowed);
+
+        policy.setMode(FiletypeMode::Whitelist);
+        policy.addWhitelistEntry(".txt");
+        policy.clearWhitelist();
+        policy.addWhitelistEntry(".pdf");
+
+        QVERIFY(!policy.check("file.txt").allowed);
+        QVERIFY(policy.check("file.pdf").allowed);
+    }
+
     // Combined Security Policy Tests
 
     void testSecurityPolicyBothChecks()
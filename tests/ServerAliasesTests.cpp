@@ -0,0 +1,96 @@
+#include "PathOpener.hpp"
+#include "ServerAliases.hpp"
+
+#include <QTest>
+
+using namespace uncopener;
+
+class ServerAliasesTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static ServerAliases aliases()
+    {
+        ServerAliases result;
+        static_cast<void>(result.setAliases({
+            {"fs01", "fs01.corp.example.com"},
+            {"oldfs", "fs01"},
+            {"corp.example.com", "fs02.corp.example.com"},
+        }));
+        return result;
+    }
+
+private slots:
+    void testCanonicalName()
+    {
+        ServerAliases a = aliases();
+        QCOMPARE(a.size(), 3);
+        QCOMPARE(a.canonicalName("fs01"), "fs01.corp.example.com");
+        QCOMPARE(a.canonicalName("FS01"), "fs01.corp.example.com");
+        QCOMPARE(a.canonicalName("Corp.Example.COM"), "fs02.corp.example.com");
+        QCOMPARE(a.canonicalName("other"), "other");
+    }
+
+    void testAliasesAreNotChained()
+    {
+        QCOMPARE(aliases().canonicalName("oldfs"), "fs01");
+    }
+
+    void testInvalidAliasesRejected()
+    {
+        ServerAliases a;
+        QStringList rejected = a.setAliases({
+            {"", "server"},
+            {"a/b", "server"},
+            {"short", R"(srv\share)"},
+            {" short2 ", " server "},
+            {"Server", "server"},
+        });
+        QCOMPARE(rejected.size(), 3);
+        QCOMPARE(a.size(), 1);
+        QCOMPARE(a.canonicalName("SHORT2"), "server");
+    }
+
+    void testCanonicalizeParseResult()
+    {
+        ServerAliases a = aliases();
+        UrlParser parser("uncopener");
+
+        ParseResult parsed = parser.parse("uncopener://FS01/share/a.txt");
+        a.canonicalize(parsed);
+        QVERIFY(isSuccess(parsed));
+        QCOMPARE(getPath(parsed).server, "fs01.corp.example.com");
+        QCOMPARE(getPath(parsed).path, R"(share\a.txt)");
+
+        ParseResult failed = parser.parse("uncopener://fs01/../a.txt");
+        a.canonicalize(failed);
+        QVERIFY(isError(failed));
+    }
+
+    void testPathOpenerUsesCanonicalServer()
+    {
+        Config config;
+        config.setUncAllowList({R"(\\fs01.corp.example.com\share)"});
+        config.setServerAliases({{"fs01", "fs01.corp.example.com"}});
+        PathOpener opener(config);
+
+        // One allow-list entry covers every spelling, and all spellings open the same target
+        ValidationResult alias = opener.evaluate("uncopener://FS01/share/a.txt");
+        ValidationResult canonical = opener.evaluate("uncopener://fs01.corp.example.com/share/a.txt");
+        QVERIFY(alias.allowed());
+        QCOMPARE(alias.path().server, "fs01.corp.example.com");
+        QCOMPARE(alias.targetUrl, canonical.targetUrl);
+        QCOMPARE(alias.displayPath(), R"(\\fs01.corp.example.com\share\a.txt)");
+
+        QVERIFY(!opener.evaluate("uncopener://fs02/share/a.txt").allowed());
+    }
+};
+
+int runServerAliasesTests(int argc, char* argv[])
+{
+    ServerAliasesTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "ServerAliasesTests.moc"
@@ -0,0 +1,131 @@
+#include "ShareHistory.hpp"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace uncopener;
+
+class ShareHistoryTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dir;
+
+    [[nodiscard]] QString historyPath() const { return m_dir.filePath("share-history.json"); }
+
+    static UncPath unc(const QString& server, const QString& path)
+    {
+        UncPath result;
+        result.server = server;
+        result.path = path;
+        return result;
+    }
+
+private slots:
+    void init()
+    {
+        QVERIFY(m_dir.isValid());
+        QFile::remove(historyPath());
+    }
+
+    void testShareOf()
+    {
+        QCOMPARE(ShareHistory::shareOf(unc("server", R"(share\folder\a.txt)")), "share");
+        QCOMPARE(ShareHistory::shareOf(unc("server", "share")), "share");
+        QVERIFY(ShareHistory::shareOf(unc("server", "")).isEmpty());
+    }
+
+    void testRecordCountsPerShare()
+    {
+        ShareHistory history(historyPath());
+        QVERIFY(history.record(unc("server", R"(data\a.txt)"), 100));
+        QVERIFY(history.record(unc("SERVER", R"(Data\b\c.txt)"), 200));
+        QVERIFY(history.record(unc("server", "other"), 300));
+        QVERIFY(!history.record(unc("server", ""), 400));
+
+        // The spelling of the first open is kept
+        QCOMPARE(history.entries().size(), 2);
+        QCOMPARE(history.entries().at(0).server, "server");
+        QCOMPARE(history.entries().at(0).share, "data");
+        QCOMPARE(history.entries().at(0).count, 2);
+        QCOMPARE(history.entries().at(0).lastOpenedMs, 200);
+    }
+
+    void testMostUsedOrder()
+    {
+        ShareHistory history(historyPath());
+        history.record(unc("a", "one"), 100);
+        history.record(unc("b", "two"), 200);
+        history.record(unc("c", "three"), 300);
+        history.record(unc("b", "two"), 400);
+
+        // More opens first, then the more recent open
+        QList<ShareUse> shares = history.mostUsed(3);
+        QCOMPARE(shares.size(), 3);
+        QCOMPARE(shares.at(0).server, "b");
+        QCOMPARE(shares.at(1).server, "c");
+        QCOMPARE(shares.at(2).server, "a");
+
+        QCOMPARE(history.mostUsed(1).size(), 1);
+        QVERIFY(history.mostUsed(0).isEmpty());
+        QCOMPARE(shares.at(0).path().toUncString(), R"(\\b\two)");
+    }
+
+    void testSaveLoadRoundtrip()
+    {
+        {
+            ShareHistory history(historyPath());
+            history.record(unc("server", "data"), 100);
+            history.record(unc("server", "data"), 200);
+            history.record(unc("other", "share"), 300);
+        }
+
+        ShareHistory loaded(historyPath());
+        QVERIFY(loaded.load());
+        QCOMPARE(loaded.entries().size(), 2);
+        QCOMPARE(loaded.entries().at(0).share, "data");
+        QCOMPARE(loaded.entries().at(0).count, 2);
+        QCOMPARE(loaded.entries().at(1).lastOpenedMs, 300);
+    }
+
+    void testLoadMissingOrInvalidFile()
+    {
+        ShareHistory history(historyPath());
+        QVERIFY(!history.load());
+        QVERIFY(history.entries().isEmpty());
+
+        QFile file(historyPath());
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("not json");
+        file.close();
+        QVERIFY(!history.load());
+        QVERIFY(history.entries().isEmpty());
+    }
+
+    void testPruneKeepsMostUsed()
+    {
+        ShareHistory history(historyPath());
+        history.record(unc("server", "favorite"), 0);
+        history.record(unc("server", "favorite"), 1);
+        for (qsizetype i = 0; i < ShareHistory::MAX_SHARES; ++i)
+        {
+            history.record(unc("server", QString("share%1").arg(i)), 10 + i);
+        }
+
+        // The oldest of the shares opened once is dropped, the favorite stays
+        QCOMPARE(history.entries().size(), ShareHistory::MAX_SHARES);
+        QCOMPARE(history.entries().at(0).share, "favorite");
+        QCOMPARE(history.entries().at(1).share, "share1");
+        QCOMPARE(history.mostUsed(1).at(0).share, "favorite");
+    }
+};
+
+int runShareHistoryTests(int argc, char* argv[])
+{
+    ShareHistoryTest test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "ShareHistoryTests.moc"
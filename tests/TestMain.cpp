@@ -19,6 +19,11 @@ int main(int argc, char* argv[])
         status |= runUrlContractTests(argc, argv);
     }
 
+    {
+        extern int runCaseFoldedTrieTests(int argc, char* argv[]);
+        status |= runCaseFoldedTrieTests(argc, argv);
+    }
+
     {
         extern int runSecurityPolicyTests(int argc, char* argv[]);
         status |= runSecurityPolicyTests(argc, argv);
@@ -29,16 +34,113 @@ int main(int argc, char* argv[])
         status |= runConfigTests(argc, argv);
     }
 
+    {
+        extern int runConfigCacheTests(int argc, char* argv[]);
+        status |= runConfigCacheTests(argc, argv);
+    }
+
+    {
+        extern int runConfigWatcherTests(int argc, char* argv[]);
+        status |= runConfigWatcherTests(argc, argv);
+    }
+
     {
         extern int runPathOpenerTests(int argc, char* argv[]);
         status |= runPathOpenerTests(argc, argv);
     }
 
+    {
+        extern int runPathTranslatorTests(int argc, char* argv[]);
+        status |= runPathTranslatorTests(argc, argv);
+    }
+
+    {
+        extern int runServerAliasesTests(int argc, char* argv[]);
+        status |= runServerAliasesTests(argc, argv);
+    }
+
+    {
+        extern int runBatchOpenerTests(int argc, char* argv[]);
+        status |= runBatchOpenerTests(argc, argv);
+    }
+
+    {
+        extern int runAsyncOpenerTests(int argc, char* argv[]);
+        status |= runAsyncOpenerTests(argc, argv);
+    }
+
+    {
+        extern int runReachabilityProbeTests(int argc, char* argv[]);
+        status |= runReachabilityProbeTests(argc, argv);
+    }
+
+    {
+        extern int runOpenerBackendTests(int argc, char* argv[]);
+        status |= runOpenerBackendTests(argc, argv);
+    }
+
+    {
+        extern int runMountIndexTests(int argc, char* argv[]);
+        status |= runMountIndexTests(argc, argv);
+    }
+
+    {
+        extern int runShareHistoryTests(int argc, char* argv[]);
+        status |= runShareHistoryTests(argc, argv);
+    }
+
+    {
+        extern int runMountPrewarmerTests(int argc, char* argv[]);
+        status |= runMountPrewarmerTests(argc, argv);
+    }
+
+    {
+        extern int runDecisionCacheTests(int argc, char* argv[]);
+        status |= runDecisionCacheTests(argc, argv);
+    }
+
+    {
+        extern int runDecisionFilterTests(int argc, char* argv[]);
+        status |= runDecisionFilterTests(argc, argv);
+    }
+
+    {
+        extern int runNativeMessagingHostTests(int argc, char* argv[]);
+        status |= runNativeMessagingHostTests(argc, argv);
+    }
+
+    {
+        extern int runPolicyReplayTests(int argc, char* argv[]);
+        status |= runPolicyReplayTests(argc, argv);
+    }
+
+    {
+        extern int runPolicyStoreTests(int argc, char* argv[]);
+        status |= runPolicyStoreTests(argc, argv);
+    }
+
+    {
+        extern int runRequestThrottleTests(int argc, char* argv[]);
+        status |= runRequestThrottleTests(argc, argv);
+    }
+
     {
         extern int runSchemeRegistryTests(int argc, char* argv[]);
         status |= runSchemeRegistryTests(argc, argv);
     }
 
+    {
+        extern int runResidentServerTests(int argc, char* argv[]);
+        status |= runResidentServerTests(argc, argv);
+    }
+
+#ifdef UNCOPENER_HAS_DBUS
+    {
+        extern int runDBusApplicationServiceTests(int argc, char* argv[]);
+        status |= runDBusApplicationServiceTests(argc, argv);
+    }
+#endif
+
     // Resource tests
     {
         extern int runResourceTests(int argc, char* argv[]);
@@ -2,8 +2,11 @@
 
 #include <QString>
 #include <QTest>
+#include <QUrl>
 #include <QVector>
 
+#include <utility>
+
 using namespace uncopener;
 
 // Test vectors based on docs/url-contract.md
@@ -227,6 +230,101 @@ private slots:
             QVERIFY(isSuccess(result));
             QCOMPARE(getPath(result).path, R"(share\path with spaces)");
         }
+
+        // Percent-encoded UTF-8 and literal non-ASCII characters
+        {
+            ParseResult result =
+                parser.parse(QString(u"uncopener://server/B%C3%BCcher/\u00C4rger"));
+            QVERIFY(isSuccess(result));
+            QCOMPARE(getPath(result).path, QString(u"B\u00FCcher\\\u00C4rger"));
+        }
+
+        // Percent-encoded server name
+        {
+            ParseResult result = parser.parse("uncopener://file%2Dserver/share");
+            QVERIFY(isSuccess(result));
+            QCOMPARE(getPath(result).server, "file-server");
+        }
+
+        // Incomplete escapes decode like QUrl::fromPercentEncoding
+        const QStringList incompleteEscapes = {"uncopener://server/share/100%",
+                                               "uncopener://server/share/100%2",
+                                               "uncopener://server/share/a%zzb"};
+        for (const QString& url : incompleteEscapes)
+        {
+            ParseResult result = parser.parse(url);
+            QVERIFY(isSuccess(result));
+            QString rawPath = url.mid(QString("uncopener://server/").size()).replace('/', '\\');
+            QCOMPARE(getPath(result).path, QUrl::fromPercentEncoding(rawPath.toUtf8()));
+        }
+    }
+
+    void testEncodedTraversalRejected()
+    {
+        UrlParser parser("uncopener");
+
+        // Dot segments and separators hidden in escapes are checked after decoding
+        const QList<std::pair<QString, ParseError::Code>> cases = {
+            {"uncopener://server/share/%2E%2E/%2E%2E/etc/passwd",
+             ParseError::Code::DirectoryTraversal},
+            {"uncopener://server/share/%2e%2E", ParseError::Code::DirectoryTraversal},
+            {"uncopener://server/share/.%2E/x", ParseError::Code::DirectoryTraversal},
+            {"uncopener://server/share/%2E/x", ParseError::Code::DirectoryTraversal},
+            {"uncopener://server/share/a%2F..%2F..%2Fx", ParseError::Code::DirectoryTraversal},
+            {"uncopener://server/share/a%5C..%5Cx", ParseError::Code::DirectoryTraversal},
+            {"uncopener://server/share/a%2Fb", ParseError::Code::InvalidCharacter},
+            {"uncopener://server/share/a%5Cb", ParseError::Code::InvalidCharacter},
+            {"uncopener://server%2Fother/share", ParseError::Code::InvalidCharacter},
+            {"uncopener://server%5Cother/share", ParseError::Code::InvalidCharacter},
+        };
+        for (const auto& [url, code] : cases)
+        {
+            ParseResult result = parser.parse(url);
+            QVERIFY2(isError(result), qPrintable(url));
+            QCOMPARE(getError(result).code, code);
+        }
+
+        // Dots within a name stay allowed
+        ParseResult result = parser.parse("uncopener://server/share/%2E%2Ex/a%2E%2Eb");
+        QVERIFY(isSuccess(result));
+        QCOMPARE(getPath(result).path, R"(share\..x\a..b)");
+    }
+
+    void testBackslashSeparators()
+    {
+        UrlParser parser("uncopener");
+
+        ParseResult result = parser.parse(R"(uncopener://server/share\path\\file.txt)");
+        QVERIFY(isSuccess(result));
+        QCOMPARE(getPath(result).toUncString(), R"(\\server\share\path\file.txt)");
+
+        result = parser.parse(R"(uncopener://server/share\..\other)");
+        QVERIFY(isError(result));
+        QCOMPARE(getError(result).code, ParseError::Code::DirectoryTraversal);
+    }
+
+    void testScanSpans()
+    {
+        UrlParser parser("uncopener");
+        QString input = "uncopener://server/share/./a%20b//c/?query";
+
+        UrlSpans spans;
+        QVERIFY(!parser.scan(input, spans).has_value());
+        QCOMPARE(spans.authority.toString(), "server");
+        QCOMPARE(spans.segments.size(), qsizetype(3));
+        QCOMPARE(spans.segments.at(0).toString(), "share");
+        QCOMPARE(spans.segments.at(1).toString(), "a%20b");
+        QCOMPARE(spans.segments.at(2).toString(), "c");
+        QVERIFY(spans.hasTrailingSlash);
+        QVERIFY(!spans.authorityEncoded);
+        QVERIFY(spans.pathEncoded);
+
+        // Views point into the input
+        QVERIFY(spans.authority.constData() == input.constData() + 12);
+
+        QVERIFY(parser.scan(u"uncopener://server/share/../x", spans) ==
+                ParseError::Code::DirectoryTraversal);
+        QVERIFY(parser.scan(u"uncopener:/server", spans) == ParseError::Code::InvalidSchemeFormat);
     }
 
     void testSlashCollapsing()